@@ -0,0 +1,111 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/benchmark/benchmark_executor.hpp"
+#include <exception>
+#include <optional>
+#include <stdexcept>
+
+namespace bark {
+namespace benchmark {
+
+namespace {
+
+struct NumericVisitor : boost::static_visitor<std::optional<double>> {
+  std::optional<double> operator()(double value) const { return value; }
+  std::optional<double> operator()(bool value) const {
+    return value ? 1.0 : 0.0;
+  }
+  std::optional<double> operator()(const std::optional<bool>& value) const {
+    if (!value) return std::nullopt;
+    return *value ? 1.0 : 0.0;
+  }
+  std::optional<double> operator()(const std::string& value) const {
+    return std::nullopt;
+  }
+  std::optional<double> operator()(int value) const { return value; }
+};
+
+}  // namespace
+
+bool TerminalCondition::IsSatisfied(const EvaluationReturn& value) const {
+  const std::optional<double> number =
+      boost::apply_visitor(NumericVisitor(), value);
+  if (!number) return false;
+  switch (op) {
+    case IS_TRUE:
+      return *number != 0.0;
+    case GREATER:
+      return *number > threshold;
+    case GREATER_EQUAL:
+      return *number >= threshold;
+    case LESS:
+      return *number < threshold;
+    case LESS_EQUAL:
+      return *number <= threshold;
+    case EQUAL:
+      return *number == threshold;
+  }
+  return false;
+}
+
+std::vector<std::string> BenchmarkExecutor::TerminalReasons(
+    const EvaluationMap& evaluation) const {
+  std::vector<std::string> reasons;
+  for (const auto& condition : terminal_conditions_) {
+    const auto value = evaluation.find(condition.first);
+    if (value == evaluation.end())
+      throw std::runtime_error("No evaluator for terminal condition " +
+                               condition.first);
+    if (condition.second.IsSatisfied(value->second))
+      reasons.push_back(condition.first);
+  }
+  return reasons;
+}
+
+EpisodeResult BenchmarkExecutor::Run(const WorldPtr& world,
+                                     const AgentId& eval_agent_id,
+                                     const BehaviorModelPtr& behavior,
+                                     const EvaluatorMap& evaluators) const {
+  EpisodeResult result;
+  result.steps = 0;
+  try {
+    if (behavior) {
+      const auto agent = world->GetAgent(eval_agent_id);
+      if (!agent)
+        throw std::runtime_error("Evaluated agent " +
+                                 std::to_string(eval_agent_id) +
+                                 " does not exist");
+      agent->SetBehaviorModel(behavior);
+    }
+    world->ClearEvaluators();
+    for (const auto& evaluator : evaluators) {
+      world->AddEvaluator(evaluator.first, evaluator.second);
+    }
+
+    while (true) {
+      result.evaluation = world->Evaluate();
+      result.terminal_reasons = TerminalReasons(result.evaluation);
+      if (!result.terminal_reasons.empty()) break;
+      if (result.steps >= max_steps_) {
+        result.terminal_reasons.push_back("step_limit");
+        break;
+      }
+      world->PlanAgents(step_time_);
+      world->Execute(step_time_);
+      ++result.steps;
+    }
+  } catch (const std::exception& e) {
+    result.exception_message = e.what();
+    result.terminal_reasons = {"exception_raised"};
+  }
+  return result;
+}
+
+}  // namespace benchmark
+}  // namespace bark
@@ -0,0 +1,114 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_BENCHMARK_BENCHMARK_EXECUTOR_HPP_
+#define BARK_BENCHMARK_BENCHMARK_EXECUTOR_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bark/models/behavior/behavior_model.hpp"
+#include "bark/world/evaluation/base_evaluator.hpp"
+#include "bark/world/world.hpp"
+
+namespace bark {
+namespace benchmark {
+
+using models::behavior::BehaviorModelPtr;
+using world::EvaluationMap;
+using world::WorldPtr;
+using world::evaluation::EvaluationReturn;
+using world::evaluation::EvaluatorPtr;
+using world::objects::AgentId;
+
+enum TerminalOperator : unsigned int {
+  IS_TRUE = 0,
+  GREATER = 1,
+  GREATER_EQUAL = 2,
+  LESS = 3,
+  LESS_EQUAL = 4,
+  EQUAL = 5
+};
+
+/**
+ * @brief Native counterpart of the terminal_when lambdas of the Python
+ * BenchmarkRunner, e.g. {GREATER, 2} for lambda x: x > 2
+ */
+struct TerminalCondition {
+  TerminalCondition(TerminalOperator op = IS_TRUE, double threshold = 0.0)
+      : op(op), threshold(threshold) {}
+
+  //! bool and int results are compared as numbers, strings never terminate
+  bool IsSatisfied(const EvaluationReturn& value) const;
+
+  TerminalOperator op;
+  double threshold;
+};
+
+typedef std::map<std::string, TerminalCondition> TerminalConditions;
+typedef std::map<std::string, EvaluatorPtr> EvaluatorMap;
+
+//! compact record of a benchmark episode
+struct EpisodeResult {
+  int steps;
+  //! satisfied terminal conditions or "exception_raised" / "step_limit"
+  std::vector<std::string> terminal_reasons;
+  //! evaluation of the terminal step
+  EvaluationMap evaluation;
+  std::string exception_message;
+
+  bool ExceptionRaised() const { return !exception_message.empty(); }
+};
+
+/**
+ * @brief Runs benchmark episodes until a terminal condition is satisfied
+ *
+ * Mirrors BenchmarkRunner._run_benchmark_config: the world is evaluated
+ * before every step and stepped while no terminal condition holds. Exceptions
+ * thrown while evaluating, planning or executing end the episode and are
+ * reported in the result.
+ */
+class BenchmarkExecutor {
+ public:
+  BenchmarkExecutor(const TerminalConditions& terminal_conditions,
+                    double step_time, int max_steps = 10000)
+      : terminal_conditions_(terminal_conditions),
+        step_time_(step_time),
+        max_steps_(max_steps) {}
+
+  /**
+   * @brief Runs an episode, the world is stepped in place
+   * @param world world of the scenario
+   * @param eval_agent_id agent that is evaluated
+   * @param behavior behavior under test, keeps the scenario behavior if null
+   * @param evaluators replace the evaluators of the world
+   */
+  EpisodeResult Run(const WorldPtr& world, const AgentId& eval_agent_id,
+                    const BehaviorModelPtr& behavior,
+                    const EvaluatorMap& evaluators) const;
+
+  const TerminalConditions& GetTerminalConditions() const {
+    return terminal_conditions_;
+  }
+  double GetStepTime() const { return step_time_; }
+  int GetMaxSteps() const { return max_steps_; }
+
+ private:
+  std::vector<std::string> TerminalReasons(
+      const EvaluationMap& evaluation) const;
+
+  TerminalConditions terminal_conditions_;
+  double step_time_;
+  int max_steps_;
+};
+
+}  // namespace benchmark
+}  // namespace bark
+
+#endif  // BARK_BENCHMARK_BENCHMARK_EXECUTOR_HPP_
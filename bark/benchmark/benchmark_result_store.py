@@ -0,0 +1,120 @@
+# Copyright (c) 2020 fortiss GmbH
+#
+# Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+# Tobias Kessler
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+import os
+import glob
+import json
+import math
+import numpy as np
+import pandas as pd
+
+from bark.core.benchmark import Column, ColumnType, ResultStoreReader, ResultStoreWriter
+from bark.benchmark.benchmark_result import BenchmarkResult
+
+
+def _is_missing(value):
+    return value is None or (isinstance(value, float) and math.isnan(value))
+
+def _column_type(value):
+    if isinstance(value, (bool, np.bool_)):
+        return ColumnType.BOOL
+    if isinstance(value, (int, np.integer)):
+        return ColumnType.INT
+    if isinstance(value, (float, np.floating)):
+        return ColumnType.DOUBLE
+    return ColumnType.STRING
+
+def _to_string(value):
+    if isinstance(value, str):
+        return value
+    # e.g. the list of terminal reasons, stored as JSON to be parseable
+    return json.dumps(value, default=str)
+
+def _to_column(name, values):
+    valid = [not _is_missing(value) for value in values]
+    types = {_column_type(value) for value, is_valid in zip(values, valid) if is_valid}
+    column_type = ColumnType.STRING if ColumnType.STRING in types else \
+                    max(types, key=int, default=ColumnType.BOOL)
+    if column_type == ColumnType.STRING:
+        return Column(name, column_type, valid,
+                      strings=[_to_string(value) if is_valid else "" for value, is_valid in zip(values, valid)])
+    if column_type == ColumnType.DOUBLE:
+        return Column(name, column_type, valid,
+                      doubles=[float(value) if is_valid else 0.0 for value, is_valid in zip(values, valid)])
+    return Column(name, column_type, valid,
+                  ints=[int(value) if is_valid else 0 for value, is_valid in zip(values, valid)])
+
+def _to_series(column):
+    valid = column.valid
+    if column.type == ColumnType.DOUBLE:
+        values = column.doubles
+        values[~valid] = np.nan
+        return pd.Series(values, name=column.name)
+    if column.type == ColumnType.STRING:
+        values = np.array(column.strings, dtype=object)
+    elif column.type == ColumnType.BOOL:
+        values = column.ints.astype(bool)
+    else:
+        values = column.ints
+    if not valid.all():
+        values = values.astype(object)
+        values[~valid] = None
+    return pd.Series(values, name=column.name)
+
+
+class BenchmarkResultStore:
+    """Append-only columnar storage of benchmark results
+
+    Every call to append writes one chunk with a typed column per key of
+    the result dicts, so checkpointing only costs the new results. Loading
+    reads only the requested columns. Benchmark configs and histories are
+    not part of the store.
+
+    Values that are neither numbers nor strings, e.g. the list of terminal
+    reasons in the "Terminal" column, are stored as JSON text and loaded as
+    strings, use json.loads to restore them.
+    """
+    def __init__(self, filename):
+        self._filename = filename
+
+    @property
+    def filename(self):
+        return self._filename
+
+    def append(self, result_dicts):
+        if len(result_dicts) == 0:
+            return
+        names = list(dict.fromkeys(name for dct in result_dicts for name in dct))
+        columns = [_to_column(name, [dct.get(name) for dct in result_dicts]) for name in names]
+        ResultStoreWriter(self._filename).AppendChunk(columns)
+
+    def column_names(self):
+        return ResultStoreReader(self._filename).column_names
+
+    def num_rows(self):
+        return ResultStoreReader(self._filename).num_rows
+
+    def load_data_frame(self, columns=None):
+        reader = ResultStoreReader(self._filename)
+        columns = columns or reader.column_names
+        return pd.DataFrame({name: _to_series(reader.ReadColumn(name)) for name in columns \
+                                if reader.HasColumn(name)}, columns=columns)
+
+    def load(self, columns=None):
+        return BenchmarkResult(data_frame=self.load_data_frame(columns),
+                               file_name=self._filename)
+
+    @staticmethod
+    def load_directory(directory, columns=None):
+        """Concatenates all stores in the directory without rewriting them"""
+        filenames = sorted(glob.glob(os.path.join(directory, "**/*.columns"), recursive=True))
+        data_frames = [BenchmarkResultStore(filename).load_data_frame(columns) \
+                          for filename in filenames]
+        if len(data_frames) == 0:
+            return BenchmarkResult()
+        return BenchmarkResult(data_frame=pd.concat(data_frames, ignore_index=True))
@@ -21,7 +21,9 @@ logging.getLogger().setLevel(logging.INFO)
 from bark.runtime.commons.parameters import ParameterServer
 from bark.runtime.scenario.scenario import Scenario
 from bark.benchmark.benchmark_result import BenchmarkResult, BenchmarkConfig, BehaviorConfig
+from bark.benchmark.benchmark_result_store import BenchmarkResultStore
 from bark.core.world.evaluation import *
+from bark.core.benchmark import BenchmarkExecutor, TerminalCondition
 
 try:
   from bark.core.world.evaluation.ltl import *
@@ -46,7 +48,7 @@ class BenchmarkRunner:
 
         self.benchmark_database = benchmark_database
         self.evaluators = evaluators or {}
-        self.terminal_when = terminal_when or []
+        self.terminal_when = terminal_when or {}
         if behaviors:
           self.behavior_configs = BehaviorConfig.configs_from_dict(behaviors)
         else:
@@ -63,6 +65,7 @@ class BenchmarkRunner:
         self.checkpoint_dir = checkpoint_dir or "checkpoints"
         if not os.path.exists(self.checkpoint_dir):
             os.makedirs(self.checkpoint_dir)
+        self._merge_existing = merge_existing
 
         if merge_existing:
             self.existing_benchmark_result = \
@@ -79,8 +82,12 @@ class BenchmarkRunner:
     def get_checkpoint_file_name(self):
       return "benchmark_runner.ckpnt"
 
+    def get_columnar_checkpoint_file_name(self):
+      return os.path.splitext(self.get_checkpoint_file_name())[0] + ".columns"
+
     def clear_checkpoint_dir(self):
-      files = glob.glob(os.path.join(self.checkpoint_dir, "*.ckpnt"))
+      files = glob.glob(os.path.join(self.checkpoint_dir, "*.ckpnt")) + \
+                glob.glob(os.path.join(self.checkpoint_dir, "*.columns"))
       for f in files:
           os.remove(f)
     @staticmethod
@@ -143,9 +150,15 @@ class BenchmarkRunner:
                     benchmark_configs.append(benchmark_config)
         return benchmark_configs
 
-    def run(self, viewer=None, maintain_history=False, checkpoint_every=None):
+    def run(self, viewer=None, maintain_history=False, checkpoint_every=None,
+            checkpoint_columnar=False):
+        """Runs the configs, checkpoint_columnar appends only the new results of
+        each checkpoint to a BenchmarkResultStore instead of dumping all
+        results, configs and histories"""
+        self._check_checkpoint_columnar(checkpoint_columnar)
         results = []
         histories = {}
+        num_checkpointed = 0
         for idx, bmark_conf in enumerate(self.configs_to_run):
             self.logger.info("Running config idx {} being {}/{}: Scenario {} of set \"{}\" for behavior \"{}\"".format(
                 bmark_conf.config_idx, idx, len(self.benchmark_configs) - 1, bmark_conf.scenario_idx,
@@ -159,6 +172,10 @@ class BenchmarkRunner:
                 self._log_eval_average(results, self.configs_to_run)
 
             if checkpoint_every and (idx+1) % checkpoint_every == 0:
+                if checkpoint_columnar:
+                    self._append_columnar_checkpoint(results[num_checkpointed:])
+                    num_checkpointed = len(results)
+                    continue
                 intermediate_result = BenchmarkResult(results, \
                          self.configs_to_run[0:idx+1], histories=histories)
                 checkpoint_file = os.path.join(self.checkpoint_dir, self.get_checkpoint_file_name())
@@ -168,6 +185,22 @@ class BenchmarkRunner:
         self.existing_benchmark_result.extend(benchmark_result)
         return self.existing_benchmark_result
 
+    def _check_checkpoint_columnar(self, checkpoint_columnar):
+        # merge_existing only reads the .ckpnt dumps, configs checkpointed in
+        # a result store would be run again and stored twice
+        if checkpoint_columnar and self._merge_existing:
+            raise ValueError("checkpoint_columnar cannot be combined with merge_existing, " \
+                             "load the columnar checkpoints with load_columnar_checkpoints")
+
+    def _append_columnar_checkpoint(self, new_results):
+        checkpoint_file = os.path.join(self.checkpoint_dir, self.get_columnar_checkpoint_file_name())
+        BenchmarkResultStore(checkpoint_file).append(new_results)
+        self.logger.info("Appended {} results to checkpoint {}".format(len(new_results), checkpoint_file))
+
+    @staticmethod
+    def load_columnar_checkpoints(checkpoint_dir, columns=None):
+        return BenchmarkResultStore.load_directory(checkpoint_dir, columns)
+
     def run_benchmark_config(self, config_idx, **kwargs):
         for idx, bmark_conf in enumerate(self.benchmark_configs):
             if bmark_conf.config_idx == config_idx:
@@ -193,15 +226,20 @@ class BenchmarkRunner:
                     "step": step,
                     "Terminal": "exception_raised"}
 
+        step_time = parameter_server["Simulation"]["StepTime", "", 0.2]
+        if not isinstance(step_time, float):
+            step_time = 0.2
+        # without viewer and history the episode is run natively
+        if viewer is None and not maintain_history and self._has_native_terminal_conditions():
+            return self._run_benchmark_config_native(benchmark_config, world, behavior,
+                                                     scenario._eval_agent_ids, step_time)
+
         # if behavior is not None (None specifies that also the default model can be evalauted)
         if behavior:
             world.agents[scenario._eval_agent_ids[0]].behavior_model = behavior
         if maintain_history:
             self._append_to_scenario_history(scenario_history, world, scenario)
         self._reset_evaluators(world, scenario._eval_agent_ids)
-        step_time = parameter_server["Simulation"]["StepTime", "", 0.2]
-        if not isinstance(step_time, float):
-            step_time = 0.2
         terminal = False
         terminal_why = None
         while not terminal:
@@ -251,6 +289,33 @@ class BenchmarkRunner:
 
         return dct, scenario_history
 
+    def _has_native_terminal_conditions(self):
+        return len(self.terminal_when) > 0 and all(isinstance(condition, TerminalCondition) \
+                    for condition in self.terminal_when.values())
+
+    def _run_benchmark_config_native(self, benchmark_config, world, behavior, eval_agent_ids, step_time):
+        executor = BenchmarkExecutor(self.terminal_when, step_time)
+        try:
+            evaluators = self._create_evaluators(eval_agent_ids)
+        except Exception as e:
+            self.logger.error("For config-idx {}, Exception thrown in evaluator creation: {}".format(
+                benchmark_config.config_idx, e))
+            self._append_exception(benchmark_config, e)
+            return {**benchmark_config.as_dict(), "step": 0, "Terminal": "exception_raised"}, []
+        result = executor.Run(world, eval_agent_ids[0], behavior, evaluators)
+        if result.ExceptionRaised():
+            self.logger.error("For config-idx {}, Exception thrown in episode: {}".format(
+                benchmark_config.config_idx, result.exception_message))
+            self._append_exception(benchmark_config, RuntimeError(result.exception_message))
+            terminal_why = "exception_raised"
+        else:
+            terminal_why = list(result.terminal_reasons)
+        dct = {**benchmark_config.as_dict(),
+               "step": result.steps,
+               **result.evaluation,
+               "Terminal": terminal_why}
+        return dct, []
+
     def _append_to_scenario_history(self, scenario_history, world, scenario):
         scenario = Scenario(agent_list=list(world.agents.values()),
                             map_file_name=scenario.map_file_name,
@@ -262,6 +327,11 @@ class BenchmarkRunner:
         self.exceptions_caught.append((benchmark_config.config_idx, exception))
 
     def _reset_evaluators(self, world, eval_agent_ids):
+        for evaluator_name, evaluator_bark in self._create_evaluators(eval_agent_ids).items():
+            world.AddEvaluator(evaluator_name, evaluator_bark)
+
+    def _create_evaluators(self, eval_agent_ids):
+        evaluators = {}
         for evaluator_name, evaluator_params in self.evaluators.items():
             evaluator_bark = None
             if isinstance(evaluator_params, str):
@@ -274,7 +344,8 @@ class BenchmarkRunner:
                     "{}(agent_id=eval_agent_ids[0], **evaluator_params['params'])".format(evaluator_params["type"]))
             else:
                 raise ValueError
-            world.AddEvaluator(evaluator_name, evaluator_bark)
+            evaluators[evaluator_name] = evaluator_bark
+        return evaluators
 
     def _evaluation_criteria(self):
         bark_evals = [eval_crit for eval_crit, _ in self.evaluators.items()]
@@ -0,0 +1,187 @@
+# Copyright (c) 2020 fortiss GmbH
+#
+# Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+# Tobias Kessler
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+import os
+import copy
+import queue
+import traceback
+import multiprocessing
+
+from bark.benchmark.benchmark_result import BenchmarkResult
+from bark.benchmark.benchmark_runner import BenchmarkRunner
+
+# implement a parallelized version of benchmark running based on forked
+# processes on a single machine, no cluster services are required
+
+
+class BenchmarkRunnerLocal(BenchmarkRunner):
+    """Runs the benchmark configs in forked worker processes
+
+    The maps of all scenarios are loaded once before forking, so the worker
+    processes share the map interfaces and the scenario database
+    copy-on-write with the parent. Workers pull the next chunk of configs
+    from a shared counter, so slow scenarios do not leave other workers
+    idle, and stream every result back as soon as it is available.
+    """
+    def __init__(self,
+                 benchmark_database=None,
+                 evaluators=None,
+                 terminal_when=None,
+                 behaviors=None,
+                 behavior_configs=None,
+                 num_scenarios=None,
+                 benchmark_configs=None,
+                 logger_name=None,
+                 log_eval_avg_every=None,
+                 checkpoint_dir=None,
+                 merge_existing=False,
+                 deepcopy=True,
+                 num_workers=None,
+                 chunk_size=1):
+        super().__init__(benchmark_database=benchmark_database,
+                         evaluators=evaluators,
+                         terminal_when=terminal_when,
+                         behaviors=behaviors,
+                         behavior_configs=behavior_configs,
+                         num_scenarios=num_scenarios,
+                         benchmark_configs=benchmark_configs,
+                         logger_name=logger_name or "BenchmarkRunnerLocal",
+                         log_eval_avg_every=log_eval_avg_every,
+                         checkpoint_dir=checkpoint_dir,
+                         merge_existing=merge_existing,
+                         deepcopy=deepcopy)
+        self.num_workers = num_workers or os.cpu_count()
+        self.chunk_size = max(1, chunk_size)
+
+    def run(self, viewer=None, maintain_history=False, checkpoint_every=None,
+            checkpoint_columnar=False):
+        self._check_checkpoint_columnar(checkpoint_columnar)
+        if viewer:
+            self.logger.warning("Viewer is not supported by worker processes, ignoring it.")
+        self._share_map_interfaces()
+
+        # fork shares the loaded maps and configs, spawn would copy them
+        context = multiprocessing.get_context("fork")
+        next_config = context.Value("i", 0)
+        result_queue = context.Queue()
+        num_workers = max(1, min(self.num_workers, len(self.configs_to_run)))
+        workers = [context.Process(target=self._run_worker,
+                                   args=(worker_id, next_config, result_queue, maintain_history),
+                                   daemon=True) for worker_id in range(num_workers)]
+        for worker in workers:
+            worker.start()
+
+        results = {}
+        histories = {}
+        not_checkpointed = []
+        finished_workers = set()
+        while len(finished_workers) < num_workers:
+            try:
+                message = result_queue.get(timeout=1.0)
+            except queue.Empty:
+                for worker_id, worker in enumerate(workers):
+                    # workers exiting normally always report that they are done
+                    if worker_id not in finished_workers and \
+                          worker.exitcode is not None and worker.exitcode != 0:
+                        self.logger.error("Worker {} died with exit code {}".format(
+                            worker_id, worker.exitcode))
+                        finished_workers.add(worker_id)
+                continue
+            worker_id, config_pos, result_dict, scenario_history, exceptions = message
+            if config_pos is None:
+                finished_workers.add(worker_id)
+                continue
+            results[config_pos] = result_dict
+            histories[self.configs_to_run[config_pos].config_idx] = scenario_history
+            not_checkpointed.append(config_pos)
+            self.exceptions_caught.extend(exceptions)
+            if self._on_result(results, histories, not_checkpointed, maintain_history,
+                               checkpoint_every, checkpoint_columnar):
+                not_checkpointed = []
+        for worker in workers:
+            worker.join()
+
+        missing = [self.configs_to_run[pos].config_idx for pos in range(len(self.configs_to_run))
+                   if pos not in results]
+        if missing:
+            self.logger.error("No results for config indices {}".format(missing))
+        positions = sorted(results.keys())
+        benchmark_result = BenchmarkResult([results[pos] for pos in positions],
+                                           [self.configs_to_run[pos] for pos in positions],
+                                           histories=histories)
+        self.existing_benchmark_result.extend(benchmark_result)
+        return self.existing_benchmark_result
+
+    def _share_map_interfaces(self):
+        map_interfaces = {}
+        for benchmark_config in self.configs_to_run:
+            scenario = benchmark_config.scenario
+            if scenario.map_interface is not None:
+                continue
+            map_file_name = scenario.full_map_file_name
+            if map_file_name not in map_interfaces:
+                try:
+                    scenario.CreateMapInterface(map_file_name)
+                except Exception as e:
+                    # reported by the worker that runs the scenario
+                    self.logger.error("Could not load map {}: {}".format(map_file_name, e))
+                    continue
+                map_interfaces[map_file_name] = scenario.map_interface
+            scenario.map_interface = map_interfaces[map_file_name]
+
+    def _run_worker(self, worker_id, next_config, result_queue, maintain_history):
+        try:
+            while True:
+                with next_config.get_lock():
+                    start = next_config.value
+                    next_config.value += self.chunk_size
+                if start >= len(self.configs_to_run):
+                    break
+                for config_pos in range(start, min(start + self.chunk_size, len(self.configs_to_run))):
+                    bmark_conf = self.configs_to_run[config_pos]
+                    self.logger.info("Worker {} running config idx {}: Scenario {} of set \"{}\" for behavior \"{}\"".format(
+                        worker_id, bmark_conf.config_idx, bmark_conf.scenario_idx,
+                        bmark_conf.scenario_set_name, bmark_conf.behavior_config.behavior_name))
+                    map_interface = bmark_conf.scenario.map_interface
+                    if self._deepcopy:
+                        # pickling drops the map interface of the scenario
+                        bmark_conf = copy.deepcopy(bmark_conf)
+                        bmark_conf.scenario.map_interface = map_interface
+                    num_exceptions = len(self.exceptions_caught)
+                    result_dict, scenario_history = self._run_benchmark_config(
+                        bmark_conf, maintain_history=maintain_history)
+                    exceptions = [(config_idx, RuntimeError(repr(e))) for config_idx, e \
+                                    in self.exceptions_caught[num_exceptions:]]
+                    result_queue.put((worker_id, config_pos, result_dict, scenario_history, exceptions))
+        except Exception:
+            self.logger.error("Worker {} failed: {}".format(worker_id, traceback.format_exc()))
+        finally:
+            result_queue.put((worker_id, None, None, None, None))
+            result_queue.close()
+            result_queue.join_thread()
+
+    def _on_result(self, results, histories, not_checkpointed, maintain_history,
+                   checkpoint_every, checkpoint_columnar):
+        """Returns if a checkpoint has been written"""
+        num_results = len(results)
+        positions = sorted(results.keys())
+        if self.log_eval_avg_every and num_results % self.log_eval_avg_every == 0:
+            self._log_eval_average([results[pos] for pos in positions],
+                                   [self.configs_to_run[pos] for pos in positions])
+        if not checkpoint_every or num_results % checkpoint_every != 0:
+            return False
+        if checkpoint_columnar:
+            self._append_columnar_checkpoint([results[pos] for pos in not_checkpointed])
+        else:
+            intermediate_result = BenchmarkResult([results[pos] for pos in positions],
+                                                  [self.configs_to_run[pos] for pos in positions],
+                                                  histories=histories)
+            checkpoint_file = os.path.join(self.checkpoint_dir, self.get_checkpoint_file_name())
+            intermediate_result.dump(checkpoint_file, dump_configs=True, dump_histories=maintain_history)
+            self.logger.info("Saved checkpoint {}".format(checkpoint_file))
+        return True
@@ -0,0 +1,322 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/benchmark/result_store.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "glog/logging.h"
+
+namespace bark {
+namespace benchmark {
+
+namespace {
+
+// file: magic, version, chunks
+// chunk: chunk magic, chunk bytes, num rows, num columns, columns
+// column: name, type, value bytes, valid flags, values
+const char kMagic[8] = {'B', 'A', 'R', 'K', 'R', 'S', 'L', 'T'};
+const uint32_t kChunkMagic = 0x4B4E4843;  // "CHNK"
+const std::size_t kFileHeaderSize = sizeof(kMagic) + sizeof(uint32_t);
+
+template <typename T>
+void Write(std::string* buffer, const T& value) {
+  buffer->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void WriteVector(std::string* buffer, const std::vector<T>& values) {
+  buffer->append(reinterpret_cast<const char*>(values.data()),
+                 values.size() * sizeof(T));
+}
+
+template <typename T>
+T Read(const std::string& buffer, std::size_t* pos) {
+  if (*pos + sizeof(T) > buffer.size())
+    throw std::runtime_error("Result store column is truncated");
+  T value;
+  std::memcpy(&value, buffer.data() + *pos, sizeof(T));
+  *pos += sizeof(T);
+  return value;
+}
+
+std::string ColumnValues(const Column& column) {
+  std::string values;
+  WriteVector(&values, column.valid);
+  switch (column.type) {
+    case BOOL: {
+      if (column.ints.size() != column.Size()) break;
+      for (const int64_t value : column.ints) {
+        Write(&values, static_cast<uint8_t>(value != 0));
+      }
+      return values;
+    }
+    case INT:
+      if (column.ints.size() != column.Size()) break;
+      WriteVector(&values, column.ints);
+      return values;
+    case DOUBLE:
+      if (column.doubles.size() != column.Size()) break;
+      WriteVector(&values, column.doubles);
+      return values;
+    case STRING:
+      if (column.strings.size() != column.Size()) break;
+      for (const auto& value : column.strings) {
+        Write(&values, static_cast<uint32_t>(value.size()));
+        values.append(value);
+      }
+      return values;
+  }
+  throw std::runtime_error("Values of column " + column.name +
+                           " do not match its type");
+}
+
+bool ReadFileHeader(std::ifstream* file) {
+  char magic[sizeof(kMagic)];
+  uint32_t version;
+  file->read(magic, sizeof(magic));
+  file->read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!*file || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+    throw std::runtime_error("Not a BARK result store");
+  if (version != kResultStoreVersion)
+    throw std::runtime_error("Unsupported result store version " +
+                             std::to_string(version));
+  return true;
+}
+
+// end of the last chunk that was written completely
+uint64_t EndOfCompleteChunks(std::ifstream* file, uint64_t file_size) {
+  uint64_t pos = kFileHeaderSize;
+  while (pos < file_size) {
+    uint32_t magic = 0;
+    uint64_t chunk_bytes = 0;
+    file->seekg(pos);
+    file->read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file->read(reinterpret_cast<char*>(&chunk_bytes), sizeof(chunk_bytes));
+    const uint64_t body_pos = pos + sizeof(magic) + sizeof(chunk_bytes);
+    if (!*file || magic != kChunkMagic || body_pos + chunk_bytes > file_size)
+      break;
+    pos = body_pos + chunk_bytes;
+  }
+  return pos;
+}
+
+void TruncateFile(const std::string& filename, uint64_t size) {
+  if (truncate(filename.c_str(), size) != 0)
+    throw std::runtime_error("Cannot truncate " + filename);
+}
+
+}  // namespace
+
+ResultStoreWriter::ResultStoreWriter(const std::string& filename)
+    : filename_(filename), file_size_(kFileHeaderSize) {
+  std::ifstream existing(filename, std::ios::binary | std::ios::ate);
+  if (existing && existing.tellg() > 0) {
+    const uint64_t file_size = existing.tellg();
+    existing.seekg(0);
+    ReadFileHeader(&existing);
+    // chunks appended after a torn chunk would never be read
+    file_size_ = EndOfCompleteChunks(&existing, file_size);
+    existing.close();
+    if (file_size_ < file_size) {
+      LOG(WARNING) << "Dropping incomplete chunk at byte " << file_size_
+                   << " of " << filename;
+      TruncateFile(filename, file_size_);
+    }
+    return;
+  }
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("Cannot create result store " + filename);
+  file.write(kMagic, sizeof(kMagic));
+  file.write(reinterpret_cast<const char*>(&kResultStoreVersion),
+             sizeof(kResultStoreVersion));
+}
+
+void ResultStoreWriter::AppendChunk(const std::vector<Column>& columns) {
+  if (columns.empty()) return;
+  const uint64_t num_rows = columns.front().Size();
+  std::set<std::string> names;
+  std::string body;
+  Write(&body, num_rows);
+  Write(&body, static_cast<uint32_t>(columns.size()));
+  for (const auto& column : columns) {
+    if (column.Size() != num_rows)
+      throw std::runtime_error("Column " + column.name +
+                               " has a different number of rows");
+    if (!names.insert(column.name).second)
+      throw std::runtime_error("Duplicate column " + column.name);
+    const std::string values = ColumnValues(column);
+    Write(&body, static_cast<uint32_t>(column.name.size()));
+    body.append(column.name);
+    Write(&body, static_cast<uint8_t>(column.type));
+    Write(&body, static_cast<uint64_t>(values.size()));
+    body.append(values);
+  }
+
+  std::string chunk;
+  Write(&chunk, kChunkMagic);
+  Write(&chunk, static_cast<uint64_t>(body.size()));
+  chunk.append(body);
+  std::ofstream file(filename_, std::ios::binary | std::ios::app);
+  file.write(chunk.data(), chunk.size());
+  file.flush();
+  if (!file) {
+    // do not leave a partial chunk in front of the next one
+    file.close();
+    TruncateFile(filename_, file_size_);
+    throw std::runtime_error("Cannot append to " + filename_);
+  }
+  file_size_ += chunk.size();
+}
+
+ResultStoreReader::ResultStoreReader(const std::string& filename)
+    : filename_(filename), num_rows_(0) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file) throw std::runtime_error("Cannot open result store " + filename);
+  const uint64_t file_size = file.tellg();
+  file.seekg(0);
+  ReadFileHeader(&file);
+
+  uint64_t pos = kFileHeaderSize;
+  std::set<std::string> known_columns;
+  while (pos < file_size) {
+    uint32_t magic = 0;
+    uint64_t chunk_bytes = 0;
+    file.seekg(pos);
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&chunk_bytes), sizeof(chunk_bytes));
+    const uint64_t body_pos = pos + sizeof(magic) + sizeof(chunk_bytes);
+    if (!file || magic != kChunkMagic || body_pos + chunk_bytes > file_size) {
+      LOG(WARNING) << "Ignoring incomplete chunk at byte " << pos << " of "
+                   << filename;
+      break;
+    }
+
+    Chunk chunk;
+    uint32_t num_columns = 0;
+    file.read(reinterpret_cast<char*>(&chunk.num_rows), sizeof(uint64_t));
+    file.read(reinterpret_cast<char*>(&num_columns), sizeof(num_columns));
+    for (uint32_t i = 0; i < num_columns && file; ++i) {
+      uint32_t name_size = 0;
+      file.read(reinterpret_cast<char*>(&name_size), sizeof(name_size));
+      if (name_size > chunk_bytes)
+        throw std::runtime_error("Corrupt result store " + filename);
+      std::string name(name_size, '\0');
+      file.read(&name[0], name_size);
+      ColumnEntry entry;
+      uint8_t type = 0;
+      file.read(reinterpret_cast<char*>(&type), sizeof(type));
+      file.read(reinterpret_cast<char*>(&entry.num_bytes), sizeof(uint64_t));
+      if (type > STRING || entry.num_bytes > chunk_bytes)
+        throw std::runtime_error("Corrupt result store " + filename);
+      entry.type = static_cast<ColumnType>(type);
+      entry.offset = file.tellg();
+      file.seekg(entry.num_bytes, std::ios::cur);
+      if (known_columns.insert(name).second) column_names_.push_back(name);
+      chunk.columns[name] = entry;
+    }
+    if (!file) throw std::runtime_error("Corrupt result store " + filename);
+    num_rows_ += chunk.num_rows;
+    chunks_.push_back(chunk);
+    pos = body_pos + chunk_bytes;
+  }
+}
+
+std::vector<std::string> ResultStoreReader::GetColumnNames() const {
+  return column_names_;
+}
+
+bool ResultStoreReader::HasColumn(const std::string& name) const {
+  return std::find(column_names_.begin(), column_names_.end(), name) !=
+         column_names_.end();
+}
+
+Column ResultStoreReader::ReadColumn(const std::string& name) const {
+  if (!HasColumn(name))
+    throw std::runtime_error("No column " + name + " in " + filename_);
+
+  Column column;
+  column.name = name;
+  column.type = BOOL;
+  bool has_numbers = false;
+  for (const auto& chunk : chunks_) {
+    const auto entry = chunk.columns.find(name);
+    if (entry == chunk.columns.end()) continue;
+    column.type = std::max(column.type, entry->second.type);
+    has_numbers = has_numbers || entry->second.type != STRING;
+  }
+  if (column.type == STRING && has_numbers)
+    throw std::runtime_error("Column " + name + " mixes strings and numbers");
+
+  column.valid.reserve(num_rows_);
+  std::ifstream file(filename_, std::ios::binary);
+  std::string buffer;
+  for (const auto& chunk : chunks_) {
+    const auto entry = chunk.columns.find(name);
+    if (entry == chunk.columns.end()) {
+      column.valid.insert(column.valid.end(), chunk.num_rows, 0);
+      column.ints.insert(column.ints.end(),
+                         column.type <= INT ? chunk.num_rows : 0, 0);
+      column.doubles.insert(column.doubles.end(),
+                            column.type == DOUBLE ? chunk.num_rows : 0, 0.0);
+      column.strings.insert(column.strings.end(),
+                            column.type == STRING ? chunk.num_rows : 0, "");
+      continue;
+    }
+
+    buffer.resize(entry->second.num_bytes);
+    file.seekg(entry->second.offset);
+    file.read(&buffer[0], buffer.size());
+    if (!file) throw std::runtime_error("Cannot read column " + name);
+    std::size_t pos = 0;
+    for (uint64_t row = 0; row < chunk.num_rows; ++row) {
+      column.valid.push_back(Read<uint8_t>(buffer, &pos));
+    }
+    for (uint64_t row = 0; row < chunk.num_rows; ++row) {
+      switch (entry->second.type) {
+        case BOOL: {
+          const int64_t value = Read<uint8_t>(buffer, &pos);
+          if (column.type == DOUBLE)
+            column.doubles.push_back(value);
+          else
+            column.ints.push_back(value);
+          break;
+        }
+        case INT: {
+          const int64_t value = Read<int64_t>(buffer, &pos);
+          if (column.type == DOUBLE)
+            column.doubles.push_back(value);
+          else
+            column.ints.push_back(value);
+          break;
+        }
+        case DOUBLE:
+          column.doubles.push_back(Read<double>(buffer, &pos));
+          break;
+        case STRING: {
+          const uint32_t size = Read<uint32_t>(buffer, &pos);
+          if (pos + size > buffer.size())
+            throw std::runtime_error("Result store column is truncated");
+          column.strings.push_back(buffer.substr(pos, size));
+          pos += size;
+          break;
+        }
+      }
+    }
+  }
+  return column;
+}
+
+}  // namespace benchmark
+}  // namespace bark
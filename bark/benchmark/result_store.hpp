@@ -0,0 +1,114 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_BENCHMARK_RESULT_STORE_HPP_
+#define BARK_BENCHMARK_RESULT_STORE_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bark {
+namespace benchmark {
+
+//! incremented whenever the file layout changes
+const uint32_t kResultStoreVersion = 1;
+
+//! ordered by promotion, BOOL and INT columns are promoted to DOUBLE
+enum ColumnType : uint8_t { BOOL = 0, INT = 1, DOUBLE = 2, STRING = 3 };
+
+/**
+ * @brief Typed column of benchmark results
+ *
+ * BOOL and INT values are stored in ints. Rows without a value, e.g. of
+ * evaluators that were not evaluated in an episode, are marked invalid.
+ */
+struct Column {
+  std::string name;
+  ColumnType type;
+  std::vector<uint8_t> valid;
+  std::vector<int64_t> ints;
+  std::vector<double> doubles;
+  std::vector<std::string> strings;
+
+  std::size_t Size() const { return valid.size(); }
+};
+
+/**
+ * @brief Appends chunks of result columns to a result store file
+ *
+ * Every chunk is written with a single write, so a checkpoint only costs
+ * the size of the new results. A chunk that was only partly written, e.g.
+ * by an interrupted run, is ignored by the reader and removed when the
+ * file is opened for appending again.
+ */
+class ResultStoreWriter {
+ public:
+  //! creates the file if it does not exist, truncates an incomplete chunk
+  explicit ResultStoreWriter(const std::string& filename);
+
+  //! all columns need the same number of rows and distinct names
+  void AppendChunk(const std::vector<Column>& columns);
+
+  const std::string& GetFilename() const { return filename_; }
+
+ private:
+  std::string filename_;
+  // end of the last complete chunk
+  uint64_t file_size_;
+};
+
+/**
+ * @brief Reads result store files with lazy column projection
+ *
+ * Opening the file only reads the chunk and column headers, the values of
+ * a column are read on request.
+ */
+class ResultStoreReader {
+ public:
+  explicit ResultStoreReader(const std::string& filename);
+
+  std::size_t GetNumRows() const { return num_rows_; }
+  std::size_t GetNumChunks() const { return chunks_.size(); }
+
+  //! in order of their first appearance
+  std::vector<std::string> GetColumnNames() const;
+
+  bool HasColumn(const std::string& name) const;
+
+  /**
+   * @brief Concatenates the column over all chunks
+   *
+   * Rows of chunks without the column are invalid. Throws a
+   * std::runtime_error for unknown columns and columns mixing strings with
+   * numbers.
+   */
+  Column ReadColumn(const std::string& name) const;
+
+ private:
+  struct ColumnEntry {
+    ColumnType type;
+    uint64_t offset;
+    uint64_t num_bytes;
+  };
+  struct Chunk {
+    uint64_t num_rows;
+    std::map<std::string, ColumnEntry> columns;
+  };
+
+  std::string filename_;
+  std::vector<Chunk> chunks_;
+  std::vector<std::string> column_names_;
+  std::size_t num_rows_;
+};
+
+}  // namespace benchmark
+}  // namespace bark
+
+#endif  // BARK_BENCHMARK_RESULT_STORE_HPP_
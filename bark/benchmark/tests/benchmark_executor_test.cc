@@ -0,0 +1,114 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <chrono>
+#include <iostream>
+
+#include "gtest/gtest.h"
+
+#include "bark/benchmark/benchmark_executor.hpp"
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
+#include "bark/world/evaluation/evaluator_collision_ego_agent.hpp"
+#include "bark/world/evaluation/evaluator_goal_reached.hpp"
+#include "bark/world/evaluation/evaluator_step_count.hpp"
+#include "bark/world/tests/make_test_world.hpp"
+
+using bark::benchmark::BenchmarkExecutor;
+using bark::benchmark::EpisodeResult;
+using bark::benchmark::EvaluatorMap;
+using bark::benchmark::TerminalCondition;
+using bark::benchmark::TerminalConditions;
+using bark::benchmark::TerminalOperator;
+using bark::commons::SetterParams;
+using bark::models::behavior::BehaviorConstantAcceleration;
+using bark::world::WorldPtr;
+using bark::world::evaluation::EvaluatorCollisionEgoAgent;
+using bark::world::evaluation::EvaluatorGoalReached;
+using bark::world::evaluation::EvaluatorStepCount;
+
+WorldPtr MakeTestWorld() {
+  return bark::world::tests::make_test_world(1, 20.0, 5.0, 0.0);
+}
+
+EvaluatorMap MakeEvaluators() {
+  return {{"collision", std::make_shared<EvaluatorCollisionEgoAgent>(1)},
+          {"success", std::make_shared<EvaluatorGoalReached>(1)},
+          {"max_steps", std::make_shared<EvaluatorStepCount>()}};
+}
+
+TEST(benchmark_executor, terminal_condition) {
+  TerminalCondition is_true(TerminalOperator::IS_TRUE);
+  EXPECT_TRUE(is_true.IsSatisfied(true));
+  EXPECT_FALSE(is_true.IsSatisfied(false));
+  EXPECT_FALSE(is_true.IsSatisfied(std::optional<bool>()));
+  EXPECT_FALSE(is_true.IsSatisfied(std::string("true")));
+
+  TerminalCondition greater(TerminalOperator::GREATER, 2);
+  EXPECT_FALSE(greater.IsSatisfied(2));
+  EXPECT_TRUE(greater.IsSatisfied(3));
+  EXPECT_TRUE(greater.IsSatisfied(2.5));
+  EXPECT_TRUE(TerminalCondition(TerminalOperator::LESS_EQUAL, 1.0)
+                  .IsSatisfied(1));
+}
+
+TEST(benchmark_executor, run_episode) {
+  const TerminalConditions terminal_conditions = {
+      {"collision", TerminalCondition(TerminalOperator::IS_TRUE)},
+      {"max_steps", TerminalCondition(TerminalOperator::GREATER, 2)}};
+  BenchmarkExecutor executor(terminal_conditions, 0.2);
+
+  WorldPtr world = MakeTestWorld();
+  auto behavior = std::make_shared<BehaviorConstantAcceleration>(
+      std::make_shared<SetterParams>());
+  const EpisodeResult result = executor.Run(world, 1, behavior,
+                                            MakeEvaluators());
+  EXPECT_FALSE(result.ExceptionRaised());
+  EXPECT_EQ(result.steps, 2);
+  EXPECT_EQ(result.terminal_reasons, std::vector<std::string>({"max_steps"}));
+  EXPECT_EQ(boost::get<int>(result.evaluation.at("max_steps")), 3);
+  EXPECT_FALSE(boost::get<bool>(result.evaluation.at("collision")));
+  EXPECT_EQ(world->GetAgent(1)->GetBehaviorModel(), behavior);
+  EXPECT_NEAR(world->GetWorldTime(), 0.4, 1e-6);
+}
+
+TEST(benchmark_executor, step_limit_and_exceptions) {
+  BenchmarkExecutor limited(
+      {{"collision", TerminalCondition(TerminalOperator::IS_TRUE)}}, 0.2, 3);
+  EpisodeResult result =
+      limited.Run(MakeTestWorld(), 1, nullptr, MakeEvaluators());
+  EXPECT_EQ(result.steps, 3);
+  EXPECT_EQ(result.terminal_reasons, std::vector<std::string>({"step_limit"}));
+
+  // terminal condition without evaluator
+  BenchmarkExecutor invalid(
+      {{"unknown", TerminalCondition(TerminalOperator::IS_TRUE)}}, 0.2);
+  result = invalid.Run(MakeTestWorld(), 1, nullptr, MakeEvaluators());
+  EXPECT_TRUE(result.ExceptionRaised());
+  EXPECT_EQ(result.terminal_reasons,
+            std::vector<std::string>({"exception_raised"}));
+}
+
+TEST(benchmark_executor, benchmark) {
+  const TerminalConditions terminal_conditions = {
+      {"collision", TerminalCondition(TerminalOperator::IS_TRUE)},
+      {"max_steps", TerminalCondition(TerminalOperator::GREATER, 20)}};
+  BenchmarkExecutor executor(terminal_conditions, 0.2);
+  const int num_episodes = 20;
+  int num_steps = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_episodes; ++i) {
+    num_steps += executor.Run(MakeTestWorld(), 1, nullptr,
+                              MakeEvaluators()).steps;
+  }
+  const double duration = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  std::cout << num_episodes << " episodes, " << num_steps / duration
+            << " steps/s" << std::endl;
+  EXPECT_EQ(num_steps, num_episodes * 20);
+}
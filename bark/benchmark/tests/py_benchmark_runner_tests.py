@@ -7,6 +7,7 @@
 # https://opensource.org/licenses/MIT
 
 import unittest
+import json
 import os
 import time
 import ray
@@ -21,6 +22,8 @@ from serialization.database_serializer import DatabaseSerializer
 from bark.benchmark.benchmark_runner import BenchmarkRunner, BenchmarkConfig
 from bark.benchmark.benchmark_runner_mp import BenchmarkRunnerMP, _BenchmarkRunnerActor, \
   deserialize_benchmark_config, serialize_benchmark_config
+from bark.benchmark.benchmark_runner_local import BenchmarkRunnerLocal
+from bark.benchmark.benchmark_result_store import BenchmarkResultStore
 
 from bark.runtime.viewer.matplotlib_viewer import MPViewer
 
@@ -28,6 +31,7 @@ from bark.core.world.evaluation import *
 from bark.core.world.evaluation.ltl import ConstantLabelFunction
 from bark.runtime.commons.parameters import ParameterServer
 from bark.core.models.behavior import BehaviorIDMClassic, BehaviorConstantAcceleration
+from bark.core.benchmark import TerminalCondition, TerminalOperator
 
 try: # bazel run
   os.chdir("../benchmark_database/")
@@ -63,6 +67,66 @@ class DatabaseRunnerTests(unittest.TestCase):
         groups = result.get_evaluation_groups()
         self.assertEqual(set(groups), set(["behavior", "scen_set"]))
 
+    def test_database_runner_native(self):
+        dbs = DatabaseSerializer(test_scenarios=4, test_world_steps=5, num_serialize_scenarios=2)
+        dbs.process("data/database1")
+        local_release_filename = dbs.release(version="test")
+
+        db = BenchmarkDatabase(database_root=local_release_filename)
+        evaluators = {"success" : "EvaluatorGoalReached", "collision" : "EvaluatorCollisionEgoAgent",
+                      "max_steps": "EvaluatorStepCount"}
+        terminal_when = {"collision" : TerminalCondition(TerminalOperator.IS_TRUE),
+                         "max_steps": TerminalCondition(TerminalOperator.GREATER, 2)}
+        params = ParameterServer() # only for evaluated agents not passed to scenario!
+        behaviors_tested = {"IDM": BehaviorIDMClassic(params), "Const" : BehaviorConstantAcceleration(params)}
+
+        benchmark_runner = BenchmarkRunner(benchmark_database=db,
+                                           evaluators=evaluators,
+                                           terminal_when=terminal_when,
+                                           behaviors=behaviors_tested)
+        df_native = benchmark_runner.run().get_data_frame()
+
+        # history requires the Python loop, terminal conditions are callable
+        benchmark_runner = BenchmarkRunner(benchmark_database=db,
+                                           evaluators=evaluators,
+                                           terminal_when=terminal_when,
+                                           behaviors=behaviors_tested)
+        df_python = benchmark_runner.run(maintain_history=True).get_data_frame()
+
+        self.assertEqual(len(df_native.index), 2*2*2)
+        self.assertEqual(list(df_native["step"]), list(df_python["step"]))
+        self.assertEqual(list(df_native["collision"]), list(df_python["collision"]))
+        self.assertEqual(list(df_native["Terminal"]), list(df_python["Terminal"]))
+
+    def test_database_local_runner(self):
+        dbs = DatabaseSerializer(test_scenarios=4, test_world_steps=5, num_serialize_scenarios=5)
+        dbs.process("data/database1")
+        local_release_filename = dbs.release(version="test")
+
+        db = BenchmarkDatabase(database_root=local_release_filename)
+        evaluators = {"success" : "EvaluatorGoalReached", "collision" : "EvaluatorCollisionEgoAgent",
+                      "max_steps": "EvaluatorStepCount"}
+        terminal_when = {"collision" :lambda x: x, "max_steps": lambda x : x>2}
+        params = ParameterServer() # only for evaluated agents not passed to scenario!
+        behaviors_tested = {"IDM": BehaviorIDMClassic(params), "Const" : BehaviorConstantAcceleration(params)}
+
+        benchmark_runner = BenchmarkRunnerLocal(benchmark_database=db,
+                                                evaluators=evaluators,
+                                                terminal_when=terminal_when,
+                                                behaviors=behaviors_tested,
+                                                log_eval_avg_every=10,
+                                                num_workers=4)
+        df = benchmark_runner.run(maintain_history=True).get_data_frame()
+        self.assertEqual(len(df.index), 20) # 2 Behaviors * 5 Serialize Scenarios * 2 scenario sets
+
+        benchmark_runner = BenchmarkRunner(benchmark_database=db,
+                                           evaluators=evaluators,
+                                           terminal_when=terminal_when,
+                                           behaviors=behaviors_tested)
+        df_sequential = benchmark_runner.run().get_data_frame()
+        self.assertEqual(list(df["config_idx"]), list(df_sequential["config_idx"]))
+        self.assertEqual(list(df["step"]), list(df_sequential["step"]))
+
     def test_database_runner_checkpoint(self):
         dbs = DatabaseSerializer(test_scenarios=4, test_world_steps=5, num_serialize_scenarios=10)
         dbs.process("data/database1")
@@ -119,6 +183,67 @@ class DatabaseRunnerTests(unittest.TestCase):
         df = merged_result.get_data_frame()
         self.assertEqual(len(df.index), 37)
 
+    def test_database_runner_columnar_checkpoint(self):
+        dbs = DatabaseSerializer(test_scenarios=4, test_world_steps=5, num_serialize_scenarios=10)
+        dbs.process("data/database1")
+        local_release_filename = dbs.release(version="test")
+
+        db = BenchmarkDatabase(database_root=local_release_filename)
+        evaluators = {"success" : "EvaluatorGoalReached", "collision" : "EvaluatorCollisionEgoAgent",
+                      "max_steps": "EvaluatorStepCount"}
+        terminal_when = {"collision" :lambda x: x, "max_steps": lambda x : x>2}
+        params = ParameterServer() # only for evaluated agents not passed to scenario!
+        behaviors_tested = {"IDM": BehaviorIDMClassic(params), "Const" : BehaviorConstantAcceleration(params)}
+
+        benchmark_runner = BenchmarkRunner(benchmark_database=db,
+                                           evaluators=evaluators,
+                                           terminal_when=terminal_when,
+                                           behaviors=behaviors_tested,
+                                           checkpoint_dir="checkpoints3/")
+        benchmark_runner.clear_checkpoint_dir()
+        df = benchmark_runner.run(checkpoint_every=7, checkpoint_columnar=True).get_data_frame()
+        self.assertEqual(len(df.index), 40) # 2 Behaviors * 10 Serialize Scenarios * 2 scenario sets
+
+        # 5 chunks of 7 results each, the remaining 5 results are not checkpointed
+        store = BenchmarkResultStore(os.path.join("checkpoints3/", \
+                      benchmark_runner.get_columnar_checkpoint_file_name()))
+        self.assertEqual(store.num_rows(), 35)
+        self.assertTrue("collision" in store.column_names())
+        df_store = BenchmarkRunner.load_columnar_checkpoints("checkpoints3/",
+                        columns=["config_idx", "step", "collision"]).get_data_frame()
+        self.assertEqual(list(df_store.columns), ["config_idx", "step", "collision"])
+        self.assertEqual(list(df_store["config_idx"]), list(df["config_idx"])[0:35])
+        self.assertEqual(list(df_store["step"]), list(df["step"])[0:35])
+        self.assertEqual(list(df_store["collision"]), list(df["collision"])[0:35])
+
+        benchmark_runner = BenchmarkRunnerLocal(benchmark_database=db,
+                                                evaluators=evaluators,
+                                                terminal_when=terminal_when,
+                                                behaviors=behaviors_tested,
+                                                checkpoint_dir="checkpoints3/",
+                                                num_workers=2)
+        benchmark_runner.clear_checkpoint_dir()
+        benchmark_runner.run(checkpoint_every=10, checkpoint_columnar=True)
+        df_store = BenchmarkRunner.load_columnar_checkpoints("checkpoints3/").get_data_frame()
+        self.assertEqual(sorted(df_store["config_idx"]), sorted(df["config_idx"]))
+
+        # non-scalar results such as the terminal reasons are stored as JSON
+        terminal = {config_idx: terminal for config_idx, terminal in zip(df["config_idx"], df["Terminal"])}
+        for config_idx, terminal_json in zip(df_store["config_idx"], df_store["Terminal"]):
+            expected = terminal[config_idx]
+            self.assertEqual(terminal_json if isinstance(expected, str) else json.loads(terminal_json),
+                             expected)
+
+        # merging only reads the .ckpnt dumps, columnar checkpoints are rejected
+        benchmark_runner = BenchmarkRunner(benchmark_database=db,
+                                           evaluators=evaluators,
+                                           terminal_when=terminal_when,
+                                           behaviors=behaviors_tested,
+                                           checkpoint_dir="checkpoints3/",
+                                           merge_existing=True)
+        with self.assertRaises(ValueError):
+            benchmark_runner.run(checkpoint_every=7, checkpoint_columnar=True)
+
     def test_database_multiprocessing_runner(self):
         dbs = DatabaseSerializer(test_scenarios=4, test_world_steps=5, num_serialize_scenarios=5)
         dbs.process("data/database1")
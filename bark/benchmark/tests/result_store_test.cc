@@ -0,0 +1,171 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "gtest/gtest.h"
+
+#include "bark/benchmark/result_store.hpp"
+
+using bark::benchmark::Column;
+using bark::benchmark::ColumnType;
+using bark::benchmark::ResultStoreReader;
+using bark::benchmark::ResultStoreWriter;
+
+Column MakeColumn(const std::string& name, ColumnType type,
+                  std::size_t num_rows, int offset = 0) {
+  Column column;
+  column.name = name;
+  column.type = type;
+  for (std::size_t i = 0; i < num_rows; ++i) {
+    const int value = offset + static_cast<int>(i);
+    column.valid.push_back(value % 7 != 3);
+    if (type == ColumnType::BOOL) column.ints.push_back(value % 2);
+    if (type == ColumnType::INT) column.ints.push_back(value);
+    if (type == ColumnType::DOUBLE) column.doubles.push_back(0.5 * value);
+    if (type == ColumnType::STRING)
+      column.strings.push_back("value" + std::to_string(value));
+  }
+  return column;
+}
+
+std::string TempFile(const std::string& name) {
+  const std::string filename = ::testing::TempDir() + name;
+  std::remove(filename.c_str());
+  return filename;
+}
+
+TEST(result_store, append_and_project) {
+  const std::string filename = TempFile("result_store_append.columns");
+  {
+    ResultStoreWriter writer(filename);
+    writer.AppendChunk({MakeColumn("config_idx", ColumnType::INT, 3),
+                        MakeColumn("collision", ColumnType::BOOL, 3),
+                        MakeColumn("behavior", ColumnType::STRING, 3)});
+  }
+  // reopening appends, the new chunk adds a column and promotes another
+  ResultStoreWriter writer(filename);
+  writer.AppendChunk({MakeColumn("config_idx", ColumnType::INT, 2, 3),
+                      MakeColumn("collision", ColumnType::DOUBLE, 2, 3),
+                      MakeColumn("velocity", ColumnType::DOUBLE, 2, 3)});
+
+  ResultStoreReader reader(filename);
+  EXPECT_EQ(reader.GetNumRows(), 5);
+  EXPECT_EQ(reader.GetNumChunks(), 2);
+  EXPECT_EQ(reader.GetColumnNames(),
+            std::vector<std::string>(
+                {"config_idx", "collision", "behavior", "velocity"}));
+
+  const Column config_idx = reader.ReadColumn("config_idx");
+  EXPECT_EQ(config_idx.type, ColumnType::INT);
+  EXPECT_EQ(config_idx.ints, std::vector<int64_t>({0, 1, 2, 3, 4}));
+  EXPECT_EQ(config_idx.valid, std::vector<uint8_t>({1, 1, 1, 0, 1}));
+
+  const Column collision = reader.ReadColumn("collision");
+  EXPECT_EQ(collision.type, ColumnType::DOUBLE);
+  EXPECT_EQ(collision.doubles,
+            std::vector<double>({0.0, 1.0, 0.0, 1.5, 2.0}));
+
+  const Column behavior = reader.ReadColumn("behavior");
+  EXPECT_EQ(behavior.type, ColumnType::STRING);
+  EXPECT_EQ(behavior.strings[1], "value1");
+  EXPECT_EQ(behavior.valid, std::vector<uint8_t>({1, 1, 1, 0, 0}));
+
+  const Column velocity = reader.ReadColumn("velocity");
+  EXPECT_EQ(velocity.valid, std::vector<uint8_t>({0, 0, 0, 0, 1}));
+  EXPECT_DOUBLE_EQ(velocity.doubles[4], 2.0);
+
+  EXPECT_THROW(reader.ReadColumn("unknown"), std::runtime_error);
+}
+
+TEST(result_store, invalid_input) {
+  const std::string filename = TempFile("result_store_invalid.columns");
+  ResultStoreWriter writer(filename);
+  EXPECT_THROW(writer.AppendChunk({MakeColumn("a", ColumnType::INT, 3),
+                                   MakeColumn("b", ColumnType::INT, 2)}),
+               std::runtime_error);
+  Column mismatch = MakeColumn("a", ColumnType::INT, 3);
+  mismatch.type = ColumnType::DOUBLE;
+  EXPECT_THROW(writer.AppendChunk({mismatch}), std::runtime_error);
+
+  writer.AppendChunk({MakeColumn("a", ColumnType::INT, 3)});
+  writer.AppendChunk({MakeColumn("a", ColumnType::STRING, 3)});
+  EXPECT_THROW(ResultStoreReader(filename).ReadColumn("a"),
+               std::runtime_error);
+
+  // a partly written chunk is ignored
+  std::ofstream(filename, std::ios::binary | std::ios::app) << "CHNK1234";
+  EXPECT_EQ(ResultStoreReader(filename).GetNumChunks(), 2);
+
+  std::ofstream(TempFile("not_a_store.columns")) << "no result store";
+  EXPECT_THROW(ResultStoreReader(::testing::TempDir() + "not_a_store.columns"),
+               std::runtime_error);
+}
+
+TEST(result_store, append_after_torn_chunk) {
+  const std::string filename = TempFile("result_store_torn.columns");
+  {
+    ResultStoreWriter writer(filename);
+    writer.AppendChunk({MakeColumn("a", ColumnType::INT, 3)});
+    writer.AppendChunk({MakeColumn("a", ColumnType::INT, 2, 3)});
+  }
+  // cut the second chunk in the middle, as an interrupted write would
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  const std::size_t file_size = file.tellg();
+  file.seekg(0);
+  std::string content(file_size, '\0');
+  file.read(&content[0], file_size);
+  file.close();
+  std::ofstream(filename, std::ios::binary | std::ios::trunc)
+      << content.substr(0, file_size - 10);
+  EXPECT_EQ(ResultStoreReader(filename).GetNumChunks(), 1);
+
+  // appending drops the torn chunk, so later chunks are read again
+  {
+    ResultStoreWriter writer(filename);
+    writer.AppendChunk({MakeColumn("a", ColumnType::INT, 2, 3)});
+    writer.AppendChunk({MakeColumn("a", ColumnType::INT, 1, 5)});
+  }
+  ResultStoreReader reader(filename);
+  EXPECT_EQ(reader.GetNumChunks(), 3);
+  EXPECT_EQ(reader.GetNumRows(), 6);
+  EXPECT_EQ(reader.ReadColumn("a").ints,
+            std::vector<int64_t>({0, 1, 2, 3, 4, 5}));
+}
+
+TEST(result_store, benchmark) {
+  const std::string filename = TempFile("result_store_benchmark.columns");
+  const int num_chunks = 100;
+  const std::size_t rows_per_chunk = 1000;
+  auto start = std::chrono::steady_clock::now();
+  ResultStoreWriter writer(filename);
+  for (int i = 0; i < num_chunks; ++i) {
+    writer.AppendChunk(
+        {MakeColumn("config_idx", ColumnType::INT, rows_per_chunk),
+         MakeColumn("collision", ColumnType::BOOL, rows_per_chunk),
+         MakeColumn("step", ColumnType::INT, rows_per_chunk),
+         MakeColumn("velocity", ColumnType::DOUBLE, rows_per_chunk),
+         MakeColumn("behavior", ColumnType::STRING, rows_per_chunk)});
+  }
+  const double write_time = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  ResultStoreReader reader(filename);
+  const Column collision = reader.ReadColumn("collision");
+  const double read_time = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  std::cout << num_chunks * rows_per_chunk << " rows: append "
+            << write_time / num_chunks * 1000.0 << " ms per chunk, "
+            << "single column read " << read_time * 1000.0 << " ms"
+            << std::endl;
+  EXPECT_EQ(collision.Size(), num_chunks * rows_per_chunk);
+}
@@ -8,9 +8,11 @@
 #define BARK_COMMONS_DISTRIBUTION_DISTRIBUTION_HPP_
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <vector>
 
 #include "bark/commons/base_type.hpp"
+#include "bark/commons/distribution/random_stream.hpp"
 
 namespace bark {
 namespace commons {
@@ -27,6 +29,30 @@ class Distribution : public BaseType {
 
   virtual RandomVariate Sample() = 0;
 
+  /**
+   * @brief Samples from the counter-based stream identified by key, the
+   *        result only depends on the seed of the distribution and the key
+   * @note  The default implementation falls back to Sample()
+   */
+  virtual RandomVariate Sample(const RandomStreamKey& key) { return Sample(); }
+
+  /**
+   * @brief Draws num_samples variates into buffer, variate i occupies
+   *        buffer[i * GetDimension(), (i + 1) * GetDimension())
+   * @note  The default implementation calls Sample(), derived distributions
+   *        override it with vectorized generators
+   */
+  virtual void SampleN(std::size_t num_samples,
+                       RandomVariableValueType* buffer) {
+    for (std::size_t i = 0; i < num_samples; ++i) {
+      const RandomVariate variate = Sample();
+      std::copy(variate.begin(), variate.end(), buffer);
+      buffer += variate.size();
+    }
+  }
+
+  virtual std::size_t GetDimension() const { return GetSupport().size(); }
+
   virtual Probability Density(const RandomVariate& variate) const = 0;
 
   virtual Probability CDF(const RandomVariate& variate) const = 0;
@@ -27,6 +27,19 @@ class FixedValue : public Distribution {
 
   virtual RandomVariate Sample() { return fixed_value_; }
 
+  virtual RandomVariate Sample(const RandomStreamKey& key) {
+    return fixed_value_;
+  }
+
+  virtual void SampleN(std::size_t num_samples,
+                       RandomVariableValueType* buffer) {
+    for (std::size_t i = 0; i < num_samples; ++i) {
+      buffer = std::copy(fixed_value_.begin(), fixed_value_.end(), buffer);
+    }
+  }
+
+  virtual std::size_t GetDimension() const { return fixed_value_.size(); }
+
   virtual Probability Density(const RandomVariate& variate) const {
     return 0.0;
   };
@@ -51,10 +64,22 @@ class BoostDistribution1D : public Distribution {
             "RandomSeed", "Specifies seed for mersenne twister engine", 1234)),
         generator_(seed_),
         dist_(DistFromParams(params)),
-        uniform_generator_(0, 1.0) {}
+        uniform_generator_(0, 1.0),
+        normal_generator_(boost::math::mean(dist_),
+                          boost::math::standard_deviation(dist_)) {}
 
   virtual RandomVariate Sample();
 
+  virtual RandomVariate Sample(const RandomStreamKey& key) {
+    RandomStream stream(seed_, key);
+    return RandomVariate(1, boost::math::quantile(dist_, stream.NextUniform()));
+  }
+
+  virtual void SampleN(std::size_t num_samples,
+                       RandomVariableValueType* buffer);
+
+  virtual std::size_t GetDimension() const { return 1; }
+
   virtual Probability Density(const RandomVariate& variate) const {
     return boost::math::pdf(dist_, variate[0]);
   };
@@ -72,6 +97,9 @@ class BoostDistribution1D : public Distribution {
   std::mt19937 generator_;
   BoostDistType dist_;
   std::uniform_real_distribution<RandomVariableValueType> uniform_generator_;
+  // batched draws of normal distributions, keeps its cached variate between
+  // calls
+  std::normal_distribution<RandomVariableValueType> normal_generator_;
 };
 
 template <class BoostDistType>
@@ -83,10 +111,42 @@ inline RandomVariate BoostDistribution1D<BoostDistType>::Sample() {
   return RandomVariate(1, sample);
 }
 
+template <class BoostDistType>
+inline void BoostDistribution1D<BoostDistType>::SampleN(
+    std::size_t num_samples, RandomVariableValueType* buffer) {
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    buffer[i] = boost::math::quantile(dist_, uniform_generator_(generator_));
+  }
+}
+
 using boost_normal = boost::math::normal_distribution<RandomVariableValueType>;
 using boost_uniform =
     boost::math::uniform_distribution<RandomVariableValueType>;
 
+// the closed forms avoid the quantile function, the samples follow the
+// same distribution but, for batches, not the same sequence as Sample()
+template <>
+inline void BoostDistribution1D<boost_uniform>::SampleN(
+    std::size_t num_samples, RandomVariableValueType* buffer) {
+  const RandomVariableValueType lower = dist_.lower();
+  const RandomVariableValueType range = dist_.upper() - dist_.lower();
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    buffer[i] = lower + range * uniform_generator_(generator_);
+  }
+}
+
+template <>
+inline void BoostDistribution1D<boost_normal>::SampleN(
+    std::size_t num_samples, RandomVariableValueType* buffer) {
+  if (num_samples == 1) {
+    buffer[0] = boost::math::quantile(dist_, uniform_generator_(generator_));
+    return;
+  }
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    buffer[i] = normal_generator_(generator_);
+  }
+}
+
 template <>
 inline boost_uniform BoostDistribution1D<boost_uniform>::DistFromParams(
     const ParamsPtr& params) const {
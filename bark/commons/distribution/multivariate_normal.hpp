@@ -35,6 +35,13 @@ class MultivariateDistribution : public Distribution {
 
   virtual RandomVariate Sample();
 
+  virtual RandomVariate Sample(const RandomStreamKey& key);
+
+  virtual void SampleN(std::size_t num_samples,
+                       RandomVariableValueType* buffer);
+
+  virtual std::size_t GetDimension() const { return mean_.size(); }
+
   virtual Probability Density(const RandomVariate& variate) const {
     return 0.0;
   };
@@ -68,6 +75,28 @@ inline RandomVariate MultivariateDistribution::Sample() {
   return sample;
 }
 
+inline RandomVariate MultivariateDistribution::Sample(
+    const RandomStreamKey& key) {
+  RandomStream stream(seed_, key);
+  Eigen::VectorXd normal_sample(mean_.size());
+  for (Eigen::Index i = 0; i < normal_sample.size(); ++i) {
+    normal_sample(i) = stream.NextNormal();
+  }
+  Eigen::VectorXd eigen_sample = mean_ + transform_ * normal_sample;
+  return RandomVariate(eigen_sample.data(),
+                       eigen_sample.data() + eigen_sample.size());
+}
+
+inline void MultivariateDistribution::SampleN(
+    std::size_t num_samples, RandomVariableValueType* buffer) {
+  // one column per variate, column-major storage keeps variates contiguous
+  Eigen::Map<Eigen::MatrixXd> samples(buffer, mean_.size(), num_samples);
+  for (Eigen::Index i = 0; i < samples.size(); ++i) {
+    samples.data()[i] = dist_(generator_);
+  }
+  samples = (transform_ * samples).colwise() + mean_;
+}
+
 inline Eigen::MatrixXd MultivariateDistribution::CovarFromParams(
     const ParamsPtr& params) const {
   auto covar_vector = params->GetListListFloat(
@@ -0,0 +1,126 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_COMMONS_DISTRIBUTION_RANDOM_STREAM_HPP_
+#define BARK_COMMONS_DISTRIBUTION_RANDOM_STREAM_HPP_
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace bark {
+namespace commons {
+
+/**
+ * @brief Identifies an independent random stream
+ *
+ * Draws from a stream only depend on the seed of the distribution and this
+ * key, not on the number or order of previous draws. Stochastic components
+ * that key their draws by time step, agent and purpose are thus
+ * reproducible independent of the thread scheduling.
+ */
+struct RandomStreamKey {
+  uint64_t time_step;
+  uint32_t agent_id;
+  uint32_t purpose;
+};
+
+//! discretizes the world time to get the time step of a stream key
+inline uint64_t WorldTimeToTimeStep(double world_time) {
+  return static_cast<uint64_t>(std::llround(world_time * 1000.0));
+}
+
+//! stable 32-bit FNV-1a hash of a purpose name, optionally combined with an id
+inline uint32_t RandomStreamPurpose(const std::string& name,
+                                    uint32_t id = 0) {
+  uint32_t hash = 2166136261u;
+  for (const char c : name) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  for (int i = 0; i < 4; ++i) {
+    hash = (hash ^ ((id >> (8 * i)) & 0xFF)) * 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief Counter-based Philox4x32-10 generator
+ *
+ * Satisfies the UniformRandomBitGenerator requirements. The key holds the
+ * seed and the purpose, the counter the time step, the agent id and the
+ * block index within the stream.
+ */
+class RandomStream {
+ public:
+  typedef uint32_t result_type;
+
+  RandomStream(uint32_t seed, const RandomStreamKey& key)
+      : key_{seed, key.purpose},
+        counter_{static_cast<uint32_t>(key.time_step),
+                 static_cast<uint32_t>(key.time_step >> 32), key.agent_id, 0},
+        block_(),
+        index_(4) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    if (index_ == 4) {
+      block_ = Philox(counter_, key_);
+      ++counter_[3];
+      index_ = 0;
+    }
+    return block_[index_++];
+  }
+
+  //! uniform sample in the open interval (0, 1) with 53 bits of precision
+  double NextUniform() {
+    const uint64_t high = (*this)() >> 5;  // 27 bits
+    const uint64_t low = (*this)() >> 6;   // 26 bits
+    return ((high << 26) + low + 0.5) * (1.0 / 9007199254740992.0);
+  }
+
+  //! standard normal sample using the Box-Muller transform
+  double NextNormal() {
+    const double u1 = NextUniform();
+    const double u2 = NextUniform();
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+  }
+
+ private:
+  typedef std::array<uint32_t, 4> Counter;
+  typedef std::array<uint32_t, 2> Key;
+
+  static Counter Philox(Counter counter, Key key) {
+    for (int round = 0; round < 10; ++round) {
+      const uint64_t product0 = uint64_t(0xD2511F53) * counter[0];
+      const uint64_t product1 = uint64_t(0xCD9E8D57) * counter[2];
+      counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                 static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                 static_cast<uint32_t>(product0)};
+      key[0] += 0x9E3779B9;
+      key[1] += 0xBB67AE85;
+    }
+    return counter;
+  }
+
+  Key key_;
+  Counter counter_;
+  Counter block_;
+  int index_;
+};
+
+}  // namespace commons
+}  // namespace bark
+
+#endif  // BARK_COMMONS_DISTRIBUTION_RANDOM_STREAM_HPP_
@@ -6,6 +6,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <thread>
 
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
@@ -136,6 +137,120 @@ TEST(distribution_test, multivariate_distribution) {
   }
 }
 
+TEST(distribution_test, sample_n) {
+  auto params_ptr = std::make_shared<bark::commons::SetterParams>(true);
+  params_ptr->SetReal("Mean", -3.0);
+  params_ptr->SetReal("StdDev", 2.0);
+  params_ptr->SetReal("LowerBound", -3.0);
+  params_ptr->SetReal("UpperBound", 10.0);
+  params_ptr->SetListFloat("FixedValue", {1.5, 2.5});
+  params_ptr->SetListListFloat("Covariance", {{1.0, 0.2}, {0.2, 3.0}});
+  params_ptr->SetInt("RandomSeed", 1000.0);
+
+  const size_t samples = 100000;
+  std::vector<double> buffer(2 * samples);
+
+  auto dist_normal = bark::commons::NormalDistribution1D(params_ptr);
+  EXPECT_EQ(dist_normal.GetDimension(), 1);
+  dist_normal.SampleN(samples, buffer.data());
+  double mean = 0.0, std_dev = 0.0;
+  for (size_t i = 0; i < samples; ++i) {
+    mean += buffer[i];
+    std_dev += buffer[i] * buffer[i];
+  }
+  mean /= samples;
+  EXPECT_NEAR(mean, -3.0, 0.02);
+  EXPECT_NEAR(sqrt(std_dev / samples - mean * mean), 2.0, 0.02);
+
+  // single draws follow the sequence of Sample()
+  auto dist_normal_single = bark::commons::NormalDistribution1D(params_ptr);
+  auto dist_normal_reference = bark::commons::NormalDistribution1D(params_ptr);
+  for (int i = 0; i < 3; ++i) {
+    dist_normal_single.SampleN(1, buffer.data());
+    EXPECT_EQ(buffer[0], dist_normal_reference.Sample()[0]);
+  }
+
+  auto dist_uniform = bark::commons::UniformDistribution1D(params_ptr);
+  dist_uniform.SampleN(samples, buffer.data());
+  mean = 0.0;
+  for (size_t i = 0; i < samples; ++i) {
+    EXPECT_TRUE(buffer[i] >= -3.0 && buffer[i] <= 10.0);
+    mean += buffer[i];
+  }
+  EXPECT_NEAR(mean / samples, 3.5, 0.05);
+
+  auto fixed_value = bark::commons::FixedValue(params_ptr);
+  EXPECT_EQ(fixed_value.GetDimension(), 2);
+  fixed_value.SampleN(3, buffer.data());
+  EXPECT_EQ(std::vector<double>(buffer.begin(), buffer.begin() + 6),
+            std::vector<double>({1.5, 2.5, 1.5, 2.5, 1.5, 2.5}));
+
+  params_ptr->SetListFloat("Mean", {1.2, 12.0});
+  auto dist_multivariate = bark::commons::MultivariateDistribution(params_ptr);
+  EXPECT_EQ(dist_multivariate.GetDimension(), 2);
+  dist_multivariate.SampleN(samples, buffer.data());
+  std::vector<double> mean_2d(2, 0.0);
+  for (size_t i = 0; i < samples; ++i) {
+    mean_2d[0] += buffer[2 * i];
+    mean_2d[1] += buffer[2 * i + 1];
+  }
+  EXPECT_NEAR(mean_2d[0] / samples, 1.2, 0.02);
+  EXPECT_NEAR(mean_2d[1] / samples, 12.0, 0.02);
+}
+
+TEST(distribution_test, random_streams) {
+  using bark::commons::RandomStreamKey;
+  using bark::commons::RandomVariate;
+  auto params_ptr = std::make_shared<bark::commons::SetterParams>(true);
+  params_ptr->SetReal("Mean", -3.0);
+  params_ptr->SetReal("StdDev", 2.0);
+  params_ptr->SetListListFloat("Covariance", {{1.0, 0.2}, {0.2, 3.0}});
+  params_ptr->SetInt("RandomSeed", 1000.0);
+  auto dist_normal = bark::commons::NormalDistribution1D(params_ptr);
+
+  // draws only depend on the key, not on previous draws
+  const RandomStreamKey key{12, 3, bark::commons::RandomStreamPurpose("test")};
+  const RandomVariate first = dist_normal.Sample(key);
+  dist_normal.Sample();
+  dist_normal.Sample(RandomStreamKey{13, 3, key.purpose});
+  EXPECT_EQ(first, dist_normal.Sample(key));
+  EXPECT_NE(first, dist_normal.Sample(RandomStreamKey{12, 4, key.purpose}));
+  EXPECT_NE(first, dist_normal.Sample(RandomStreamKey{12, 3, key.purpose + 1}));
+
+  size_t samples = 100000;
+  double mean = 0.0, std_dev = 0.0;
+  for (size_t i = 0; i < samples; ++i) {
+    const double sample =
+        dist_normal.Sample(RandomStreamKey{i, 1, key.purpose})[0];
+    mean += sample;
+    std_dev += sample * sample;
+  }
+  mean /= samples;
+  EXPECT_NEAR(mean, -3.0, 0.02);
+  EXPECT_NEAR(sqrt(std_dev / samples - mean * mean), 2.0, 0.02);
+
+  // parallel draws are identical to serial ones
+  params_ptr->SetListFloat("Mean", {1.2, 12.0});
+  auto dist_multivariate = bark::commons::MultivariateDistribution(params_ptr);
+  const uint32_t num_agents = 64;
+  std::vector<RandomVariate> serial(num_agents), parallel(num_agents);
+  for (uint32_t agent_id = 0; agent_id < num_agents; ++agent_id) {
+    serial[agent_id] =
+        dist_multivariate.Sample(RandomStreamKey{5, agent_id, key.purpose});
+  }
+  std::vector<std::thread> threads;
+  for (uint32_t agent_id = num_agents; agent_id-- > 0;) {
+    threads.emplace_back([&, agent_id]() {
+      parallel[agent_id] =
+          dist_multivariate.Sample(RandomStreamKey{5, agent_id, key.purpose});
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(serial, parallel);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -6,7 +6,13 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <chrono>
+#include <new>
+#include <random>
+
 #include "bark/commons/transformation/frenet.hpp"
+#include "bark/commons/transformation/frenet_cache.hpp"
+#include "bark/commons/transformation/frenet_projection.hpp"
 #include "bark/commons/transformation/frenet_state.hpp"
 #include "gtest/gtest.h"
 
@@ -125,4 +131,148 @@ TEST(frenet_state_two_way, straight_line_top_right) {
 
   // state on right side of path with orientation on path
   // test_state_two_way(-1, 5, B_PI_2, 5, line);
-}
\ No newline at end of file
+}
+Line MakeWindingLine(int num_points) {
+  Line line;
+  for (int i = 0; i < num_points; ++i) {
+    line.AddPoint(Point2d(i, 10.0 * std::sin(i / 20.0)));
+  }
+  return line;
+}
+
+std::vector<Point2d> MakeRandomPoints(int num_points, double x_max) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist_x(-10.0, x_max + 10.0);
+  std::uniform_real_distribution<double> dist_y(-20.0, 20.0);
+  std::vector<Point2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    points.push_back(Point2d(dist_x(gen), dist_y(gen)));
+  }
+  return points;
+}
+
+TEST(frenet_projection, equals_frenet_position) {
+  const Line line = MakeWindingLine(200);
+  // includes points before the start and after the end of the line
+  std::vector<Point2d> points = MakeRandomPoints(1001, 199.0);
+  points.push_back(Point2d(50.0, 10.0 * std::sin(50.0 / 20.0)));
+
+  const FrenetProjection projection = ProjectToFrenet(line, points);
+  ASSERT_EQ(projection.lon.size(), points.size());
+  ASSERT_EQ(projection.lat.size(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const FrenetPosition expected(points[i], line);
+    EXPECT_NEAR(projection.lon[i], expected.lon, 1e-6);
+    EXPECT_NEAR(projection.lat[i], expected.lat, 1e-6);
+  }
+
+  Line single_point;
+  single_point.AddPoint(Point2d(1.0, 1.0));
+  const auto single = ProjectToFrenet(single_point, {Point2d(4.0, 5.0)});
+  EXPECT_NEAR(single.lon[0], 0.0, 1e-9);
+  EXPECT_NEAR(single.lat[0], 5.0, 1e-9);
+}
+
+TEST(frenet_projection, benchmark) {
+  const Line line = MakeWindingLine(200);
+  std::cout << "AVX2: " << FrenetProjector::UsesAvx2() << std::endl;
+  for (int num_points : {10, 100, 1000, 10000}) {
+    const std::vector<Point2d> points = MakeRandomPoints(num_points, 199.0);
+
+    auto start = std::chrono::steady_clock::now();
+    double sum_scalar = 0.0;
+    for (const auto& point : points) {
+      sum_scalar += FrenetPosition(point, line).lon;
+    }
+    const double scalar_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    const FrenetProjection projection = ProjectToFrenet(line, points);
+    const double batch_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    double sum_batch = 0.0;
+    for (const double lon : projection.lon) {
+      sum_batch += lon;
+    }
+    std::cout << num_points << " points on " << line.size()
+              << " vertices: FrenetPosition " << scalar_time * 1e6
+              << " us, ProjectToFrenet " << batch_time * 1e6 << " us"
+              << std::endl;
+    EXPECT_NEAR(sum_batch, sum_scalar, 1e-6 * num_points);
+  }
+}
+
+// candidate counts of a lane corridor, the projector is built once per
+// center line and reused
+TEST(frenet_projection, benchmark_few_points) {
+  const Line line = MakeWindingLine(200);
+  const FrenetProjector projector(line);
+  const int num_repetitions = 2000;
+  for (int num_points : {1, 2, 5, 10, 20}) {
+    const std::vector<Point2d> points = MakeRandomPoints(num_points, 199.0);
+
+    auto start = std::chrono::steady_clock::now();
+    double sum_scalar = 0.0;
+    for (int i = 0; i < num_repetitions; ++i) {
+      for (const auto& point : points) {
+        sum_scalar += FrenetPosition(point, line).lon;
+      }
+    }
+    const double scalar_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    double sum_batch = 0.0;
+    for (int i = 0; i < num_repetitions; ++i) {
+      const FrenetProjection projection = projector.Project(points);
+      for (const double lon : projection.lon) {
+        sum_batch += lon;
+      }
+    }
+    const double batch_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << num_points << " points on " << line.size()
+              << " vertices: FrenetPosition "
+              << scalar_time * 1e6 / num_repetitions
+              << " us, FrenetProjector::Project "
+              << batch_time * 1e6 / num_repetitions << " us" << std::endl;
+    EXPECT_NEAR(sum_batch, sum_scalar, 1e-6 * num_points * num_repetitions);
+  }
+}
+
+TEST(frenet_cache, line_identity) {
+  auto make_line = [](double y) {
+    Line line;
+    line.AddPoint(Point2d(0.0, y));
+    line.AddPoint(Point2d(10.0, y));
+    return line;
+  };
+  State state(static_cast<int>(st::MIN_STATE_SIZE));
+  state << 0.0, 5.0, 1.0, 0.0, 10.0;
+  FrenetCache cache;
+
+  // a new line at the address of a freed one is projected again
+  alignas(Line) unsigned char storage[sizeof(Line)];
+  Line* line = new (storage) Line(make_line(0.0));
+  EXPECT_NEAR(cache.Get(state, *line).lat, 1.0, 1e-9);
+  line->~Line();
+  line = new (storage) Line(make_line(2.0));
+  EXPECT_NEAR(cache.Get(state, *line).lat, -1.0, 1e-9);
+
+  // so is a line modified or translated in place
+  *line = make_line(3.0);
+  EXPECT_NEAR(cache.Get(state, *line).lat, -2.0, 1e-9);
+  line->TranslateInPlace(Point2d(0.0, -1.0));
+  EXPECT_NEAR(cache.Get(state, *line).lat, -1.0, 1e-9);
+
+  // an unmodified copy reuses the entry
+  FrenetCache::ResetStatistics();
+  const Line copy(*line);
+  EXPECT_NEAR(cache.Get(state, copy).lat, -1.0, 1e-9);
+  EXPECT_EQ(FrenetCache::GetStatistics().reused, 1u);
+  EXPECT_EQ(FrenetCache::GetStatistics().projections, 0u);
+  line->~Line();
+}
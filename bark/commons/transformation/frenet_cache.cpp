@@ -0,0 +1,78 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/commons/transformation/frenet_cache.hpp"
+
+#include <utility>
+
+namespace bark {
+namespace commons {
+namespace transformation {
+
+using bark::geometry::Line;
+using bark::geometry::LineDerivatives;
+using bark::models::dynamic::State;
+
+std::atomic<uint64_t> FrenetCache::num_projections_(0);
+std::atomic<uint64_t> FrenetCache::num_reused_(0);
+
+FrenetCache::FrenetCache(const FrenetCache& other) {
+  std::lock_guard<std::mutex> lock(other.mutex_);
+  state_ = other.state_;
+  entries_ = other.entries_;
+}
+
+FrenetCache& FrenetCache::operator=(const FrenetCache& other) {
+  if (this == &other) return *this;
+  std::lock(mutex_, other.mutex_);
+  std::lock_guard<std::mutex> lock(mutex_, std::adopt_lock);
+  std::lock_guard<std::mutex> other_lock(other.mutex_, std::adopt_lock);
+  state_ = other.state_;
+  entries_ = other.entries_;
+  return *this;
+}
+
+FrenetState FrenetCache::Get(const State& state, const Line& line) const {
+  std::shared_ptr<const LineDerivatives> line_derivatives =
+      line.GetSharedDerivatives();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (state_.size() != state.size() || state_ != state) {
+    state_ = state;
+    entries_.clear();
+  } else {
+    for (const auto& entry : entries_) {
+      if (entry.line_derivatives == line_derivatives) {
+        num_reused_.fetch_add(1, std::memory_order_relaxed);
+        return entry.frenet_state;
+      }
+    }
+  }
+  num_projections_.fetch_add(1, std::memory_order_relaxed);
+  entries_.push_back(
+      Entry{std::move(line_derivatives), FrenetState(state, line)});
+  return entries_.back().frenet_state;
+}
+
+void FrenetCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  state_.resize(0);
+  entries_.clear();
+}
+
+FrenetCacheStatistics FrenetCache::GetStatistics() {
+  return FrenetCacheStatistics{num_projections_.load(), num_reused_.load()};
+}
+
+void FrenetCache::ResetStatistics() {
+  num_projections_ = 0;
+  num_reused_ = 0;
+}
+
+}  // namespace transformation
+}  // namespace commons
+}  // namespace bark
@@ -0,0 +1,71 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_COMMONS_TRANSFORMATION_FRENET_CACHE_HPP_
+#define BARK_COMMONS_TRANSFORMATION_FRENET_CACHE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "bark/commons/transformation/frenet_state.hpp"
+
+namespace bark {
+namespace commons {
+namespace transformation {
+
+struct FrenetCacheStatistics {
+  uint64_t projections;  //! frenet states computed
+  uint64_t reused;       //! frenet states served from a cache
+};
+
+/**
+ * @brief Frenet states of one dynamic state w.r.t. several lines
+ *
+ * The entries are valid as long as the state does not change; a query with
+ * a different state clears the cache. Lines are identified by their shared
+ * derivatives, which the entries keep alive: a freed line whose address is
+ * reused or a modified line never hits a stale entry, while unmodified
+ * copies of a line share entries. The cache is thread-safe.
+ */
+class FrenetCache {
+ public:
+  FrenetCache() {}
+  FrenetCache(const FrenetCache& other);
+  FrenetCache& operator=(const FrenetCache& other);
+
+  FrenetState Get(const bark::models::dynamic::State& state,
+                  const bark::geometry::Line& line) const;
+
+  void Clear();
+
+  //! global counters of all caches
+  static FrenetCacheStatistics GetStatistics();
+  static void ResetStatistics();
+
+ private:
+  struct Entry {
+    std::shared_ptr<const bark::geometry::LineDerivatives> line_derivatives;
+    FrenetState frenet_state;
+  };
+
+  mutable std::mutex mutex_;
+  mutable bark::models::dynamic::State state_;
+  mutable std::vector<Entry> entries_;
+
+  static std::atomic<uint64_t> num_projections_;
+  static std::atomic<uint64_t> num_reused_;
+};
+
+}  // namespace transformation
+}  // namespace commons
+}  // namespace bark
+
+#endif  // BARK_COMMONS_TRANSFORMATION_FRENET_CACHE_HPP_
@@ -0,0 +1,231 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/commons/transformation/frenet_projection.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BARK_FRENET_PROJECTION_AVX2
+#include <immintrin.h>
+#endif
+
+namespace bark {
+namespace commons {
+namespace transformation {
+
+using bark::geometry::Line;
+using bark::geometry::Point2d;
+namespace bg = boost::geometry;
+
+FrenetProjector::FrenetProjector(const Line& line)
+    : single_point_(false), single_x_(0.0), single_y_(0.0) {
+  const auto& points = line.obj_;
+  if (points.size() == 1) {
+    single_point_ = true;
+    single_x_ = bg::get<0>(points.front());
+    single_y_ = bg::get<1>(points.front());
+  }
+  if (points.size() < 2) {
+    return;
+  }
+  const std::size_t num_segments = points.size() - 1;
+  start_x_.resize(num_segments);
+  start_y_.resize(num_segments);
+  dir_x_.resize(num_segments);
+  dir_y_.resize(num_segments);
+  inv_length_sq_.resize(num_segments);
+  start_s_.resize(num_segments);
+  length_.resize(num_segments);
+  for (std::size_t i = 0; i < num_segments; ++i) {
+    start_x_[i] = bg::get<0>(points[i]);
+    start_y_[i] = bg::get<1>(points[i]);
+    dir_x_[i] = bg::get<0>(points[i + 1]) - start_x_[i];
+    dir_y_[i] = bg::get<1>(points[i + 1]) - start_y_[i];
+    const double length_sq = dir_x_[i] * dir_x_[i] + dir_y_[i] * dir_y_[i];
+    // degenerate segments project onto their start point
+    inv_length_sq_[i] = length_sq > 0.0 ? 1.0 / length_sq : 0.0;
+    start_s_[i] = line.s_[i];
+    length_[i] = line.s_[i + 1] - line.s_[i];
+  }
+
+  // tangents at the vertices as in GetTangentAngleAtS: the first and the
+  // last segment at the ends, the mean direction of both adjacent segments
+  // in between
+  vertex_tangent_x_.resize(points.size());
+  vertex_tangent_y_.resize(points.size());
+  auto unit = [&](std::size_t i, double* x, double* y) {
+    const double length = std::hypot(dir_x_[i], dir_y_[i]);
+    *x = length > 0.0 ? dir_x_[i] / length : 0.0;
+    *y = length > 0.0 ? dir_y_[i] / length : 0.0;
+  };
+  unit(0, &vertex_tangent_x_[0], &vertex_tangent_y_[0]);
+  unit(num_segments - 1, &vertex_tangent_x_[num_segments],
+       &vertex_tangent_y_[num_segments]);
+  for (std::size_t i = 1; i < num_segments; ++i) {
+    double x0, y0, x1, y1;
+    unit(i - 1, &x0, &y0);
+    unit(i, &x1, &y1);
+    vertex_tangent_x_[i] = x0 + x1;
+    vertex_tangent_y_[i] = y0 + y1;
+  }
+}
+
+inline void FrenetProjector::Finish(double px, double py, std::size_t segment,
+                                    double lambda, double* lon,
+                                    double* lat) const {
+  const double nearest_x = start_x_[segment] + lambda * dir_x_[segment];
+  const double nearest_y = start_y_[segment] + lambda * dir_y_[segment];
+  const double diff_x = px - nearest_x;
+  const double diff_y = py - nearest_y;
+
+  double tangent_x = dir_x_[segment], tangent_y = dir_y_[segment];
+  if (lambda <= 0.0) {
+    tangent_x = vertex_tangent_x_[segment];
+    tangent_y = vertex_tangent_y_[segment];
+  } else if (lambda >= 1.0) {
+    tangent_x = vertex_tangent_x_[segment + 1];
+    tangent_y = vertex_tangent_y_[segment + 1];
+  }
+  // positive on the left of the line
+  const double cross = tangent_x * diff_y - tangent_y * diff_x;
+  const double sign = (cross > 0.0) ? 1.0 : ((cross < 0.0) ? -1.0 : 0.0);
+
+  *lon = start_s_[segment] + lambda * length_[segment];
+  *lat = sign * std::sqrt(diff_x * diff_x + diff_y * diff_y);
+}
+
+void FrenetProjector::ProjectScalar(const Point2d* points,
+                                    std::size_t num_points, double* lon,
+                                    double* lat) const {
+  const std::size_t num_segments = start_x_.size();
+  for (std::size_t p = 0; p < num_points; ++p) {
+    const double px = bg::get<0>(points[p]);
+    const double py = bg::get<1>(points[p]);
+    double min_dist_sq = std::numeric_limits<double>::max();
+    std::size_t min_segment = 0;
+    double min_lambda = 0.0;
+    for (std::size_t i = 0; i < num_segments; ++i) {
+      const double wx = px - start_x_[i];
+      const double wy = py - start_y_[i];
+      double lambda = (wx * dir_x_[i] + wy * dir_y_[i]) * inv_length_sq_[i];
+      lambda = std::min(std::max(lambda, 0.0), 1.0);
+      const double ex = wx - lambda * dir_x_[i];
+      const double ey = wy - lambda * dir_y_[i];
+      const double dist_sq = ex * ex + ey * ey;
+      if (dist_sq < min_dist_sq) {
+        min_dist_sq = dist_sq;
+        min_segment = i;
+        min_lambda = lambda;
+      }
+    }
+    Finish(px, py, min_segment, min_lambda, &lon[p], &lat[p]);
+  }
+}
+
+#ifdef BARK_FRENET_PROJECTION_AVX2
+__attribute__((target("avx2"))) void FrenetProjector::ProjectAvx2(
+    const Point2d* points, std::size_t num_points, double* lon,
+    double* lat) const {
+  const std::size_t num_segments = start_x_.size();
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d one = _mm256_set1_pd(1.0);
+  std::size_t p = 0;
+  // four points per iteration, all segments per point
+  for (; p + 4 <= num_points; p += 4) {
+    const __m256d px = _mm256_set_pd(
+        bg::get<0>(points[p + 3]), bg::get<0>(points[p + 2]),
+        bg::get<0>(points[p + 1]), bg::get<0>(points[p]));
+    const __m256d py = _mm256_set_pd(
+        bg::get<1>(points[p + 3]), bg::get<1>(points[p + 2]),
+        bg::get<1>(points[p + 1]), bg::get<1>(points[p]));
+    __m256d min_dist_sq = _mm256_set1_pd(std::numeric_limits<double>::max());
+    __m256d min_segment = zero;
+    __m256d min_lambda = zero;
+    for (std::size_t i = 0; i < num_segments; ++i) {
+      const __m256d dx = _mm256_broadcast_sd(&dir_x_[i]);
+      const __m256d dy = _mm256_broadcast_sd(&dir_y_[i]);
+      const __m256d wx = _mm256_sub_pd(px, _mm256_broadcast_sd(&start_x_[i]));
+      const __m256d wy = _mm256_sub_pd(py, _mm256_broadcast_sd(&start_y_[i]));
+      __m256d lambda = _mm256_mul_pd(
+          _mm256_add_pd(_mm256_mul_pd(wx, dx), _mm256_mul_pd(wy, dy)),
+          _mm256_broadcast_sd(&inv_length_sq_[i]));
+      lambda = _mm256_min_pd(_mm256_max_pd(lambda, zero), one);
+      const __m256d ex = _mm256_sub_pd(wx, _mm256_mul_pd(lambda, dx));
+      const __m256d ey = _mm256_sub_pd(wy, _mm256_mul_pd(lambda, dy));
+      const __m256d dist_sq =
+          _mm256_add_pd(_mm256_mul_pd(ex, ex), _mm256_mul_pd(ey, ey));
+      const __m256d closer = _mm256_cmp_pd(dist_sq, min_dist_sq, _CMP_LT_OQ);
+      min_dist_sq = _mm256_blendv_pd(min_dist_sq, dist_sq, closer);
+      min_lambda = _mm256_blendv_pd(min_lambda, lambda, closer);
+      min_segment = _mm256_blendv_pd(
+          min_segment, _mm256_set1_pd(static_cast<double>(i)), closer);
+    }
+    double segments[4], lambdas[4];
+    _mm256_storeu_pd(segments, min_segment);
+    _mm256_storeu_pd(lambdas, min_lambda);
+    for (std::size_t k = 0; k < 4; ++k) {
+      Finish(bg::get<0>(points[p + k]), bg::get<1>(points[p + k]),
+             static_cast<std::size_t>(segments[k]), lambdas[k], &lon[p + k],
+             &lat[p + k]);
+    }
+  }
+  ProjectScalar(points + p, num_points - p, lon + p, lat + p);
+}
+
+bool FrenetProjector::UsesAvx2() {
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  return avx2;
+}
+#else
+void FrenetProjector::ProjectAvx2(const Point2d* points,
+                                  std::size_t num_points, double* lon,
+                                  double* lat) const {
+  ProjectScalar(points, num_points, lon, lat);
+}
+
+bool FrenetProjector::UsesAvx2() { return false; }
+#endif
+
+void FrenetProjector::Project(const Point2d* points, std::size_t num_points,
+                              double* lon, double* lat) const {
+  if (start_x_.empty()) {
+    // lines with less than two points
+    for (std::size_t p = 0; p < num_points; ++p) {
+      lon[p] = 0.0;
+      lat[p] = single_point_ ? std::hypot(bg::get<0>(points[p]) - single_x_,
+                                          bg::get<1>(points[p]) - single_y_)
+                             : 0.0;
+    }
+  } else if (UsesAvx2()) {
+    ProjectAvx2(points, num_points, lon, lat);
+  } else {
+    ProjectScalar(points, num_points, lon, lat);
+  }
+}
+
+FrenetProjection FrenetProjector::Project(
+    const std::vector<Point2d>& points) const {
+  FrenetProjection projection;
+  projection.lon.resize(points.size());
+  projection.lat.resize(points.size());
+  Project(points.data(), points.size(), projection.lon.data(),
+          projection.lat.data());
+  return projection;
+}
+
+FrenetProjection ProjectToFrenet(const Line& line,
+                                 const std::vector<Point2d>& points) {
+  return FrenetProjector(line).Project(points);
+}
+
+}  // namespace transformation
+}  // namespace commons
+}  // namespace bark
@@ -0,0 +1,82 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_COMMONS_TRANSFORMATION_FRENET_PROJECTION_HPP_
+#define BARK_COMMONS_TRANSFORMATION_FRENET_PROJECTION_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "bark/geometry/line.hpp"
+
+namespace bark {
+namespace commons {
+namespace transformation {
+
+//! longitudinal and lateral coordinates of many points, lon[i] and lat[i]
+//! belong to the i-th point
+struct FrenetProjection {
+  std::vector<double> lon;
+  std::vector<double> lat;
+};
+
+/**
+ * @brief Projects many points onto one line
+ *
+ * The segment data of the line (start points, directions, inverse squared
+ * lengths and tangents at the vertices) is precomputed once. Project then
+ * searches the nearest segment of several points at once, using AVX2 if the
+ * CPU supports it and a scalar loop otherwise. The results equal
+ * FrenetPosition(point, line) up to rounding.
+ */
+class FrenetProjector {
+ public:
+  explicit FrenetProjector(const bark::geometry::Line& line);
+
+  //! writes the frenet coordinates of points[0..num_points) to lon and lat
+  void Project(const bark::geometry::Point2d* points, std::size_t num_points,
+               double* lon, double* lat) const;
+
+  FrenetProjection Project(
+      const std::vector<bark::geometry::Point2d>& points) const;
+
+  //! true if Project uses the AVX2 implementation
+  static bool UsesAvx2();
+
+ private:
+  //! completes the projection given the nearest segment and the clamped
+  //! position on it
+  void Finish(double px, double py, std::size_t segment, double lambda,
+              double* lon, double* lat) const;
+  void ProjectScalar(const bark::geometry::Point2d* points,
+                     std::size_t num_points, double* lon, double* lat) const;
+  void ProjectAvx2(const bark::geometry::Point2d* points,
+                   std::size_t num_points, double* lon, double* lat) const;
+
+  // per segment i from vertex i to vertex i + 1
+  std::vector<double> start_x_, start_y_;
+  std::vector<double> dir_x_, dir_y_;
+  std::vector<double> inv_length_sq_;
+  std::vector<double> start_s_, length_;
+  // per vertex: tangent used for the sign of the lateral coordinate
+  std::vector<double> vertex_tangent_x_, vertex_tangent_y_;
+  // single-point lines
+  bool single_point_;
+  double single_x_, single_y_;
+};
+
+//! batch version of FrenetPosition(point, line) for all points
+FrenetProjection ProjectToFrenet(
+    const bark::geometry::Line& line,
+    const std::vector<bark::geometry::Point2d>& points);
+
+}  // namespace transformation
+}  // namespace commons
+}  // namespace bark
+
+#endif  // BARK_COMMONS_TRANSFORMATION_FRENET_PROJECTION_HPP_
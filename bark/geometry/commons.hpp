@@ -112,6 +112,17 @@ struct Shape {
   // return object transform
   std::shared_ptr<Shape<G, T>> Transform(const Pose& pose) const;
 
+  // allocation-free variants: the out-parameter versions copy the object
+  // into out, reusing the point storage of out, and transform it in place
+  void ScalingTransform(const double& scaling_factor, const Pose& pose,
+                        Shape<G, T>* out) const;
+  void Transform(const Pose& pose, Shape<G, T>* out) const;
+  virtual void ScalingTransformInPlace(const double& scaling_factor,
+                                       const Pose& pose);
+  void TransformInPlace(const Pose& pose);
+  void RotateInPlace(const double& a);
+  virtual void TranslateInPlace(const Point2d& point);
+
   virtual bool Valid() const;
 
   virtual Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> ToArray()
@@ -147,108 +158,90 @@ inline bool Shape<G, T>::Valid() const {
 }
 
 template <typename G, typename T>
-inline std::shared_ptr<Shape<G, T>> Shape<G, T>::Rotate(const double& a) const {
-  namespace trans = boost::geometry::strategy::transform;
-  // move shape relative to coordinate center
-  trans::translate_transformer<double, 2, 2> translate_rel_to_center(
-      -center_[0], -center_[1]);
-  G obj_rel_translated;
-  boost::geometry::transform(obj_, obj_rel_translated, translate_rel_to_center);
-
-  // rotate (counterclockwise)
-  trans::rotate_transformer<boost::geometry::radian, double, 2, 2> rotate(-a);
-  G obj_rotated;
-  boost::geometry::transform(obj_rel_translated, obj_rotated, rotate);
-
-  // move object backwards plus translation component
-  trans::translate_transformer<double, 2, 2> translate_backwards(center_[0],
-                                                                 center_[1]);
-  G obj_transformed;
-  boost::geometry::transform(obj_rotated, obj_transformed, translate_backwards);
+inline void Shape<G, T>::ScalingTransformInPlace(const double& scaling_factor,
+                                                 const Pose& pose) {
+  // scales and rotates (counterclockwise) relative to the center, then
+  // moves the object by the translation component; the rotation is
+  // computed once for all points
+  const double cos_a = cos(pose[2]);
+  const double sin_a = sin(pose[2]);
+  const double center_x = center_[0], center_y = center_[1];
+  const double target_x = center_x + pose[0], target_y = center_y + pose[1];
+  bg::for_each_point(obj_, [&](T& point) {
+    const double x = scaling_factor * (bg::get<0>(point) - center_x);
+    const double y = scaling_factor * (bg::get<1>(point) - center_y);
+    bg::set<0>(point, cos_a * x - sin_a * y + target_x);
+    bg::set<1>(point, sin_a * x + cos_a * y + target_y);
+  });
+  center_[0] += pose[0];
+  center_[1] += pose[1];
+  center_[2] += pose[2];
+}
+
+template <typename G, typename T>
+inline void Shape<G, T>::TransformInPlace(const Pose& pose) {
+  ScalingTransformInPlace(1.0, pose);
+}
+
+template <typename G, typename T>
+inline void Shape<G, T>::RotateInPlace(const double& a) {
+  ScalingTransformInPlace(1.0, Pose(0.0, 0.0, a));
+}
+
+template <typename G, typename T>
+inline void Shape<G, T>::TranslateInPlace(const Point2d& point) {
+  const double dx = bg::get<0>(point), dy = bg::get<1>(point);
+  bg::for_each_point(obj_, [&](T& p) {
+    bg::set<0>(p, bg::get<0>(p) + dx);
+    bg::set<1>(p, bg::get<1>(p) + dy);
+  });
+  center_[0] += dx;
+  center_[1] += dy;
+}
 
+template <typename G, typename T>
+inline void Shape<G, T>::ScalingTransform(const double& scaling_factor,
+                                          const Pose& pose,
+                                          Shape<G, T>* out) const {
+  out->obj_ = obj_;
+  out->id_ = id_;
+  out->center_ = center_;
+  out->ScalingTransformInPlace(scaling_factor, pose);
+}
+
+template <typename G, typename T>
+inline void Shape<G, T>::Transform(const Pose& pose, Shape<G, T>* out) const {
+  ScalingTransform(1.0, pose, out);
+}
+
+template <typename G, typename T>
+inline std::shared_ptr<Shape<G, T>> Shape<G, T>::Rotate(const double& a) const {
   std::shared_ptr<Shape<G, T>> shape_transformed = this->Clone();
-  shape_transformed->obj_ = obj_transformed;
-  shape_transformed->center_[2] += a;
+  shape_transformed->RotateInPlace(a);
   return shape_transformed;
 }
 
 template <typename G, typename T>
 inline std::shared_ptr<Shape<G, T>> Shape<G, T>::ScalingTransform(
     const double& scaling_factor, const Pose& pose) const {
-  namespace trans = boost::geometry::strategy::transform;
-  // move shape relative to coordinate center
-  trans::translate_transformer<double, 2, 2> translate_rel_to_center(
-      -center_[0], -center_[1]);
-  G obj_rel_translated;
-  boost::geometry::transform(obj_, obj_rel_translated, translate_rel_to_center);
-
-  trans::scale_transformer<double, 2, 2> scale(scaling_factor);
-  G obj_scaled;
-  boost::geometry::transform(obj_rel_translated, obj_scaled, scale);
-
-  // rotate (counterclockwise)
-  trans::rotate_transformer<boost::geometry::radian, double, 2, 2> rotate(
-      -pose[2]);
-  G obj_rotated;
-  boost::geometry::transform(obj_scaled, obj_rotated, rotate);
-
-  // move object backwards plus translation component
-  trans::translate_transformer<double, 2, 2> translate_backwards(
-      center_[0] + pose[0], center_[1] + pose[1]);
-  G obj_transformed;
-  boost::geometry::transform(obj_rotated, obj_transformed, translate_backwards);
-
   std::shared_ptr<Shape<G, T>> shape_transformed = this->Clone();
-  shape_transformed->obj_ = obj_transformed;
-  shape_transformed->center_[0] += pose[0];
-  shape_transformed->center_[1] += pose[1];
-  shape_transformed->center_[2] += pose[2];
+  shape_transformed->ScalingTransformInPlace(scaling_factor, pose);
   return shape_transformed;
 }
 
 template <typename G, typename T>
 inline std::shared_ptr<Shape<G, T>> Shape<G, T>::Translate(
     const Point2d& point) const {
-  namespace trans = boost::geometry::strategy::transform;
-  trans::translate_transformer<double, 2, 2> translate_backwards(
-      bg::get<0>(point), bg::get<1>(point));
-  G obj_transformed;
-  boost::geometry::transform(obj_, obj_transformed, translate_backwards);
-
   std::shared_ptr<Shape<G, T>> shape_transformed = this->Clone();
-  shape_transformed->obj_ = obj_transformed;
-  shape_transformed->center_[0] += bg::get<0>(point);
-  shape_transformed->center_[1] += bg::get<1>(point);
+  shape_transformed->TranslateInPlace(point);
   return shape_transformed;
 }
 
 template <typename G, typename T>
 inline std::shared_ptr<Shape<G, T>> Shape<G, T>::Transform(
     const Pose& pose) const {
-  namespace trans = boost::geometry::strategy::transform;
-  // move shape relative to coordinate center
-  trans::translate_transformer<double, 2, 2> translate_rel_to_center(
-      -center_[0], -center_[1]);
-  G obj_rel_translated;
-  boost::geometry::transform(obj_, obj_rel_translated, translate_rel_to_center);
-
-  // rotate (counterclockwise)
-  trans::rotate_transformer<boost::geometry::radian, double, 2, 2> rotate(
-      -pose[2]);
-  G obj_rotated;
-  boost::geometry::transform(obj_rel_translated, obj_rotated, rotate);
-
-  // move object backwards plus translation component
-  trans::translate_transformer<double, 2, 2> translate_backwards(
-      center_[0] + pose[0], center_[1] + pose[1]);
-  G obj_transformed;
-  boost::geometry::transform(obj_rotated, obj_transformed, translate_backwards);
-
   std::shared_ptr<Shape<G, T>> shape_transformed = this->Clone();
-  shape_transformed->obj_ = obj_transformed;
-  shape_transformed->center_[0] += pose[0];
-  shape_transformed->center_[1] += pose[1];
-  shape_transformed->center_[2] += pose[2];
+  shape_transformed->TransformInPlace(pose);
   return shape_transformed;
 }
 
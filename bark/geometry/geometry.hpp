@@ -12,8 +12,10 @@
 #include "bark/geometry/angle.hpp"
 #include "bark/geometry/commons.hpp"
 #include "bark/geometry/line.hpp"
+#include "bark/geometry/local_line.hpp"
 #include "bark/geometry/model_3d.hpp"
 #include "bark/geometry/polygon.hpp"
+#include "bark/geometry/prepared_polygon.hpp"
 #include "bark/geometry/standard_shapes.hpp"
 
 #endif  // BARK_GEOMETRY_GEOMETRY_HPP_
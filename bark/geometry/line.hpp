@@ -10,8 +10,10 @@
 #define BARK_GEOMETRY_LINE_HPP_
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -28,6 +30,22 @@
 namespace bark {
 namespace geometry {
 
+/**
+ * @brief Derived per-segment and per-vertex data of a line
+ *
+ * Segment i goes from vertex i to vertex i + 1. The tangent angle at an
+ * inner vertex is the mean direction of its two adjacent segments, at the
+ * first and the last vertex it is the angle of the first and the last
+ * segment. The curvature is the central-difference curvature per vertex.
+ */
+struct LineDerivatives {
+  std::vector<double> segment_angle;
+  std::vector<double> segment_cos, segment_sin;
+  std::vector<double> vertex_angle;
+  std::vector<double> vertex_cos, vertex_sin;
+  Eigen::VectorXd curvature;
+};
+
 //! templated line class with a boost polygon as a member function
 template <typename T>
 class Line_t : public Shape<bg::model::linestring<T>, T> {
@@ -36,13 +54,69 @@ class Line_t : public Shape<bg::model::linestring<T>, T> {
       : Shape<bg::model::linestring<T>, T>(Pose(0, 0, 0), std::vector<T>(), 0) {
   }
 
+  // the derivatives are immutable once built and may be shared by copies
+  Line_t(const Line_t& line)
+      : Shape<bg::model::linestring<T>, T>(line),
+        s_(line.s_),
+        derivatives_owner_(std::atomic_load(&line.derivatives_owner_)),
+        derivatives_(derivatives_owner_.get()) {}
+  Line_t(Line_t&& line)
+      : Shape<bg::model::linestring<T>, T>(std::move(line)),
+        s_(std::move(line.s_)),
+        derivatives_owner_(std::move(line.derivatives_owner_)),
+        derivatives_(line.derivatives_.exchange(nullptr)) {}
+  Line_t& operator=(const Line_t& line) {
+    Shape<bg::model::linestring<T>, T>::operator=(line);
+    s_ = line.s_;
+    std::shared_ptr<const LineDerivatives> derivatives =
+        std::atomic_load(&line.derivatives_owner_);
+    derivatives_ = derivatives.get();
+    std::atomic_store(&derivatives_owner_, derivatives);
+    return *this;
+  }
+  Line_t& operator=(Line_t&& line) {
+    Shape<bg::model::linestring<T>, T>::operator=(std::move(line));
+    s_ = std::move(line.s_);
+    derivatives_ = line.derivatives_.exchange(nullptr);
+    derivatives_owner_ = std::move(line.derivatives_owner_);
+    return *this;
+  }
+
   virtual Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> ToArray() const;
 
   virtual std::shared_ptr<Shape<bg::model::linestring<T>, T>> Clone() const;
 
-  //! TODO(@all): do not recompute full s but only add one point
+  //! rotations change the derivatives, scaling also changes s
+  void ScalingTransformInPlace(const double& scaling_factor,
+                               const Pose& pose) override {
+    Shape<bg::model::linestring<T>, T>::ScalingTransformInPlace(scaling_factor,
+                                                                pose);
+    if (scaling_factor != 1.0) {
+      RecomputeS();
+    } else {
+      InvalidateDerivatives();
+    }
+  }
+
+  //! translations keep s but change the identity of the derivatives
+  void TranslateInPlace(const Point2d& point) override {
+    Shape<bg::model::linestring<T>, T>::TranslateInPlace(point);
+    InvalidateDerivatives();
+  }
+
+  //! appends p and its s value, a full RecomputeS is only needed if obj_
+  //! was modified directly before
   bool AddPoint(const T& p) {
-    return Shape<bg::model::linestring<T>, T>::AddPoint(p) && RecomputeS();
+    auto& points = Shape<bg::model::linestring<T>, T>::obj_;
+    if (s_.size() != points.size()) {
+      return Shape<bg::model::linestring<T>, T>::AddPoint(p) && RecomputeS();
+    }
+    InvalidateDerivatives();
+    const double s =
+        points.empty() ? 0.0 : s_.back() + bg::distance(p, points.back());
+    Shape<bg::model::linestring<T>, T>::AddPoint(p);
+    s_.push_back(s);
+    return true;
   }
 
   auto Length() const {
@@ -74,6 +148,7 @@ class Line_t : public Shape<bg::model::linestring<T>, T> {
 
   void Reverse() {
     boost::geometry::reverse(Shape<bg::model::linestring<T>, T>::obj_);
+    InvalidateDerivatives();
   }
 
   typedef typename std::vector<T>::iterator point_iterator;
@@ -111,8 +186,33 @@ class Line_t : public Shape<bg::model::linestring<T>, T> {
   //! local coordinates 0..[total distance] along the lines
   std::vector<double> s_;
 
+  /**
+   * @brief Segment angles, tangents and curvature of the line. They are
+   *        computed on the first call and reused until RecomputeS or
+   *        Reverse is called. Lines with less than two points have none.
+   */
+  const LineDerivatives& GetDerivatives() const;
+
+  /**
+   * @brief Shared ownership of the derivatives. Copies of a line share them
+   *        until one of them is modified, so they identify the geometry
+   *        while held, unlike the address of the line.
+   */
+  std::shared_ptr<const LineDerivatives> GetSharedDerivatives() const {
+    GetDerivatives();
+    return std::atomic_load(&derivatives_owner_);
+  }
+
+  void InvalidateDerivatives() {
+    derivatives_ = nullptr;
+    std::atomic_store(&derivatives_owner_,
+                      std::shared_ptr<const LineDerivatives>());
+  }
+
   //! @todo free function, s_ private?
+  //! has to be called after modifying obj_
   bool RecomputeS() {
+    InvalidateDerivatives();
     s_.clear();
     // edge case no points
     if (Shape<bg::model::linestring<T>, T>::obj_.empty()) {
@@ -144,6 +244,12 @@ class Line_t : public Shape<bg::model::linestring<T>, T> {
     return bg::equals(this->obj_, rhs.obj_);
   }
   bool operator!=(const Line_t& rhs) const { return !(rhs == *this); }
+
+ private:
+  // derivatives_ is the lock-free read path, derivatives_owner_ keeps the
+  // derivatives alive and is only accessed when building or copying them
+  mutable std::shared_ptr<const LineDerivatives> derivatives_owner_;
+  mutable std::atomic<const LineDerivatives*> derivatives_{nullptr};
 };
 
 //! for better usage simple double defines
@@ -211,8 +317,8 @@ inline Line Simplify(const Line& line, double max_distance) {
   return temp_line;
 }
 
-inline int GetSegmentEndIdx(Line l, double s) {
-  std::vector<double>::iterator up =
+inline int GetSegmentEndIdx(const Line& l, double s) {
+  std::vector<double>::const_iterator up =
       std::upper_bound(l.s_.begin(), l.s_.end(), s);
   if (up != l.s_.end()) {
     int retval = up - l.s_.begin();
@@ -222,9 +328,9 @@ inline int GetSegmentEndIdx(Line l, double s) {
   }
 }
 
-inline bool CheckSForSegmentIntersection(Line l, double s) {
+inline bool CheckSForSegmentIntersection(const Line& l, double s) {
   int start_it = GetSegmentEndIdx(l, s);
-  std::vector<double>::iterator low =
+  std::vector<double>::const_iterator low =
       std::lower_bound(l.s_.begin(), l.s_.end(), s);
   int start_it_low = low - l.s_.begin();
   return start_it != start_it_low;
@@ -251,15 +357,16 @@ inline Eigen::VectorXd Gradient(Eigen::VectorXd vec) {
   return g;
 }
 
-inline Eigen::VectorXd GetCurvature(Line l) {
-  Eigen::MatrixXd larray = l.ToArray();
-  Eigen::VectorXd dx = Gradient(larray.col(0));
+//! central-difference curvature at the points (x, y), at least three
+inline Eigen::VectorXd ComputeCurvature(const Eigen::VectorXd& x,
+                                        const Eigen::VectorXd& y) {
+  Eigen::VectorXd dx = Gradient(x);
   Eigen::VectorXd ddx = Gradient(dx);
-  Eigen::VectorXd dy = Gradient(larray.col(1));
+  Eigen::VectorXd dy = Gradient(y);
   Eigen::VectorXd ddy = Gradient(dy);
 
   // elementwise, as pow(vector, scalar) does not work
-  Eigen::VectorXd curvature(larray.rows());
+  Eigen::VectorXd curvature(x.size());
   for (int i = 0; i < curvature.size(); i++) {
     double n = dx(i) * ddy(i) - ddx(i) * dy(i);
     double r = pow(dx(i), 2) + pow(dy(i), 2);
@@ -273,7 +380,92 @@ inline Eigen::VectorXd GetCurvature(Line l) {
   return curvature;
 }
 
-inline Point2d GetPointAtS(Line l, double s) {
+template <typename T>
+inline const LineDerivatives& Line_t<T>::GetDerivatives() const {
+  const LineDerivatives* derivatives =
+      derivatives_.load(std::memory_order_acquire);
+  if (derivatives) {
+    return *derivatives;
+  }
+
+  auto derivatives_computed = std::make_shared<LineDerivatives>();
+  LineDerivatives* computed = derivatives_computed.get();
+  const auto& points = this->obj_;
+  const std::size_t num_points = points.size();
+  if (num_points >= 2) {
+    const std::size_t num_segments = num_points - 1;
+    computed->segment_angle.resize(num_segments);
+    computed->segment_cos.resize(num_segments);
+    computed->segment_sin.resize(num_segments);
+    for (std::size_t i = 0; i < num_segments; ++i) {
+      const double angle =
+          atan2(bg::get<1>(points[i + 1]) - bg::get<1>(points[i]),
+                bg::get<0>(points[i + 1]) - bg::get<0>(points[i]));
+      computed->segment_angle[i] = angle;
+      computed->segment_cos[i] = cos(angle);
+      computed->segment_sin[i] = sin(angle);
+    }
+
+    computed->vertex_angle.resize(num_points);
+    computed->vertex_angle.front() = computed->segment_angle.front();
+    computed->vertex_angle.back() = computed->segment_angle.back();
+    for (std::size_t i = 1; i < num_segments; ++i) {
+      const double sin_mean =
+          0.5 * (computed->segment_sin[i - 1] + computed->segment_sin[i]);
+      const double cos_mean =
+          0.5 * (computed->segment_cos[i - 1] + computed->segment_cos[i]);
+      computed->vertex_angle[i] = atan2(sin_mean, cos_mean);
+    }
+    computed->vertex_cos.resize(num_points);
+    computed->vertex_sin.resize(num_points);
+    for (std::size_t i = 0; i < num_points; ++i) {
+      computed->vertex_cos[i] = cos(computed->vertex_angle[i]);
+      computed->vertex_sin[i] = sin(computed->vertex_angle[i]);
+    }
+  }
+  computed->curvature = Eigen::VectorXd::Zero(num_points);
+  if (num_points >= 3) {
+    Eigen::VectorXd x(num_points), y(num_points);
+    for (std::size_t i = 0; i < num_points; ++i) {
+      x(i) = bg::get<0>(points[i]);
+      y(i) = bg::get<1>(points[i]);
+    }
+    computed->curvature = ComputeCurvature(x, y);
+  }
+
+  // the first derivatives stored win, so returned references stay valid
+  std::shared_ptr<const LineDerivatives> expected;
+  std::shared_ptr<const LineDerivatives> desired = derivatives_computed;
+  if (std::atomic_compare_exchange_strong(&derivatives_owner_, &expected,
+                                          desired)) {
+    derivatives_.store(computed, std::memory_order_release);
+    return *computed;
+  }
+  derivatives_.store(expected.get(), std::memory_order_release);
+  return *expected;
+}
+
+inline Eigen::VectorXd GetCurvature(const Line& l) {
+  return l.GetDerivatives().curvature;
+}
+
+//! curvature at s, interpolated between the vertices
+inline double GetCurvatureAtS(const Line& l, double s) {
+  const Eigen::VectorXd& curvature = l.GetDerivatives().curvature;
+  if (l.obj_.size() < 2) {
+    return 0.0;
+  } else if (s <= 0.0) {
+    return curvature(0);
+  } else if (s >= l.s_.back()) {
+    return curvature(curvature.size() - 1);
+  }
+  const int end = GetSegmentEndIdx(l, s);
+  const double length = l.s_[end] - l.s_[end - 1];
+  const double lambda = length > 0.0 ? (s - l.s_[end - 1]) / length : 0.0;
+  return (1.0 - lambda) * curvature(end - 1) + lambda * curvature(end);
+}
+
+inline Point2d GetPointAtS(const Line& l, double s) {
   const size_t& length = l.obj_.size();
   if (length <= 1) {  // this is an error Line consist of 0 or 1 element
     return Point2d(0, 0);
@@ -300,74 +492,117 @@ inline Point2d GetPointAtS(Line l, double s) {
   }
 }
 
-inline double GetTangentAngleAtS(Line l, double s) {
+//! index of the segment (false) or vertex (true) derivatives that hold
+//! the tangent at s, throws std::out_of_range for lines with one point
+inline std::pair<std::size_t, bool> GetTangentIdxAtS(const Line& l,
+                                                     double s) {
   if (s >= l.s_.back()) {
-    Point2d p1 = l.obj_.at(l.obj_.size() - 2);
-    Point2d p2 = l.obj_.at(l.obj_.size() - 1);
-    double angle =
-        atan2(bg::get<1>(p2) - bg::get<1>(p1), bg::get<0>(p2) - bg::get<0>(p1));
-    return angle;
+    return std::make_pair(l.obj_.size() - 2, false);
   } else if (s <= 0.0) {
-    Point2d p1 = l.obj_.at(0);
-    Point2d p2 = l.obj_.at(1);
-    return atan2(bg::get<1>(p2) - bg::get<1>(p1),
-                 bg::get<0>(p2) - bg::get<0>(p1));
-  } else {  // not start or end
-    int end_segment_it = GetSegmentEndIdx(l, s);
-    // check if s is at intersection, if true then calculate the angle
-    if (CheckSForSegmentIntersection(l, s)) {
-      Point2d p1 = l.obj_.at(end_segment_it - 2);
-      Point2d p2 = l.obj_.at(end_segment_it - 1);
-      Point2d p3 = l.obj_.at(end_segment_it);
-      double sin_mean = 0.5 * (sin(atan2(bg::get<1>(p2) - bg::get<1>(p1),
-                                         bg::get<0>(p2) - bg::get<0>(p1))) +
-                               sin(atan2(bg::get<1>(p3) - bg::get<1>(p2),
-                                         bg::get<0>(p3) - bg::get<0>(p2))));
-      double cos_mean = 0.5 * (cos(atan2(bg::get<1>(p2) - bg::get<1>(p1),
-                                         bg::get<0>(p2) - bg::get<0>(p1))) +
-                               cos(atan2(bg::get<1>(p3) - bg::get<1>(p2),
-                                         bg::get<0>(p3) - bg::get<0>(p2))));
-      return atan2(sin_mean, cos_mean);
-    } else {  // every s not start, end or intersection
-      Point2d p1 = l.obj_.at(end_segment_it - 1);
-      Point2d p2 = l.obj_.at(end_segment_it);
-      return atan2(bg::get<1>(p2) - bg::get<1>(p1),
-                   bg::get<0>(p2) - bg::get<0>(p1));
-    }
+    return std::make_pair(0, false);
+  }
+  // not start or end, s lies in the segment ending at the first s_ > s and
+  // is at an intersection of two segments if the previous s_ equals s; this
+  // is CheckSForSegmentIntersection with a single search
+  const std::size_t end_segment_it =
+      std::upper_bound(l.s_.begin(), l.s_.end(), s) - l.s_.begin();
+  return std::make_pair(end_segment_it - 1, l.s_[end_segment_it - 1] == s);
+}
+
+inline double GetTangentAngleAtS(const Line& l, double s) {
+  const LineDerivatives& derivatives = l.GetDerivatives();
+  const auto idx = GetTangentIdxAtS(l, s);
+  return idx.second ? derivatives.vertex_angle.at(idx.first)
+                    : derivatives.segment_angle.at(idx.first);
+}
+
+//! unit tangent vector at s
+inline Point2d GetTangentAtS(const Line& l, double s) {
+  const LineDerivatives& derivatives = l.GetDerivatives();
+  const auto idx = GetTangentIdxAtS(l, s);
+  if (idx.second) {
+    return Point2d(derivatives.vertex_cos.at(idx.first),
+                   derivatives.vertex_sin.at(idx.first));
   }
+  return Point2d(derivatives.segment_cos.at(idx.first),
+                 derivatives.segment_sin.at(idx.first));
 }
 
-inline Point2d GetNormalAtS(Line l, double s) {
-  double tangent = GetTangentAngleAtS(l, s);
-  // rotate unit vector anti-clockwise with angle = tangent by 1/2 pi
-  Point2d t(cos(tangent + asin(1)), sin(tangent + asin(1)));
-  return t;
+inline Point2d GetNormalAtS(const Line& l, double s) {
+  const Point2d tangent = GetTangentAtS(l, s);
+  // rotate the tangent anti-clockwise by 1/2 pi
+  return Point2d(-bg::get<1>(tangent), bg::get<0>(tangent));
 }
 
-inline Line GetLineFromSInterval(Line line, double begin, double end) {
+//! the interpolated points at begin and end with all points in between
+inline Line GetLineFromSInterval(const Line& line, double begin, double end) {
+  const std::size_t begin_idx =
+      std::upper_bound(line.s_.begin(), line.s_.end(), begin) -
+      line.s_.begin();
+  const std::size_t end_idx =
+      std::lower_bound(line.s_.begin(), line.s_.end(), end) - line.s_.begin();
   Line new_line;
-  new_line.AddPoint(GetPointAtS(line, begin));
-  std::vector<Point2d> points = line.GetPointsInSInterval(begin, end);
-  for (auto const& point : points) {
-    new_line.AddPoint(point);
-  }
-  new_line.AddPoint(GetPointAtS(line, end));
+  new_line.obj_.reserve(end_idx > begin_idx ? end_idx - begin_idx + 2 : 2);
+  new_line.obj_.push_back(GetPointAtS(line, begin));
+  if (end_idx > begin_idx) {
+    new_line.obj_.insert(new_line.obj_.end(), line.obj_.begin() + begin_idx,
+                         line.obj_.begin() + end_idx);
+  }
+  new_line.obj_.push_back(GetPointAtS(line, end));
+  new_line.RecomputeS();
   return new_line;
 }
 
+//! every point of the line moved along the normal at its s, positive
+//! shifts go to the left
 inline Line GetLineShiftedLaterally(const Line& line, double lateral_shift) {
   Line new_line;
-  for (const auto& s : line.s_) {
-    const Point2d normal = GetNormalAtS(line, s);
-    const Point2d point_at_s = GetPointAtS(line, s);
-    const Point2d shifted = point_at_s + (normal * lateral_shift);
-    new_line.AddPoint(shifted);
+  const std::size_t num_points = line.obj_.size();
+  if (num_points < 2) {
+    // one-point lines have no normal
+    for (const auto& s : line.s_) {
+      new_line.AddPoint(GetPointAtS(line, s) +
+                        GetNormalAtS(line, s) * lateral_shift);
+    }
+    return new_line;
+  }
+
+  // same points and normals as GetPointAtS and GetNormalAtS at each s_[i],
+  // the segment search advances with i instead of starting over
+  const LineDerivatives& derivatives = line.GetDerivatives();
+  new_line.obj_.reserve(num_points);
+  std::size_t end_idx = 1;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double s = line.s_[i];
+    Point2d point;
+    double tangent_cos, tangent_sin;
+    if (s >= line.s_.back()) {
+      point = line.obj_.back();
+      tangent_cos = derivatives.segment_cos.back();
+      tangent_sin = derivatives.segment_sin.back();
+    } else if (s <= 0.0) {
+      point = line.obj_.front();
+      tangent_cos = derivatives.segment_cos.front();
+      tangent_sin = derivatives.segment_sin.front();
+    } else {
+      // first s_ greater than s, s is at the vertex before it
+      while (line.s_[end_idx] <= s) {
+        ++end_idx;
+      }
+      point = line.obj_[end_idx - 1];
+      tangent_cos = derivatives.vertex_cos[end_idx - 1];
+      tangent_sin = derivatives.vertex_sin[end_idx - 1];
+    }
+    new_line.obj_.push_back(
+        Point2d(bg::get<0>(point) - lateral_shift * tangent_sin,
+                bg::get<1>(point) + lateral_shift * tangent_cos));
   }
+  new_line.RecomputeS();
   return new_line;
 }
 
 inline std::tuple<Point2d, double, uint> GetNearestPointAndS(
-    Line l, const Point2d& p) {  // GetNearestPoint
+    const Line& l, const Point2d& p) {  // GetNearestPoint
   // edge cases: empty or one-point line
   if (l.obj_.empty()) {
     return std::make_tuple(Point2d(0, 0), 0.0, 0);
@@ -380,9 +615,8 @@ inline std::tuple<Point2d, double, uint> GetNearestPointAndS(
   double min_dist = boost::numeric::bounds<double>::highest();
   int min_segment_idx = 0;
   for (uint line_idx = 0; line_idx < l.obj_.size() - 1; ++line_idx) {
-    bg::model::linestring<Point2d> current_segment;
-    bg::append(current_segment, l.obj_.at(line_idx));
-    bg::append(current_segment, l.obj_.at(line_idx + 1));
+    const bg::model::referring_segment<const Point2d> current_segment(
+        l.obj_[line_idx], l.obj_[line_idx + 1]);
     double d = bg::comparable_distance(current_segment, p);
     if (d < min_dist) {
       min_dist = d;
@@ -445,13 +679,13 @@ inline std::tuple<Point2d, double, uint> GetNearestPointAndS(
   // return
   return std::make_tuple(retval, s, min_segment_idx);
 }
-inline Point2d GetNearestPoint(Line l, const Point2d& p) {
+inline Point2d GetNearestPoint(const Line& l, const Point2d& p) {
   return std::get<0>(GetNearestPointAndS(l, p));
 }
-inline double GetNearestS(Line l, const Point2d& p) {
+inline double GetNearestS(const Line& l, const Point2d& p) {
   return std::get<1>(GetNearestPointAndS(l, p));
 }
-inline uint FindNearestIdx(Line l, const Point2d& p) {
+inline uint FindNearestIdx(const Line& l, const Point2d& p) {
   return std::get<2>(GetNearestPointAndS(l, p));
 }
 //! Point - Line collision checker using boost::intersection
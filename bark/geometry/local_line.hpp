@@ -0,0 +1,89 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_GEOMETRY_LOCAL_LINE_HPP_
+#define BARK_GEOMETRY_LOCAL_LINE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "bark/geometry/line.hpp"
+
+namespace bark {
+namespace geometry {
+
+/**
+ * @brief Compact storage of a line for map geometry that is kept in memory
+ *        but only read through a conversion to Line
+ *
+ * The points are stored as offsets of type T from a double-precision
+ * origin, the first point of the line. With T = float, points up to two
+ * kilometers from the origin keep an accuracy below 0.1 mm, while a point
+ * takes 8 instead of 24 bytes (point and s value of Line). The s values
+ * are recomputed by ToLine.
+ */
+template <typename T>
+class LocalLine_t {
+ public:
+  LocalLine_t() : origin_(0.0, 0.0) {}
+
+  explicit LocalLine_t(const Line& line) : origin_(0.0, 0.0) {
+    if (!line.obj_.empty()) {
+      origin_ = line.obj_.front();
+    }
+    const double origin_x = bg::get<0>(origin_);
+    const double origin_y = bg::get<1>(origin_);
+    points_.reserve(line.obj_.size());
+    for (const auto& point : line.obj_) {
+      points_.push_back(
+          Point2d_t<T>(static_cast<T>(bg::get<0>(point) - origin_x),
+                       static_cast<T>(bg::get<1>(point) - origin_y)));
+    }
+  }
+
+  //! converts the line back to double precision
+  Line ToLine() const {
+    Line line;
+    const double origin_x = bg::get<0>(origin_);
+    const double origin_y = bg::get<1>(origin_);
+    line.obj_.reserve(points_.size());
+    for (const auto& point : points_) {
+      bg::append(line.obj_,
+                 Point2d(origin_x + static_cast<double>(bg::get<0>(point)),
+                         origin_y + static_cast<double>(bg::get<1>(point))));
+    }
+    line.RecomputeS();
+    return line;
+  }
+
+  std::size_t size() const { return points_.size(); }
+  bool empty() const { return points_.empty(); }
+  const Point2d& GetOrigin() const { return origin_; }
+
+  //! bytes allocated for the points
+  std::size_t MemoryBytes() const {
+    return points_.capacity() * sizeof(Point2d_t<T>);
+  }
+
+ private:
+  Point2d origin_;
+  std::vector<Point2d_t<T>> points_;
+};
+
+using LocalLine = LocalLine_t<float>;
+
+//! bytes allocated for the points and s values of a line
+inline std::size_t MemoryBytes(const Line& line) {
+  return line.obj_.capacity() * sizeof(Point2d) +
+         line.s_.capacity() * sizeof(double);
+}
+
+}  // namespace geometry
+}  // namespace bark
+
+#endif  // BARK_GEOMETRY_LOCAL_LINE_HPP_
@@ -0,0 +1,412 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_GEOMETRY_PREPARED_POLYGON_HPP_
+#define BARK_GEOMETRY_PREPARED_POLYGON_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "bark/geometry/polygon.hpp"
+
+namespace bark {
+namespace geometry {
+
+//! Polygon with precomputed data for repeated Within and Collide queries
+//! against a static polygon (goal areas, road corridors)
+//!
+//! The edges of all rings are bucketed into horizontal strips over the
+//! bounding box. Queries early-out on the bounding box and only test the
+//! edges of the strips that overlap the query. Queries that touch the
+//! boundary fall back to boost to keep the exact boost semantics.
+class PreparedPolygon {
+ public:
+  PreparedPolygon() : PreparedPolygon(Polygon()) {}
+  explicit PreparedPolygon(const Polygon& polygon);
+
+  const Polygon& GetPolygon() const { return polygon_; }
+  bool IsConvex() const { return convex_; }
+  std::size_t GetNumEdges() const { return edges_.size(); }
+  std::size_t GetNumStrips() const { return strip_offsets_.size() - 1; }
+
+  //! true if the closed bounding boxes overlap
+  bool BoundingBoxOverlaps(double xmin, double ymin, double xmax,
+                           double ymax) const {
+    return !empty_ && xmin <= xmax_ && xmax >= xmin_ && ymin <= ymax_ &&
+           ymax >= ymin_;
+  }
+
+  //! true if the box lies within the closed bounding box
+  bool BoundingBoxContains(double xmin, double ymin, double xmax,
+                           double ymax) const {
+    return !empty_ && xmin >= xmin_ && xmax <= xmax_ && ymin >= ymin_ &&
+           ymax <= ymax_;
+  }
+
+  //! point in polygon test; on_boundary is set if the point lies on an edge
+  bool ContainsPoint(double x, double y, bool* on_boundary) const;
+
+  //! point in convex polygon test including the boundary
+  bool ConvexCoversPoint(double x, double y) const;
+
+  //! calls f(edge) for each edge overlapping the box, each edge once;
+  //! stops if f returns false
+  template <typename F>
+  void ForEachEdgeInBox(double xmin, double ymin, double xmax, double ymax,
+                        F f) const;
+
+  struct Edge {
+    double x0, y0, x1, y1;
+    std::size_t first_strip;
+  };
+
+ private:
+  std::size_t StripIndex(double y) const {
+    if (y <= ymin_) return 0;
+    const std::size_t strip =
+        static_cast<std::size_t>((y - ymin_) / strip_height_);
+    return std::min(strip, GetNumStrips() - 1);
+  }
+
+  Polygon polygon_;
+  std::vector<Edge> edges_;
+  //! compressed strip index: edges of strip i are
+  //! strip_edges_[strip_offsets_[i]] .. strip_edges_[strip_offsets_[i+1]]
+  std::vector<uint32_t> strip_offsets_;
+  std::vector<uint32_t> strip_edges_;
+  double xmin_, ymin_, xmax_, ymax_;
+  double strip_height_;
+  //! +1 for counterclockwise and -1 for clockwise outer rings
+  double orientation_;
+  bool convex_;
+  bool empty_;
+};
+
+namespace detail {
+
+inline double Cross(double ax, double ay, double bx, double by, double cx,
+                    double cy) {
+  return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+inline bool OnSegment(double ax, double ay, double bx, double by, double px,
+                      double py) {
+  return std::min(ax, bx) <= px && px <= std::max(ax, bx) &&
+         std::min(ay, by) <= py && py <= std::max(ay, by);
+}
+
+enum class SegmentRelation { kDisjoint, kTouches, kCrosses };
+
+//! closed segment intersection test; kCrosses if the segments cross in a
+//! single point interior to both, kTouches for all other contacts
+inline SegmentRelation RelateSegments(double ax, double ay, double bx,
+                                      double by, double cx, double cy,
+                                      double dx, double dy) {
+  const double d1 = Cross(cx, cy, dx, dy, ax, ay);
+  const double d2 = Cross(cx, cy, dx, dy, bx, by);
+  const double d3 = Cross(ax, ay, bx, by, cx, cy);
+  const double d4 = Cross(ax, ay, bx, by, dx, dy);
+  if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+      ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+    return SegmentRelation::kCrosses;
+  }
+  if ((d1 == 0 && OnSegment(cx, cy, dx, dy, ax, ay)) ||
+      (d2 == 0 && OnSegment(cx, cy, dx, dy, bx, by)) ||
+      (d3 == 0 && OnSegment(ax, ay, bx, by, cx, cy)) ||
+      (d4 == 0 && OnSegment(ax, ay, bx, by, dx, dy))) {
+    return SegmentRelation::kTouches;
+  }
+  return SegmentRelation::kDisjoint;
+}
+
+template <typename Ring>
+inline void AppendRingEdges(const Ring& ring,
+                            std::vector<PreparedPolygon::Edge>* edges) {
+  for (std::size_t i = 1; i < ring.size(); ++i) {
+    edges->push_back(PreparedPolygon::Edge{
+        bg::get<0>(ring[i - 1]), bg::get<1>(ring[i - 1]), bg::get<0>(ring[i]),
+        bg::get<1>(ring[i]), 0});
+  }
+}
+
+}  // namespace detail
+
+inline PreparedPolygon::PreparedPolygon(const Polygon& polygon)
+    : polygon_(polygon),
+      strip_offsets_(2, 0),
+      xmin_(0.0),
+      ymin_(0.0),
+      xmax_(0.0),
+      ymax_(0.0),
+      strip_height_(1.0),
+      orientation_(1.0),
+      convex_(false),
+      empty_(polygon.obj_.outer().size() < 4) {
+  if (empty_) return;
+  const auto& outer = polygon_.obj_.outer();
+  detail::AppendRingEdges(outer, &edges_);
+  for (const auto& inner : polygon_.obj_.inners()) {
+    detail::AppendRingEdges(inner, &edges_);
+  }
+
+  xmin_ = ymin_ = std::numeric_limits<double>::max();
+  xmax_ = ymax_ = std::numeric_limits<double>::lowest();
+  for (const auto& pt : outer) {
+    xmin_ = std::min(xmin_, bg::get<0>(pt));
+    xmax_ = std::max(xmax_, bg::get<0>(pt));
+    ymin_ = std::min(ymin_, bg::get<1>(pt));
+    ymax_ = std::max(ymax_, bg::get<1>(pt));
+  }
+
+  // orientation from the signed area of the outer ring
+  double area = 0.0;
+  for (std::size_t i = 1; i < outer.size(); ++i) {
+    area += bg::get<0>(outer[i - 1]) * bg::get<1>(outer[i]) -
+            bg::get<0>(outer[i]) * bg::get<1>(outer[i - 1]);
+  }
+  orientation_ = area >= 0.0 ? 1.0 : -1.0;
+
+  // convex if all turns of the outer ring have the same sign
+  convex_ = polygon_.obj_.inners().empty();
+  const std::size_t num_outer = outer.size() - 1;
+  for (std::size_t i = 0; convex_ && i < num_outer; ++i) {
+    const auto& a = outer[i];
+    const auto& b = outer[(i + 1) % num_outer];
+    const auto& c = outer[(i + 2) % num_outer];
+    const double turn =
+        detail::Cross(bg::get<0>(a), bg::get<1>(a), bg::get<0>(b),
+                      bg::get<1>(b), bg::get<0>(c), bg::get<1>(c));
+    if (turn * orientation_ < 0.0) convex_ = false;
+  }
+
+  // bucket edges into strips of roughly four edges each
+  const std::size_t num_strips = std::max<std::size_t>(
+      1, std::min<std::size_t>(edges_.size() / 4, 4096));
+  strip_height_ = (ymax_ - ymin_) / num_strips;
+  if (strip_height_ <= 0.0) strip_height_ = 1.0;
+  strip_offsets_.assign(num_strips + 1, 0);
+  for (auto& edge : edges_) {
+    edge.first_strip = StripIndex(std::min(edge.y0, edge.y1));
+    const std::size_t last_strip = StripIndex(std::max(edge.y0, edge.y1));
+    for (std::size_t s = edge.first_strip; s <= last_strip; ++s) {
+      ++strip_offsets_[s + 1];
+    }
+  }
+  for (std::size_t s = 0; s < num_strips; ++s) {
+    strip_offsets_[s + 1] += strip_offsets_[s];
+  }
+  strip_edges_.resize(strip_offsets_.back());
+  std::vector<uint32_t> fill(strip_offsets_.begin(), strip_offsets_.end() - 1);
+  for (std::size_t e = 0; e < edges_.size(); ++e) {
+    const std::size_t last_strip =
+        StripIndex(std::max(edges_[e].y0, edges_[e].y1));
+    for (std::size_t s = edges_[e].first_strip; s <= last_strip; ++s) {
+      strip_edges_[fill[s]++] = static_cast<uint32_t>(e);
+    }
+  }
+}
+
+template <typename F>
+inline void PreparedPolygon::ForEachEdgeInBox(double xmin, double ymin,
+                                              double xmax, double ymax,
+                                              F f) const {
+  if (!BoundingBoxOverlaps(xmin, ymin, xmax, ymax)) return;
+  const std::size_t first = StripIndex(ymin);
+  const std::size_t last = StripIndex(ymax);
+  for (std::size_t s = first; s <= last; ++s) {
+    for (uint32_t i = strip_offsets_[s]; i < strip_offsets_[s + 1]; ++i) {
+      const Edge& edge = edges_[strip_edges_[i]];
+      // edges spanning several strips are only visited in the first one
+      if (edge.first_strip != s && s != first) continue;
+      if (std::max(edge.x0, edge.x1) < xmin ||
+          std::min(edge.x0, edge.x1) > xmax ||
+          std::max(edge.y0, edge.y1) < ymin ||
+          std::min(edge.y0, edge.y1) > ymax) {
+        continue;
+      }
+      if (!f(edge)) return;
+    }
+  }
+}
+
+inline bool PreparedPolygon::ContainsPoint(double x, double y,
+                                           bool* on_boundary) const {
+  *on_boundary = false;
+  if (!BoundingBoxOverlaps(x, y, x, y)) return false;
+  const std::size_t s = StripIndex(y);
+  bool inside = false;
+  for (uint32_t i = strip_offsets_[s]; i < strip_offsets_[s + 1]; ++i) {
+    const Edge& e = edges_[strip_edges_[i]];
+    if (detail::Cross(e.x0, e.y0, e.x1, e.y1, x, y) == 0.0 &&
+        detail::OnSegment(e.x0, e.y0, e.x1, e.y1, x, y)) {
+      *on_boundary = true;
+      return false;
+    }
+    // crossing number of a ray in positive x direction
+    if ((e.y0 > y) != (e.y1 > y) &&
+        x < e.x0 + (y - e.y0) * (e.x1 - e.x0) / (e.y1 - e.y0)) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+inline bool PreparedPolygon::ConvexCoversPoint(double x, double y) const {
+  for (const auto& e : edges_) {
+    if (detail::Cross(e.x0, e.y0, e.x1, e.y1, x, y) * orientation_ < 0.0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace detail {
+
+//! bounding box and edges of a query polygon
+struct QueryPolygon {
+  explicit QueryPolygon(const Polygon& poly)
+      : xmin(std::numeric_limits<double>::max()),
+        ymin(std::numeric_limits<double>::max()),
+        xmax(std::numeric_limits<double>::lowest()),
+        ymax(std::numeric_limits<double>::lowest()) {
+    AppendRingEdges(poly.obj_.outer(), &edges);
+    for (const auto& inner : poly.obj_.inners()) {
+      AppendRingEdges(inner, &edges);
+    }
+    for (const auto& pt : poly.obj_.outer()) {
+      xmin = std::min(xmin, bg::get<0>(pt));
+      xmax = std::max(xmax, bg::get<0>(pt));
+      ymin = std::min(ymin, bg::get<1>(pt));
+      ymax = std::max(ymax, bg::get<1>(pt));
+    }
+  }
+
+  SegmentRelation Relate(const PreparedPolygon::Edge& e) const {
+    SegmentRelation relation = SegmentRelation::kDisjoint;
+    for (const auto& q : edges) {
+      const SegmentRelation r =
+          RelateSegments(q.x0, q.y0, q.x1, q.y1, e.x0, e.y0, e.x1, e.y1);
+      if (r == SegmentRelation::kCrosses) return r;
+      if (r == SegmentRelation::kTouches) relation = r;
+    }
+    return relation;
+  }
+
+  double xmin, ymin, xmax, ymax;
+  std::vector<PreparedPolygon::Edge> edges;
+};
+
+//! relation of the boundary of a prepared polygon to a query polygon
+enum class BoundaryRelation { kDisjoint, kTouches, kCrosses, kInside };
+
+//! kCrosses if an edge properly crosses the query boundary, kTouches if an
+//! edge only touches it, kInside if an edge lies in the query interior, else
+//! kDisjoint
+inline BoundaryRelation RelateBoundary(const PreparedPolygon& prepared,
+                                       const Polygon& poly,
+                                       const QueryPolygon& query) {
+  BoundaryRelation relation = BoundaryRelation::kDisjoint;
+  prepared.ForEachEdgeInBox(
+      query.xmin, query.ymin, query.xmax, query.ymax,
+      [&](const PreparedPolygon::Edge& e) {
+        const SegmentRelation r = query.Relate(e);
+        if (r == SegmentRelation::kCrosses) {
+          relation = BoundaryRelation::kCrosses;
+          return false;
+        }
+        if (r == SegmentRelation::kTouches) {
+          // keep looking for a crossing, it decides the relation
+          relation = BoundaryRelation::kTouches;
+          return true;
+        }
+        if (relation == BoundaryRelation::kTouches) return true;
+        if (bg::covered_by(Point2d(e.x0, e.y0), poly.obj_)) {
+          relation = BoundaryRelation::kInside;
+          return false;
+        }
+        return true;
+      });
+  return relation;
+}
+
+}  // namespace detail
+
+//! Polygon within prepared polygon check, same result as boost::within
+inline bool Within(const Polygon& g1, const PreparedPolygon& g2) {
+  if (g1.obj_.outer().empty()) return false;
+  const detail::QueryPolygon query(g1);
+  if (!g2.BoundingBoxContains(query.xmin, query.ymin, query.xmax,
+                              query.ymax)) {
+    return false;
+  }
+  if (g2.IsConvex()) {
+    for (const auto& pt : g1.obj_.outer()) {
+      if (!g2.ConvexCoversPoint(bg::get<0>(pt), bg::get<1>(pt))) return false;
+    }
+    return true;
+  }
+  switch (detail::RelateBoundary(g2, g1, query)) {
+    case detail::BoundaryRelation::kTouches:
+      return bg::within(g1.obj_, g2.GetPolygon().obj_);
+    case detail::BoundaryRelation::kCrosses:
+    case detail::BoundaryRelation::kInside:
+      return false;
+    default:
+      break;
+  }
+  // boundaries are disjoint: g1 lies either inside or outside of g2
+  bool on_boundary;
+  const auto& pt = g1.obj_.outer().front();
+  return g2.ContainsPoint(bg::get<0>(pt), bg::get<1>(pt), &on_boundary);
+}
+
+//! Point2d within prepared polygon check, false on the boundary
+inline bool Within(const Point2d& p, const PreparedPolygon& poly) {
+  bool on_boundary;
+  return poly.ContainsPoint(bg::get<0>(p), bg::get<1>(p), &on_boundary);
+}
+
+//! Prepared polygon - Point collision checker, true on the boundary
+inline bool Collide(const PreparedPolygon& poly, const Point2d& p) {
+  bool on_boundary;
+  return poly.ContainsPoint(bg::get<0>(p), bg::get<1>(p), &on_boundary) ||
+         on_boundary;
+}
+
+inline bool Collide(const Point2d& p, const PreparedPolygon& poly) {
+  return Collide(poly, p);
+}
+
+//! Polygon - prepared polygon collision checker, same result as
+//! boost::intersects
+inline bool Collide(const Polygon& g1, const PreparedPolygon& g2) {
+  if (g1.obj_.outer().empty()) return false;
+  const detail::QueryPolygon query(g1);
+  if (!g2.BoundingBoxOverlaps(query.xmin, query.ymin, query.xmax,
+                              query.ymax)) {
+    return false;
+  }
+  if (detail::RelateBoundary(g2, g1, query) !=
+      detail::BoundaryRelation::kDisjoint) {
+    return true;
+  }
+  bool on_boundary;
+  const auto& pt = g1.obj_.outer().front();
+  return g2.ContainsPoint(bg::get<0>(pt), bg::get<1>(pt), &on_boundary);
+}
+
+inline bool Collide(const PreparedPolygon& g1, const Polygon& g2) {
+  return Collide(g2, g1);
+}
+
+}  // namespace geometry
+}  // namespace bark
+
+#endif  // BARK_GEOMETRY_PREPARED_POLYGON_HPP_
@@ -9,9 +9,13 @@
 #include "bark/geometry/commons.hpp"
 #include "bark/geometry/line.hpp"
 #include "bark/geometry/polygon.hpp"
+#include "bark/geometry/prepared_polygon.hpp"
 #include "bark/geometry/standard_shapes.hpp"
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <random>
+
 TEST(polygon, base_functionality) {
   using bark::geometry::Point2d;
   using bark::geometry::Point2d_t;
@@ -179,6 +183,60 @@ TEST(geometry, polygon) {
       std::dynamic_pointer_cast<Polygon>(p.Rotate(3.14 / 2));
 }
 
+TEST(geometry, polygon_transform_in_place) {
+  using bark::geometry::Point2d;
+  using bark::geometry::Polygon;
+  using bark::geometry::Pose;
+  using bark::geometry::standard_shapes::CarLimousine;
+  namespace trans = boost::geometry::strategy::transform;
+
+  const Polygon outline = CarLimousine();
+  const Pose pose(10.0, -3.0, 0.7);
+
+  // reference: translate to the center, scale, rotate and translate back
+  const double scale = 1.5;
+  trans::translate_transformer<double, 2, 2> to_center(-outline.center_[0],
+                                                       -outline.center_[1]);
+  trans::scale_transformer<double, 2, 2> scaling(scale);
+  trans::rotate_transformer<boost::geometry::radian, double, 2, 2> rotate(
+      -pose[2]);
+  trans::translate_transformer<double, 2, 2> back(
+      outline.center_[0] + pose[0], outline.center_[1] + pose[1]);
+  boost::geometry::model::polygon<Point2d> centered, scaled, rotated, expected;
+  boost::geometry::transform(outline.obj_, centered, to_center);
+  boost::geometry::transform(centered, scaled, scaling);
+  boost::geometry::transform(scaled, rotated, rotate);
+  boost::geometry::transform(rotated, expected, back);
+
+  // single pass with one rotation equals the chain of boost transforms
+  Polygon transformed;
+  outline.ScalingTransform(scale, pose, &transformed);
+  ASSERT_EQ(transformed.obj_.outer().size(), expected.outer().size());
+  for (std::size_t i = 0; i < expected.outer().size(); ++i) {
+    EXPECT_NEAR(boost::geometry::get<0>(transformed.obj_.outer()[i]),
+                boost::geometry::get<0>(expected.outer()[i]), 1e-12);
+    EXPECT_NEAR(boost::geometry::get<1>(transformed.obj_.outer()[i]),
+                boost::geometry::get<1>(expected.outer()[i]), 1e-12);
+  }
+  EXPECT_NEAR(transformed.center_[2], outline.center_[2] + pose[2], 1e-12);
+
+  Polygon in_place = outline;
+  in_place.TransformInPlace(pose);
+  auto shared = std::dynamic_pointer_cast<Polygon>(outline.Transform(pose));
+  EXPECT_TRUE(Equals(in_place, *shared));
+  EXPECT_EQ(shared->front_dist_, outline.front_dist_);
+
+  in_place = outline;
+  in_place.RotateInPlace(pose[2]);
+  in_place.TranslateInPlace(Point2d(pose[0], pose[1]));
+  for (std::size_t i = 0; i < shared->obj_.outer().size(); ++i) {
+    EXPECT_NEAR(boost::geometry::get<0>(in_place.obj_.outer()[i]),
+                boost::geometry::get<0>(shared->obj_.outer()[i]), 1e-12);
+    EXPECT_NEAR(boost::geometry::get<1>(in_place.obj_.outer()[i]),
+                boost::geometry::get<1>(shared->obj_.outer()[i]), 1e-12);
+  }
+}
+
 TEST(geometry, polygon_from_two_lines) {
   using bark::geometry::Point2d;
   using bark::geometry::Polygon;
@@ -926,6 +984,249 @@ TEST(line, curvature) {
   EXPECT_NEAR(c(4), c_expect(4), precision);
 }
 
+// tangent angle as computed before the derivatives were cached
+static double TangentAngleReference(const bark::geometry::Line& l, double s) {
+  namespace bg = boost::geometry;
+  auto angle = [&](int i) {
+    return atan2(bg::get<1>(l.obj_.at(i + 1)) - bg::get<1>(l.obj_.at(i)),
+                 bg::get<0>(l.obj_.at(i + 1)) - bg::get<0>(l.obj_.at(i)));
+  };
+  if (s >= l.s_.back()) {
+    return angle(l.obj_.size() - 2);
+  } else if (s <= 0.0) {
+    return angle(0);
+  }
+  int end = bark::geometry::GetSegmentEndIdx(l, s);
+  if (bark::geometry::CheckSForSegmentIntersection(l, s)) {
+    double a1 = angle(end - 2), a2 = angle(end - 1);
+    return atan2(0.5 * (sin(a1) + sin(a2)), 0.5 * (cos(a1) + cos(a2)));
+  }
+  return angle(end - 1);
+}
+
+static bark::geometry::Line MakeSineLine(int num_points) {
+  bark::geometry::Line line;
+  for (int i = 0; i < num_points; ++i) {
+    line.AddPoint(bark::geometry::Point2d(0.5 * i, 5.0 * std::sin(0.05 * i)));
+  }
+  return line;
+}
+
+TEST(line, cached_derivatives) {
+  using bark::geometry::GetCurvature;
+  using bark::geometry::GetCurvatureAtS;
+  using bark::geometry::GetNormalAtS;
+  using bark::geometry::GetTangentAngleAtS;
+  using bark::geometry::GetTangentAtS;
+  using bark::geometry::Line;
+  using bark::geometry::Point2d;
+  using bark::geometry::Pose;
+  namespace bg = boost::geometry;
+
+  Line line = MakeSineLine(50);
+  std::vector<double> queries = {-1.0, 0.0, line.s_.back(),
+                                 line.s_.back() + 1.0};
+  for (std::size_t i = 1; i + 1 < line.s_.size(); ++i) {
+    // at the vertices and within the segments
+    queries.push_back(line.s_[i]);
+    queries.push_back(0.5 * (line.s_[i] + line.s_[i + 1]));
+  }
+  for (double s : queries) {
+    double angle = TangentAngleReference(line, s);
+    EXPECT_NEAR(GetTangentAngleAtS(line, s), angle, 1e-12);
+    Point2d tangent = GetTangentAtS(line, s);
+    EXPECT_NEAR(bg::get<0>(tangent), cos(angle), 1e-12);
+    EXPECT_NEAR(bg::get<1>(tangent), sin(angle), 1e-12);
+    Point2d normal = GetNormalAtS(line, s);
+    EXPECT_NEAR(bg::get<0>(normal), cos(angle + M_PI / 2.0), 1e-12);
+    EXPECT_NEAR(bg::get<1>(normal), sin(angle + M_PI / 2.0), 1e-12);
+  }
+
+  Eigen::VectorXd curvature = GetCurvature(line);
+  Eigen::VectorXd curvature_expected = bark::geometry::ComputeCurvature(
+      line.ToArray().col(0), line.ToArray().col(1));
+  EXPECT_TRUE(curvature.isApprox(curvature_expected));
+  EXPECT_NEAR(GetCurvatureAtS(line, line.s_[3]), curvature(3), 1e-12);
+  EXPECT_NEAR(GetCurvatureAtS(line, 0.5 * (line.s_[3] + line.s_[4])),
+              0.5 * (curvature(3) + curvature(4)), 1e-12);
+  EXPECT_NEAR(GetCurvatureAtS(line, -1.0), curvature(0), 1e-12);
+
+  // copies share the derivatives, modifications of the line update them
+  Line copy = line;
+  copy.AddPoint(Point2d(25.0, 100.0));
+  EXPECT_NEAR(GetTangentAngleAtS(copy, copy.s_.back()),
+              TangentAngleReference(copy, copy.s_.back()), 1e-12);
+  EXPECT_NEAR(GetTangentAngleAtS(line, line.s_.back()),
+              TangentAngleReference(line, line.s_.back()), 1e-12);
+  EXPECT_EQ(GetCurvature(copy).size(), line.size() + 1);
+
+  copy.Reverse();
+  EXPECT_NEAR(GetTangentAngleAtS(copy, 0.0), TangentAngleReference(copy, 0.0),
+              1e-12);
+
+  auto rotated =
+      std::dynamic_pointer_cast<Line>(line.Transform(Pose(1.0, 2.0, 0.5)));
+  EXPECT_NEAR(GetTangentAngleAtS(*rotated, 0.0),
+              GetTangentAngleAtS(line, 0.0) + 0.5, 1e-12);
+
+  // lines with less than three points have no curvature
+  Line short_line;
+  short_line.AddPoint(Point2d(0.0, 0.0));
+  short_line.AddPoint(Point2d(1.0, 1.0));
+  EXPECT_NEAR(GetTangentAngleAtS(short_line, 0.5), M_PI / 4.0, 1e-12);
+  EXPECT_NEAR(GetCurvatureAtS(short_line, 0.5), 0.0, 1e-12);
+}
+
+TEST(line, tangent_benchmark) {
+  using bark::geometry::GetCurvature;
+  using bark::geometry::GetNormalAtS;
+  using bark::geometry::GetTangentAngleAtS;
+  using bark::geometry::Line;
+  namespace bg = boost::geometry;
+
+  const Line line = MakeSineLine(1000);
+  const int num_queries = 10000;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(0.0, line.s_.back());
+  std::vector<double> queries;
+  for (int i = 0; i < num_queries; ++i) {
+    queries.push_back(dist(gen));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  double sum_reference = 0.0;
+  for (double s : queries) {
+    // GetNormalAtS computed the tangent angle a second time
+    sum_reference += TangentAngleReference(line, s) +
+                     sin(TangentAngleReference(line, s) + asin(1));
+  }
+  const double reference_time = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  double sum = 0.0;
+  for (double s : queries) {
+    sum += GetTangentAngleAtS(line, s) + bg::get<1>(GetNormalAtS(line, s));
+  }
+  const double cached_time = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  double curvature_sum = 0.0;
+  for (int i = 0; i < 100; ++i) {
+    curvature_sum += GetCurvature(line)(i);
+  }
+  const double curvature_time = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  std::cout << num_queries << " tangent and normal queries on " << line.size()
+            << " points: uncached " << reference_time * 1e6 << " us, cached "
+            << cached_time * 1e6 << " us; 100 x GetCurvature "
+            << curvature_time * 1e6 << " us" << std::endl;
+  EXPECT_NEAR(sum, sum_reference, 1e-9 * num_queries);
+  EXPECT_TRUE(std::isfinite(curvature_sum));
+}
+
+TEST(line, shifted_laterally_and_s_interval) {
+  using bark::geometry::GetLineFromSInterval;
+  using bark::geometry::GetLineShiftedLaterally;
+  using bark::geometry::GetNormalAtS;
+  using bark::geometry::GetPointAtS;
+  using bark::geometry::Line;
+  using bark::geometry::Point2d;
+  using bark::geometry::operator+;
+  using bark::geometry::operator*;
+  namespace bg = boost::geometry;
+
+  Line line = MakeSineLine(100);
+  // a duplicate point gives a zero-length segment
+  line.AddPoint(line.obj_.back());
+  line.AddPoint(Point2d(52.0, 0.0));
+
+  Line shifted = GetLineShiftedLaterally(line, 1.5);
+  ASSERT_EQ(shifted.size(), line.size());
+  ASSERT_EQ(shifted.s_.size(), line.size());
+  for (std::size_t i = 0; i < line.s_.size(); ++i) {
+    const double s = line.s_[i];
+    const Point2d expected =
+        GetPointAtS(line, s) + GetNormalAtS(line, s) * 1.5;
+    EXPECT_NEAR(bg::get<0>(shifted.obj_[i]), bg::get<0>(expected), 1e-12);
+    EXPECT_NEAR(bg::get<1>(shifted.obj_[i]), bg::get<1>(expected), 1e-12);
+  }
+  Line expected_s = shifted;
+  expected_s.RecomputeS();
+  EXPECT_EQ(shifted.s_, expected_s.s_);
+
+  const double begin = 0.5 * (line.s_[10] + line.s_[11]), end = line.s_[40];
+  Line interval = GetLineFromSInterval(line, begin, end);
+  ASSERT_EQ(interval.size(), 31u);
+  EXPECT_TRUE(bg::equals(interval.obj_.front(), GetPointAtS(line, begin)));
+  EXPECT_TRUE(bg::equals(interval.obj_.back(), line.obj_[40]));
+  for (std::size_t i = 1; i + 1 < interval.size(); ++i) {
+    EXPECT_TRUE(bg::equals(interval.obj_[i], line.obj_[10 + i]));
+  }
+  EXPECT_NEAR(interval.Length(), end - begin, 1e-9);
+  EXPECT_NEAR(interval.s_.back(), end - begin, 1e-9);
+
+  // points added one by one get the same s as after a full recomputation
+  Line built;
+  for (const auto& point : line.obj_) {
+    built.AddPoint(point);
+  }
+  EXPECT_EQ(built.s_, line.s_);
+  EXPECT_EQ(GetLineShiftedLaterally(Line(), 1.0).size(), 0u);
+}
+
+TEST(line, polyline_benchmark) {
+  using bark::geometry::GetLineFromSInterval;
+  using bark::geometry::GetLineShiftedLaterally;
+  using bark::geometry::GetNearestS;
+  using bark::geometry::Line;
+  using bark::geometry::Point2d;
+
+  for (int num_points : {100, 1000, 5000}) {
+    auto start = std::chrono::steady_clock::now();
+    Line line = MakeSineLine(num_points);
+    const double build_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    Line shifted = GetLineShiftedLaterally(line, 1.75);
+    const double shift_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(0.0, line.s_.back());
+    start = std::chrono::steady_clock::now();
+    double length = 0.0;
+    for (int i = 0; i < 100; ++i) {
+      double begin = dist(gen), end = dist(gen);
+      length += GetLineFromSInterval(line, std::min(begin, end),
+                                     std::max(begin, end))
+                    .Length();
+    }
+    const double interval_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    double s_sum = 0.0;
+    for (int i = 0; i < 100; ++i) {
+      s_sum += GetNearestS(line, Point2d(0.5 * dist(gen), 1.0));
+    }
+    const double nearest_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << num_points << " points: AddPoint " << build_time * 1e6
+              << " us, GetLineShiftedLaterally " << shift_time * 1e6
+              << " us, 100 x GetLineFromSInterval " << interval_time * 1e6
+              << " us, 100 x GetNearestS " << nearest_time * 1e6 << " us"
+              << std::endl;
+    EXPECT_EQ(shifted.size(), line.size());
+    EXPECT_GT(length, 0.0);
+    EXPECT_GT(s_sum, 0.0);
+  }
+}
+
 TEST(optimizer, shrink_polygon) {
   using bark::geometry::Point2d;
   using bark::geometry::Polygon;
@@ -1243,6 +1544,111 @@ TEST(boundingpolygon, vehicleshapes) {
   EXPECT_TRUE(Within(in2, out2));
 }
 
+TEST(prepared_polygon, touching_and_convex) {
+  using bark::geometry::Collide;
+  using bark::geometry::Point2d;
+  using bark::geometry::Polygon;
+  using bark::geometry::Pose;
+  using bark::geometry::PreparedPolygon;
+  using bark::geometry::Within;
+
+  Polygon square(Pose(0, 0, 0),
+                 std::vector<Point2d>{Point2d(0, 0), Point2d(0, 10),
+                                      Point2d(10, 10), Point2d(10, 0),
+                                      Point2d(0, 0)});
+  PreparedPolygon prepared(square);
+  EXPECT_TRUE(prepared.IsConvex());
+
+  Polygon inner(Pose(0, 0, 0),
+                std::vector<Point2d>{Point2d(0, 0), Point2d(0, 2),
+                                     Point2d(2, 2), Point2d(2, 0),
+                                     Point2d(0, 0)});
+  Polygon outside(Pose(0, 0, 0),
+                  std::vector<Point2d>{Point2d(10, 0), Point2d(10, 2),
+                                       Point2d(12, 2), Point2d(12, 0),
+                                       Point2d(10, 0)});
+  EXPECT_TRUE(Within(inner, prepared));
+  EXPECT_FALSE(Within(outside, prepared));
+  EXPECT_TRUE(Collide(outside, prepared));
+  EXPECT_FALSE(Within(Point2d(0, 5), prepared));
+  EXPECT_TRUE(Collide(prepared, Point2d(0, 5)));
+  EXPECT_FALSE(Collide(prepared, Point2d(-1, 5)));
+
+  // non-convex U shape; the query bridges the gap between both legs
+  Polygon u_shape(Pose(0, 0, 0),
+                  std::vector<Point2d>{Point2d(0, 0), Point2d(0, 10),
+                                       Point2d(3, 10), Point2d(3, 3),
+                                       Point2d(7, 3), Point2d(7, 10),
+                                       Point2d(10, 10), Point2d(10, 0),
+                                       Point2d(0, 0)});
+  PreparedPolygon prepared_u(u_shape);
+  EXPECT_FALSE(prepared_u.IsConvex());
+  Polygon bridge(Pose(0, 0, 0),
+                 std::vector<Point2d>{Point2d(1, 8), Point2d(1, 9),
+                                      Point2d(9, 9), Point2d(9, 8),
+                                      Point2d(1, 8)});
+  Polygon gap(Pose(0, 0, 0),
+              std::vector<Point2d>{Point2d(4, 5), Point2d(4, 6), Point2d(6, 6),
+                                   Point2d(6, 5), Point2d(4, 5)});
+  EXPECT_FALSE(Within(bridge, prepared_u));
+  EXPECT_TRUE(Collide(bridge, prepared_u));
+  EXPECT_FALSE(Within(gap, prepared_u));
+  EXPECT_FALSE(Collide(gap, prepared_u));
+  EXPECT_TRUE(Within(inner, prepared_u));
+
+  // empty polygon
+  PreparedPolygon empty;
+  EXPECT_FALSE(Within(inner, empty));
+  EXPECT_FALSE(Collide(inner, empty));
+}
+
+TEST(prepared_polygon, matches_boost) {
+  using bark::geometry::Collide;
+  using bark::geometry::Point2d;
+  using bark::geometry::Polygon;
+  using bark::geometry::Pose;
+  using bark::geometry::PreparedPolygon;
+  using bark::geometry::Within;
+  namespace bg = boost::geometry;
+
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (int num_points : {4, 50, 2000}) {
+    // star-shaped polygon with a ragged boundary
+    std::vector<Point2d> points;
+    for (int i = 0; i < num_points; ++i) {
+      double angle = 2.0 * M_PI * i / num_points;
+      double radius = 10.0 + 3.0 * std::sin(7.0 * angle) + dist(gen);
+      points.push_back(
+          Point2d(radius * std::cos(angle), radius * std::sin(angle)));
+    }
+    points.push_back(points.front());
+    Polygon road(Pose(0, 0, 0), points);
+    PreparedPolygon prepared(road);
+
+    for (int i = 0; i < 2000; ++i) {
+      double x = 15.0 * dist(gen), y = 15.0 * dist(gen);
+      double theta = 3.0 * dist(gen), half = 3.0 * std::abs(dist(gen)) + 0.1;
+      double c = std::cos(theta), s = std::sin(theta);
+      std::vector<Point2d> corners;
+      for (auto corner : {std::make_pair(-1.0, -0.5), std::make_pair(-1.0, 0.5),
+                          std::make_pair(1.0, 0.5), std::make_pair(1.0, -0.5),
+                          std::make_pair(-1.0, -0.5)}) {
+        double cx = half * corner.first, cy = half * corner.second;
+        corners.push_back(Point2d(x + c * cx - s * cy, y + s * cx + c * cy));
+      }
+      Polygon query(Pose(x, y, 0), corners);
+      EXPECT_EQ(Within(query, prepared), bg::within(query.obj_, road.obj_));
+      EXPECT_EQ(Collide(query, prepared),
+                bg::intersects(query.obj_, road.obj_));
+      EXPECT_EQ(Within(Point2d(x, y), prepared),
+                bg::within(Point2d(x, y), road.obj_));
+      EXPECT_EQ(Collide(prepared, Point2d(x, y)),
+                bg::covered_by(Point2d(x, y), road.obj_));
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,62 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_BEHAVIOR_BATCH_POLICY_HPP_
+#define BARK_MODELS_BEHAVIOR_BATCH_POLICY_HPP_
+
+#include <Eigen/Dense>
+#include <memory>
+
+namespace bark {
+namespace world {
+class ObservedWorld;
+}  // namespace world
+namespace models {
+namespace behavior {
+
+/**
+ * @brief Policy that computes the actions of several agents at once
+ *
+ * Receives one observation per row and returns one action per row in the
+ * same order. Learned policies implemented in Python are thus called once
+ * per world step instead of once per agent.
+ */
+class BatchPolicy {
+ public:
+  virtual ~BatchPolicy() {}
+
+  virtual Eigen::MatrixXd Act(const Eigen::MatrixXd& observations) = 0;
+};
+
+typedef std::shared_ptr<BatchPolicy> BatchPolicyPtr;
+
+/**
+ * @brief Interface of behavior models that are driven by a BatchPolicy
+ *
+ * World::PlanAgents stacks the observations of all agents sharing the same
+ * policy, calls the policy once and scatters the action rows back using
+ * SetBatchAction before planning the agents.
+ */
+class BatchPolicyBehavior {
+ public:
+  virtual ~BatchPolicyBehavior() {}
+
+  virtual BatchPolicyPtr GetBatchPolicy() const = 0;
+
+  virtual Eigen::VectorXd Observe(
+      const world::ObservedWorld& observed_world) const = 0;
+
+  //! action used by the next call to Plan
+  virtual void SetBatchAction(const Eigen::VectorXd& action) = 0;
+};
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
+
+#endif  // BARK_MODELS_BEHAVIOR_BATCH_POLICY_HPP_
@@ -0,0 +1,88 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/behavior/batch_policy/behavior_batch_policy.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "bark/world/observed_world.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+using dynamic::StateDefinition::THETA_POSITION;
+using dynamic::StateDefinition::VEL_POSITION;
+using dynamic::StateDefinition::X_POSITION;
+using dynamic::StateDefinition::Y_POSITION;
+
+BehaviorBatchPolicy::BehaviorBatchPolicy(const commons::ParamsPtr& params,
+                                         const BatchPolicyPtr& policy)
+    : BehaviorDynamicModel(params),
+      policy_(policy),
+      num_nearest_agents_(params->GetInt(
+          "BehaviorBatchPolicy::NumNearestAgents",
+          "Number of other agents contained in the observation", 4)),
+      has_batch_action_(false) {}
+
+Eigen::VectorXd BehaviorBatchPolicy::Observe(
+    const ObservedWorld& observed_world) const {
+  const State ego_state = observed_world.CurrentEgoState();
+  Eigen::VectorXd observation =
+      Eigen::VectorXd::Zero(4 * (num_nearest_agents_ + 1));
+  observation.head<4>() << ego_state(X_POSITION), ego_state(Y_POSITION),
+      ego_state(THETA_POSITION), ego_state(VEL_POSITION);
+
+  // GetNearestAgents returns the agents ordered by id
+  std::vector<std::pair<double, State>> others;
+  for (const auto& agent : observed_world.GetNearestAgents(
+           observed_world.CurrentEgoPosition(), num_nearest_agents_ + 1)) {
+    if (agent.first == observed_world.GetEgoAgentId()) continue;
+    const State& state = agent.second->GetCurrentState();
+    const double dx = state(X_POSITION) - ego_state(X_POSITION);
+    const double dy = state(Y_POSITION) - ego_state(Y_POSITION);
+    others.push_back(std::make_pair(dx * dx + dy * dy, state));
+  }
+  std::sort(others.begin(), others.end(),
+            [](const std::pair<double, State>& a,
+               const std::pair<double, State>& b) {
+              return a.first < b.first;
+            });
+
+  const std::size_t num_others =
+      std::min<std::size_t>(others.size(), num_nearest_agents_);
+  for (std::size_t i = 0; i < num_others; ++i) {
+    const State& state = others[i].second;
+    observation.segment<4>(4 * (i + 1))
+        << state(X_POSITION) - ego_state(X_POSITION),
+        state(Y_POSITION) - ego_state(Y_POSITION), state(THETA_POSITION),
+        state(VEL_POSITION);
+  }
+  return observation;
+}
+
+void BehaviorBatchPolicy::SetBatchAction(const Eigen::VectorXd& action) {
+  BehaviorDynamicModel::ActionToBehavior(Input(action));
+  has_batch_action_ = true;
+}
+
+Trajectory BehaviorBatchPolicy::Plan(double delta_time,
+                                     const ObservedWorld& observed_world) {
+  // planned outside of World::PlanAgents, e.g. during a prediction
+  if (!has_batch_action_) {
+    const Eigen::MatrixXd actions =
+        policy_->Act(Observe(observed_world).transpose());
+    BehaviorDynamicModel::ActionToBehavior(Input(actions.row(0).transpose()));
+  }
+  has_batch_action_ = false;
+  return BehaviorDynamicModel::Plan(delta_time, observed_world);
+}
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
@@ -0,0 +1,66 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_BEHAVIOR_BATCH_POLICY_BEHAVIOR_BATCH_POLICY_HPP_
+#define BARK_MODELS_BEHAVIOR_BATCH_POLICY_BEHAVIOR_BATCH_POLICY_HPP_
+
+#include <memory>
+
+#include "bark/models/behavior/batch_policy.hpp"
+#include "bark/models/behavior/dynamic_model/dynamic_model.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+/**
+ * @brief Applies the input computed by a shared BatchPolicy to the
+ * single track model of the agent
+ *
+ * The default observation contains x, y, theta and v of the ego agent
+ * followed by the position relative to the ego agent, theta and v of the
+ * nearest other agents, zero-padded to a fixed size.
+ */
+class BehaviorBatchPolicy : public BehaviorDynamicModel,
+                            public BatchPolicyBehavior {
+ public:
+  BehaviorBatchPolicy(const commons::ParamsPtr& params,
+                      const BatchPolicyPtr& policy);
+
+  virtual ~BehaviorBatchPolicy() {}
+
+  virtual Trajectory Plan(double delta_time,
+                          const ObservedWorld& observed_world);
+
+  virtual std::shared_ptr<BehaviorModel> Clone() const;
+
+  virtual BatchPolicyPtr GetBatchPolicy() const { return policy_; }
+
+  virtual Eigen::VectorXd Observe(const ObservedWorld& observed_world) const;
+
+  virtual void SetBatchAction(const Eigen::VectorXd& action);
+
+  unsigned int GetNumNearestAgents() const { return num_nearest_agents_; }
+
+ private:
+  BatchPolicyPtr policy_;
+  unsigned int num_nearest_agents_;
+  bool has_batch_action_;
+};
+
+inline std::shared_ptr<BehaviorModel> BehaviorBatchPolicy::Clone() const {
+  std::shared_ptr<BehaviorBatchPolicy> model_ptr =
+      std::make_shared<BehaviorBatchPolicy>(*this);
+  return model_ptr;
+}
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
+
+#endif  // BARK_MODELS_BEHAVIOR_BATCH_POLICY_BEHAVIOR_BATCH_POLICY_HPP_
@@ -107,7 +107,9 @@ class BehaviorModel : public bark::commons::BaseType {
 
   virtual ~BehaviorModel() {}
 
-  dynamic::Trajectory GetLastTrajectory() const { return last_trajectory_; }
+  const dynamic::Trajectory& GetLastTrajectory() const {
+    return last_trajectory_;
+  }
 
   void SetLastTrajectory(const dynamic::Trajectory& trajectory) {
     last_trajectory_ = trajectory;
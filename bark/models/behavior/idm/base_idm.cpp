@@ -124,8 +124,8 @@ double BaseIDM::CalcNetDistance(
 
   // we need to use the lane corridor of the ego agent to be able to compare the
   // frenet values
-  FrenetPosition frenet_leading(leading_agent->GetCurrentPosition(),
-                                local_lane_corr->GetCenterLine());
+  FrenetPosition frenet_leading =
+      leading_agent->CurrentFrenetState(local_lane_corr->GetCenterLine());
 
   const double vehicle_length =
       ego_agent->GetShape().front_dist_ + leading_agent->GetShape().rear_dist_;
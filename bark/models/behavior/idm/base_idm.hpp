@@ -122,6 +122,9 @@ class BaseIDM : virtual public BehaviorModel {
     acceleration_limits_ = acc_lim; 
   }
 
+  LaneCorridorPtr GetConstantLaneCorridor() const {
+    return constant_lane_corr_;
+  }
   void SetConstantLaneCorridor(const LaneCorridorPtr& lc) {
     constant_lane_corr_ = lc;
   }
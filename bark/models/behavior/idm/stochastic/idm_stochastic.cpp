@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "bark/models/behavior/idm/stochastic/idm_stochastic.hpp"
+#include <algorithm>
 
 namespace bark {
 namespace models {
@@ -40,16 +41,76 @@ BehaviorIDMStochastic::BehaviorIDMStochastic(const commons::ParamsPtr& params)
           "BehaviorIDMStochastic::CoolnessFactorDistribution",
           "From what distribution is the comfortable braking sampled in each "
           "planning steo",
-          "UniformDistribution1D")) {}
+          "UniformDistribution1D")),
+      sample_batch_size_(std::max(
+          params->GetInt("BehaviorIDMStochastic::SampleBatchSize",
+                         "Number of parameter sets drawn at once from each "
+                         "distribution, larger batches draw ahead of the "
+                         "planning steps",
+                         1),
+          1)),
+      sample_once_per_episode_(params->GetBool(
+          "BehaviorIDMStochastic::SampleOncePerEpisode",
+          "If true, parameters are sampled in the first planning step only",
+          false)),
+      sample_buffer_(),
+      sample_buffer_index_(0),
+      parameters_sampled_(false),
+      counter_based_random_streams_(params->GetBool(
+          "BehaviorIDMStochastic::CounterBasedRandomStreams",
+          "If true, parameters are drawn from random streams keyed by world "
+          "time and agent id, which is reproducible in parallel simulations",
+          false)) {}
+
+void BehaviorIDMStochastic::RefillSampleBuffer() {
+  // stored parameter-major, parameter p of set i is at p * batch + i
+  sample_buffer_.resize(kNumSampledParameters * sample_batch_size_);
+  const bark::commons::DistributionPtr dists[kNumSampledParameters] = {
+      param_dist_headway_,       param_dist_spacing_,
+      param_dist_max_acc_,       param_dist_desired_vel_,
+      param_dist_comft_braking_, param_dist_coolness_factor_};
+  for (int p = 0; p < kNumSampledParameters; ++p) {
+    BARK_EXPECT_TRUE(dists[p]->GetDimension() == 1);
+    dists[p]->SampleN(sample_batch_size_,
+                      sample_buffer_.data() + p * sample_batch_size_);
+  }
+  sample_buffer_index_ = 0;
+}
+
+void BehaviorIDMStochastic::SetSampledParameters(
+    const commons::RandomVariableValueType* values, std::size_t stride) {
+  param_desired_time_head_way_ = values[0];
+  param_minimum_spacing_ = values[stride];
+  param_max_acceleration_ = values[2 * stride];
+  param_desired_velocity_ = values[3 * stride];
+  param_comfortable_braking_acceleration_ = values[4 * stride];
+  param_coolness_factor_ = values[5 * stride];
+  parameters_sampled_ = true;
+}
 
 void BehaviorIDMStochastic::SampleParameters() {
-  param_desired_time_head_way_ = param_dist_headway_->Sample()[0];
-  param_minimum_spacing_ = param_dist_spacing_->Sample()[0];
-  param_max_acceleration_ = param_dist_max_acc_->Sample()[0];
-  param_desired_velocity_ = param_dist_desired_vel_->Sample()[0];
-  param_comfortable_braking_acceleration_ =
-      param_dist_comft_braking_->Sample()[0];
-  param_coolness_factor_ = param_dist_coolness_factor_->Sample()[0];
+  if (sample_buffer_.empty() || sample_buffer_index_ >= sample_batch_size_) {
+    RefillSampleBuffer();
+  }
+  SetSampledParameters(sample_buffer_.data() + sample_buffer_index_,
+                       sample_batch_size_);
+  ++sample_buffer_index_;
+}
+
+void BehaviorIDMStochastic::SampleParameters(
+    const commons::RandomStreamKey& key) {
+  const bark::commons::DistributionPtr dists[kNumSampledParameters] = {
+      param_dist_headway_,       param_dist_spacing_,
+      param_dist_max_acc_,       param_dist_desired_vel_,
+      param_dist_comft_braking_, param_dist_coolness_factor_};
+  commons::RandomVariableValueType values[kNumSampledParameters];
+  for (int p = 0; p < kNumSampledParameters; ++p) {
+    commons::RandomStreamKey parameter_key = key;
+    parameter_key.purpose =
+        commons::RandomStreamPurpose("BehaviorIDMStochastic", p);
+    values[p] = dists[p]->Sample(parameter_key)[0];
+  }
+  SetSampledParameters(values, 1);
 }
 
 ParameterRegions BehaviorIDMStochastic::GetParameterRegions() const {
@@ -71,7 +132,15 @@ ParameterRegions BehaviorIDMStochastic::GetParameterRegions() const {
 
 Trajectory BehaviorIDMStochastic::Plan(double delta_time,
                                        const ObservedWorld& observed_world) {
-  SampleParameters();
+  if (!(sample_once_per_episode_ && parameters_sampled_)) {
+    if (counter_based_random_streams_) {
+      SampleParameters(commons::RandomStreamKey{
+          commons::WorldTimeToTimeStep(observed_world.GetWorldTime()),
+          observed_world.GetEgoAgentId(), 0});
+    } else {
+      SampleParameters();
+    }
+  }
   return BehaviorIDMClassic::Plan(delta_time, observed_world);
 }
 
@@ -7,6 +7,8 @@
 #ifndef BARK_MODELS_BEHAVIOR_IDM_STOCHASTIC_HPP_
 #define BARK_MODELS_BEHAVIOR_IDM_STOCHASTIC_HPP_
 
+#include <vector>
+
 #include "bark/commons/distribution/distributions_1d.hpp"
 #include "bark/models/behavior/idm/idm_classic.hpp"
 
@@ -32,17 +34,35 @@ class BehaviorIDMStochastic : public BehaviorIDMClassic {
   ParameterRegions GetParameterRegions() const;
 
  protected:
+  static const int kNumSampledParameters = 6;
+
+  void SetSampledParameters(const commons::RandomVariableValueType* values,
+                            std::size_t stride);
+  void RefillSampleBuffer();
+  void SampleParameters(const commons::RandomStreamKey& key);
+
   bark::commons::DistributionPtr param_dist_headway_;
   bark::commons::DistributionPtr param_dist_spacing_;
   bark::commons::DistributionPtr param_dist_max_acc_;
   bark::commons::DistributionPtr param_dist_desired_vel_;
   bark::commons::DistributionPtr param_dist_comft_braking_;
   bark::commons::DistributionPtr param_dist_coolness_factor_;
+
+  // parameter sets drawn in advance, one SampleN call per distribution
+  int sample_batch_size_;
+  bool sample_once_per_episode_;
+  std::vector<commons::RandomVariableValueType> sample_buffer_;
+  int sample_buffer_index_;
+  bool parameters_sampled_;
+  bool counter_based_random_streams_;
 };
 
 inline std::shared_ptr<BehaviorModel> BehaviorIDMStochastic::Clone() const {
   std::shared_ptr<BehaviorIDMStochastic> model_ptr =
       std::make_shared<BehaviorIDMStochastic>(*this);
+  // the clone draws its own parameter sets instead of replaying ours
+  model_ptr->sample_buffer_.clear();
+  model_ptr->sample_buffer_index_ = 0;
   return model_ptr;
 }
 
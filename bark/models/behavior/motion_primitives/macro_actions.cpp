@@ -7,6 +7,8 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "bark/models/behavior/motion_primitives/macro_actions.hpp"
+#include <algorithm>
+#include <numeric>
 #include "bark/models/dynamic/integration.hpp"
 #include "bark/world/observed_world.hpp"
 
@@ -120,11 +122,53 @@ BehaviorMPMacroActions::GetValidPrimitives(
   GetNumMotionPrimitives(observed_world);
   return valid_primitives_;
 }
+std::vector<DiscreteAction> BehaviorMPMacroActions::GetValidActions(
+    const ObservedWorldPtr& observed_world) {
+  const AdjacentLaneCorridors adjacent_corridors =
+      GetCorridors(*observed_world);
+  std::vector<MotionIdx> valid_primitives;
+  for (MotionIdx i = 0; i < motion_primitives_.size(); ++i) {
+    if (motion_primitives_.at(i)->IsPreConditionSatisfied(
+            *observed_world, adjacent_corridors)) {
+      valid_primitives.push_back(i);
+    }
+  }
+  // with CheckValidityInPlan, actions index the valid primitives
+  std::vector<DiscreteAction> actions(valid_primitives.size());
+  if (check_validity_in_plan_) {
+    valid_primitives_ = valid_primitives;
+    std::iota(actions.begin(), actions.end(), 0);
+  } else {
+    std::copy(valid_primitives.begin(), valid_primitives.end(),
+              actions.begin());
+  }
+  return actions;
+}
+bool BehaviorMPMacroActions::HasIndependentClones() const {
+  for (const auto& p : motion_primitives_) {
+    if (!p->HasIndependentClones()) {
+      return false;
+    }
+  }
+  return true;
+}
 inline std::shared_ptr<BehaviorModel> BehaviorMPMacroActions::Clone() const {
   std::shared_ptr<BehaviorMPMacroActions> model_ptr =
       std::make_shared<BehaviorMPMacroActions>(*this);
   return model_ptr;
 }
+std::shared_ptr<BehaviorModel> BehaviorMPMacroActions::CloneIndependent()
+    const {
+  std::shared_ptr<BehaviorMPMacroActions> model_ptr =
+      std::make_shared<BehaviorMPMacroActions>(*this);
+  // primitives keep planning state such as their last action
+  for (auto& p : model_ptr->motion_primitives_) {
+    if (p->HasIndependentClones()) {
+      p = p->ClonePrimitive();
+    }
+  }
+  return model_ptr;
+}
 
 }  // namespace behavior
 }  // namespace models
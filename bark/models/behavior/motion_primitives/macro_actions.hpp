@@ -44,6 +44,17 @@ class BehaviorMPMacroActions : public BehaviorMotionPrimitives {
   void ClearMotionPrimitives() { motion_primitives_.clear(); }
 
   std::shared_ptr<BehaviorModel> Clone() const override;
+
+  //! actions of the primitives whose preconditions are satisfied, also if
+  //! they are not checked in Plan
+  std::vector<DiscreteAction> GetValidActions(
+      const ObservedWorldPtr& observed_world) override;
+
+  //! false if any primitive cannot be copied
+  bool HasIndependentClones() const override;
+
+  //! copies the primitives, primitives that cannot be copied are shared
+  std::shared_ptr<BehaviorModel> CloneIndependent() const override;
   const std::vector<primitives::PrimitivePtr>& GetMotionPrimitives() const;
   const std::vector<BehaviorMPMacroActions::MotionIdx>& GetValidPrimitives(
       const ObservedWorldPtr& observed_world);
@@ -0,0 +1,51 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/behavior/motion_primitives/motion_primitives.hpp"
+#include <numeric>
+#include "bark/world/observed_world.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+
+std::vector<DiscreteAction> BehaviorMotionPrimitives::GetValidActions(
+    const ObservedWorldPtr& observed_world) {
+  std::vector<DiscreteAction> actions(GetNumMotionPrimitives(observed_world));
+  std::iota(actions.begin(), actions.end(), 0);
+  return actions;
+}
+
+std::vector<std::pair<DiscreteAction, ObservedWorldPtr>>
+BehaviorMotionPrimitives::ExpandAll(const ObservedWorldPtr& observed_world,
+                                    double time_span,
+                                    unsigned int num_threads) {
+  // the actions have to be valid for the model that plans the expansions
+  const auto ego_behavior_model =
+      std::dynamic_pointer_cast<BehaviorMotionPrimitives>(
+          observed_world->GetEgoBehaviorModel());
+  if (!ego_behavior_model) {
+    LOG(ERROR) << "Ego agent has no motion primitive model, no actions to "
+                  "expand.";
+    return {};
+  }
+  const std::vector<DiscreteAction> actions =
+      ego_behavior_model->GetValidActions(observed_world);
+  const std::vector<ObservedWorldPtr> next_worlds =
+      observed_world->ExpandAll(time_span, actions, num_threads);
+  std::vector<std::pair<DiscreteAction, ObservedWorldPtr>> expansion;
+  expansion.reserve(actions.size());
+  for (std::size_t idx = 0; idx < actions.size(); ++idx) {
+    expansion.push_back(std::make_pair(actions.at(idx), next_worlds.at(idx)));
+  }
+  return expansion;
+}
+
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
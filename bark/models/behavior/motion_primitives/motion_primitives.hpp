@@ -9,6 +9,7 @@
 #ifndef BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_MOTION_PRIMITIVES_HPP_
 #define BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_MOTION_PRIMITIVES_HPP_
 
+#include <utility>
 #include <vector>
 
 #include "bark/models/behavior/behavior_model.hpp"
@@ -48,6 +49,40 @@ class BehaviorMotionPrimitives : public BehaviorModel {
     active_motion_ = motion_idx;
   }
 
+  /**
+   * @brief Actions that can be passed to ActionToBehavior in the given world
+   */
+  virtual std::vector<DiscreteAction> GetValidActions(
+      const ObservedWorldPtr& observed_world);
+
+  /**
+   * @brief Whether CloneIndependent returns a copy that does not share any
+   *        planning state, which is required to plan copies in parallel
+   */
+  virtual bool HasIndependentClones() const { return true; }
+
+  /**
+   * @brief Copy of the model that can be planned in parallel to this one,
+   *        unlike Clone it does not share any planning state
+   */
+  virtual std::shared_ptr<BehaviorModel> CloneIndependent() const {
+    return Clone();
+  }
+
+  /**
+   * @brief Evaluates the valid actions and predicts the successor world for
+   *        each of them, see ObservedWorld::ExpandAll. Both use the behavior
+   *        model of the ego agent in observed_world.
+   *
+   * @param observed_world world with a motion primitive ego behavior
+   * @param time_span prediction time span
+   * @param num_threads number of threads expanding the actions in parallel
+   * @return pairs of valid action and successor world
+   */
+  std::vector<std::pair<DiscreteAction, ObservedWorldPtr>> ExpandAll(
+      const ObservedWorldPtr& observed_world, double time_span,
+      unsigned int num_threads = 1);
+
  protected:
   std::vector<Input> motion_primitives_;
   Action active_motion_;
@@ -12,6 +12,7 @@
 #include <memory>
 #include "bark/commons/base_type.hpp"
 #include "bark/models/behavior/idm/idm_lane_tracking.hpp"
+#include "bark/models/behavior/motion_primitives/primitives/primitive_trajectory_cache.hpp"
 #include "bark/models/dynamic/integration.hpp"
 #include "bark/models/dynamic/single_track.hpp"
 #include "bark/world/map/road_corridor.hpp"
@@ -48,7 +49,13 @@ class Primitive : public bark::commons::BaseType {
             "BehaviorMotionPrimitives::IntegrationTimeDelta",
             "the size of the time steps used within the euler integration loop",
             0.02)),
-        last_action_() {}
+        last_action_() {
+    if (params->GetBool("PrimitiveTrajectoryCache::Enabled",
+                        "If true, primitives memoize their trajectories",
+                        false)) {
+      trajectory_cache_ = std::make_shared<PrimitiveTrajectoryCache>(params);
+    }
+  }
 
   virtual ~Primitive() = default;
 
@@ -74,11 +81,34 @@ class Primitive : public bark::commons::BaseType {
 
   virtual std::string GetName() const = 0;
 
+  /**
+   * @brief Whether ClonePrimitive returns a copy with its own planning
+   *        state, false e.g. for primitives implemented in Python
+   */
+  virtual bool HasIndependentClones() const { return false; }
+
+  /**
+   * @brief Copy of the primitive with its own planning state
+   * @return nullptr if HasIndependentClones is false
+   */
+  virtual std::shared_ptr<Primitive> ClonePrimitive() const {
+    return nullptr;
+  }
+
   Action GetLastAction() const { return last_action_; };
   void SetLastAction(const Action action) { last_action_ = action; };
 
+  //! the cache may be shared by several primitives, nullptr disables it
+  PrimitiveTrajectoryCachePtr GetTrajectoryCache() const {
+    return trajectory_cache_;
+  }
+  void SetTrajectoryCache(const PrimitiveTrajectoryCachePtr& cache) {
+    trajectory_cache_ = cache;
+  }
+
  protected:
   double integration_time_delta_;
+  PrimitiveTrajectoryCachePtr trajectory_cache_;
 
  private:
   Action last_action_;
@@ -33,6 +33,12 @@ class PrimitiveConstAccChangeToRight : public PrimitiveConstAccStayLane {
 
   std::string GetName() const override;
 
+  bool HasIndependentClones() const override { return true; }
+
+  std::shared_ptr<Primitive> ClonePrimitive() const override {
+    return std::make_shared<PrimitiveConstAccChangeToRight>(*this);
+  }
+
  private:
   double min_length_;
 };
@@ -76,6 +76,34 @@ bark::world::LaneCorridorPtr bark::models::behavior::primitives::
   return adjacent_corridors.current;
 }
 
+std::tuple<bark::models::dynamic::Trajectory, bark::models::behavior::Action>
+bark::models::behavior::primitives::PrimitiveConstAccStayLane::
+    GenerateTrajectory(
+        const bark::world::ObservedWorld& observed_world,
+        const bark::world::LaneCorridorPtr& lane_corr,
+        const bark::models::behavior::IDMRelativeValues& rel_values,
+        double delta_time) const {
+  const auto generate = [&]() {
+    return BehaviorIDMLaneTracking::GenerateTrajectory(
+        observed_world, lane_corr, rel_values, delta_time);
+  };
+  if (!trajectory_cache_) {
+    return generate();
+  }
+  // keep the side effect of the lane tracking on the dynamic model
+  auto single_track = std::dynamic_pointer_cast<dynamic::SingleTrackModel>(
+      observed_world.GetEgoAgent()->GetDynamicModel());
+  if (single_track) {
+    single_track->SetAccelerationLimits(GetAccelerationLimits());
+  }
+  const LaneCorridorPtr& corridor =
+      constant_lane_corr_ ? constant_lane_corr_ : lane_corr;
+  // the acceleration is part of the name
+  return trajectory_cache_->GetOrGenerate(
+      GetName(), corridor, observed_world.CurrentEgoState(),
+      observed_world.GetWorldTime(), delta_time, {}, generate);
+}
+
 std::pair<double, double>
 bark::models::behavior::primitives::PrimitiveConstAccStayLane::GetTotalAcc(
     const bark::world::ObservedWorld& observed_world,
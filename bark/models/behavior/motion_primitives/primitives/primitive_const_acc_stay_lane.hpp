@@ -32,10 +32,22 @@ class PrimitiveConstAccStayLane : public Primitive,
 
   std::string GetName() const override;
 
+  bool HasIndependentClones() const override { return true; }
+
+  std::shared_ptr<Primitive> ClonePrimitive() const override {
+    return std::make_shared<PrimitiveConstAccStayLane>(*this);
+  }
+
   LaneCorridorPtr SelectTargetCorridor(
       const ObservedWorld& observed_world,
       const AdjacentLaneCorridors& adjacent_corridors) override;
 
+  //! uses the trajectory cache of the primitive if it is enabled
+  std::tuple<Trajectory, Action> GenerateTrajectory(
+      const world::ObservedWorld& observed_world,
+      const LaneCorridorPtr& lane_corr, const IDMRelativeValues& rel_values,
+      double delta_time) const override;
+
  protected:
   std::pair<double, double> GetTotalAcc(const ObservedWorld& observed_world,
                                         const IDMRelativeValues& rel_values,
@@ -9,6 +9,9 @@
 #ifndef BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_GAP_KEEPING_HPP_
 #define BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_GAP_KEEPING_HPP_
 
+#include <string>
+#include <tuple>
+#include <vector>
 #include "bark/models/behavior/motion_primitives/primitives/primitive.hpp"
 
 namespace bark {
@@ -42,6 +45,12 @@ class PrimitiveGapKeeping : public Primitive, public BehaviorIDMLaneTracking {
 
   std::string GetName() const override { return "PrimitiveGapKeeping"; }
 
+  bool HasIndependentClones() const override { return true; }
+
+  std::shared_ptr<Primitive> ClonePrimitive() const override {
+    return std::make_shared<PrimitiveGapKeeping>(*this);
+  }
+
   Action GetLastAction() const {
     return BehaviorIDMLaneTracking::GetLastAction();
   }
@@ -52,6 +61,40 @@ class PrimitiveGapKeeping : public Primitive, public BehaviorIDMLaneTracking {
     return observed_world.GetRoadCorridor()->GetCurrentLaneCorridor(
         observed_world.CurrentEgoPosition());
   }
+
+  //! uses the trajectory cache of the primitive if it is enabled
+  std::tuple<Trajectory, Action> GenerateTrajectory(
+      const world::ObservedWorld& observed_world,
+      const LaneCorridorPtr& lane_corr, const IDMRelativeValues& rel_values,
+      double delta_time) const override {
+    const auto generate = [&]() {
+      return BehaviorIDMLaneTracking::GenerateTrajectory(
+          observed_world, lane_corr, rel_values, delta_time);
+    };
+    if (!trajectory_cache_) {
+      return generate();
+    }
+    auto single_track = std::dynamic_pointer_cast<dynamic::SingleTrackModel>(
+        observed_world.GetEgoAgent()->GetDynamicModel());
+    if (single_track) {
+      single_track->SetAccelerationLimits(GetAccelerationLimits());
+    }
+    const LaneCorridorPtr& corridor =
+        constant_lane_corr_ ? constant_lane_corr_ : lane_corr;
+    // the IDM response depends on the leading vehicle as well
+    const double acc_resolution =
+        trajectory_cache_->GetAccelerationResolution();
+    const std::vector<PrimitiveTrajectoryCache::QuantizedValue> leading_values{
+        {static_cast<double>(rel_values.has_leading_object), 1.0},
+        {rel_values.leading_distance, trajectory_cache_->GetLonResolution()},
+        {rel_values.leading_velocity,
+         trajectory_cache_->GetVelocityResolution()},
+        {rel_values.leading_acc, acc_resolution},
+        {rel_values.ego_acc, acc_resolution}};
+    return trajectory_cache_->GetOrGenerate(
+        GetName(), corridor, observed_world.CurrentEgoState(),
+        observed_world.GetWorldTime(), delta_time, leading_values, generate);
+  }
 };
 
 }  // namespace primitives
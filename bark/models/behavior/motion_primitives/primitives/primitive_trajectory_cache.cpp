@@ -0,0 +1,176 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/behavior/motion_primitives/primitives/primitive_trajectory_cache.hpp"
+#include <algorithm>
+#include <cmath>
+#include "bark/commons/transformation/frenet_state.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+namespace primitives {
+
+using bark::commons::transformation::FrenetState;
+using bark::models::dynamic::THETA_POSITION;
+using bark::models::dynamic::TIME_POSITION;
+using bark::models::dynamic::VEL_POSITION;
+using bark::models::dynamic::X_POSITION;
+using bark::models::dynamic::Y_POSITION;
+
+PrimitiveTrajectoryCache::PrimitiveTrajectoryCache(
+    const commons::ParamsPtr& params)
+    : commons::BaseType(params),
+      lon_resolution_(params->GetReal("PrimitiveTrajectoryCache::LonResolution",
+                                      "Quantization of the longitudinal "
+                                      "Frenet position and distances [m]",
+                                      0.5)),
+      lat_resolution_(params->GetReal(
+          "PrimitiveTrajectoryCache::LatResolution",
+          "Quantization of the lateral Frenet position [m]", 0.1)),
+      angle_resolution_(params->GetReal(
+          "PrimitiveTrajectoryCache::AngleResolution",
+          "Quantization of the angle relative to the center line [rad]",
+          0.02)),
+      velocity_resolution_(params->GetReal(
+          "PrimitiveTrajectoryCache::VelocityResolution",
+          "Quantization of the velocity [m/s]", 0.1)),
+      acceleration_resolution_(params->GetReal(
+          "PrimitiveTrajectoryCache::AccelerationResolution",
+          "Quantization of accelerations [m/s^2]", 0.1)),
+      time_resolution_(params->GetReal(
+          "PrimitiveTrajectoryCache::TimeResolution",
+          "Quantization of the time between trajectory points [s]", 1e-3)),
+      max_size_(params->GetInt(
+          "PrimitiveTrajectoryCache::MaxSize",
+          "Maximum number of cached trajectories, cache is cleared if reached",
+          100000)),
+      num_hits_(0),
+      num_misses_(0) {}
+
+PrimitiveTrajectoryCache::Key PrimitiveTrajectoryCache::MakeKey(
+    const std::string& primitive_id, const LaneCorridorPtr& target_corridor,
+    const State& ego_state, double delta_time,
+    const std::vector<QuantizedValue>& additional_values) const {
+  const auto quantize = [](double value, double resolution) {
+    return static_cast<int64_t>(std::round(value / resolution));
+  };
+  FrenetState frenet_state(ego_state, target_corridor->GetCenterLine());
+  std::vector<int64_t> quantized_values{
+      quantize(frenet_state.lon, lon_resolution_),
+      quantize(frenet_state.lat, lat_resolution_),
+      quantize(frenet_state.angle, angle_resolution_),
+      quantize(ego_state(VEL_POSITION), velocity_resolution_),
+      quantize(delta_time, time_resolution_)};
+  for (const auto& value : additional_values) {
+    quantized_values.push_back(quantize(value.first, value.second));
+  }
+  return Key(primitive_id, target_corridor, quantized_values);
+}
+
+PrimitiveTrajectoryCache::TrajectoryAction
+PrimitiveTrajectoryCache::GetOrGenerate(
+    const std::string& primitive_id, const LaneCorridorPtr& target_corridor,
+    const State& ego_state, double start_time, double delta_time,
+    const std::vector<QuantizedValue>& additional_values,
+    const GenerateFunction& generate) {
+  if (!target_corridor) {
+    return generate();
+  }
+  const Key key = MakeKey(primitive_id, target_corridor, ego_state,
+                          delta_time, additional_values);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = relative_trajectories_.find(key);
+    if (it != relative_trajectories_.end()) {
+      ++num_hits_;
+      // re-anchor the relative trajectory at the current ego state
+      Trajectory traj = std::get<0>(it->second);
+      const double theta = ego_state(THETA_POSITION);
+      const double cos_theta = cos(theta), sin_theta = sin(theta);
+      for (int i = 0; i < traj.rows(); ++i) {
+        const double dx = traj(i, X_POSITION), dy = traj(i, Y_POSITION);
+        traj(i, TIME_POSITION) += start_time;
+        traj(i, X_POSITION) =
+            ego_state(X_POSITION) + cos_theta * dx - sin_theta * dy;
+        traj(i, Y_POSITION) =
+            ego_state(Y_POSITION) + sin_theta * dx + cos_theta * dy;
+        traj(i, THETA_POSITION) += theta;
+        traj(i, VEL_POSITION) =
+            std::max(traj(i, VEL_POSITION) + ego_state(VEL_POSITION), 0.0);
+      }
+      return TrajectoryAction(traj, std::get<1>(it->second));
+    }
+    ++num_misses_;
+  }
+
+  const TrajectoryAction traj_action = generate();
+  const Trajectory& traj = std::get<0>(traj_action);
+  if (traj.rows() == 0) {
+    return traj_action;
+  }
+
+  // store the trajectory relative to its first point
+  Trajectory relative_traj = traj;
+  const double theta = traj(0, THETA_POSITION);
+  const double cos_theta = cos(theta), sin_theta = sin(theta);
+  for (int i = 0; i < traj.rows(); ++i) {
+    const double dx = traj(i, X_POSITION) - traj(0, X_POSITION);
+    const double dy = traj(i, Y_POSITION) - traj(0, Y_POSITION);
+    relative_traj(i, TIME_POSITION) = traj(i, TIME_POSITION) - start_time;
+    relative_traj(i, X_POSITION) = cos_theta * dx + sin_theta * dy;
+    relative_traj(i, Y_POSITION) = -sin_theta * dx + cos_theta * dy;
+    relative_traj(i, THETA_POSITION) = traj(i, THETA_POSITION) - theta;
+    relative_traj(i, VEL_POSITION) =
+        traj(i, VEL_POSITION) - traj(0, VEL_POSITION);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (relative_trajectories_.size() >= max_size_) {
+    relative_trajectories_.clear();
+  }
+  relative_trajectories_[key] =
+      TrajectoryAction(relative_traj, std::get<1>(traj_action));
+  return traj_action;
+}
+
+void PrimitiveTrajectoryCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  relative_trajectories_.clear();
+  num_hits_ = 0;
+  num_misses_ = 0;
+}
+
+std::size_t PrimitiveTrajectoryCache::GetSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return relative_trajectories_.size();
+}
+
+std::size_t PrimitiveTrajectoryCache::GetNumHits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_hits_;
+}
+
+std::size_t PrimitiveTrajectoryCache::GetNumMisses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_misses_;
+}
+
+double PrimitiveTrajectoryCache::GetHitRate() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const std::size_t num_queries = num_hits_ + num_misses_;
+  if (num_queries == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(num_hits_) / static_cast<double>(num_queries);
+}
+
+}  // namespace primitives
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
@@ -0,0 +1,112 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_TRAJECTORY_CACHE_HPP_
+#define BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_TRAJECTORY_CACHE_HPP_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "bark/commons/base_type.hpp"
+#include "bark/commons/params/params.hpp"
+#include "bark/models/behavior/behavior_model.hpp"
+#include "bark/world/map/lane_corridor.hpp"
+
+namespace bark {
+namespace models {
+namespace behavior {
+namespace primitives {
+
+using dynamic::State;
+using dynamic::Trajectory;
+using world::map::LaneCorridorPtr;
+
+/**
+ * @brief Memoizes primitive trajectories for search-based planners
+ *
+ * Trajectories are keyed by the primitive, the target corridor, the
+ * quantized Frenet ego state (lon, lat, angle, velocity), the time between
+ * trajectory points and additional primitive specific values, each with its
+ * own resolution. They are stored relative to their start state and
+ * re-anchored at the current ego state on a hit.
+ */
+class PrimitiveTrajectoryCache : public commons::BaseType {
+ public:
+  typedef std::tuple<Trajectory, Action> TrajectoryAction;
+  typedef std::function<TrajectoryAction()> GenerateFunction;
+  //! value a trajectory depends on and the resolution it is quantized with
+  typedef std::pair<double, double> QuantizedValue;
+
+  explicit PrimitiveTrajectoryCache(const commons::ParamsPtr& params);
+
+  /**
+   * @brief Returns the cached trajectory or generates and caches it
+   *
+   * @param primitive_id unique id of the primitive, e.g. its name
+   * @param target_corridor corridor the trajectory is tracking
+   * @param ego_state current ego state
+   * @param start_time time of the first trajectory point
+   * @param delta_time time between two trajectory points, i.e. the
+   *        planning time divided by the number of trajectory segments
+   * @param additional_values further values the trajectory depends on,
+   *        each with its resolution
+   * @param generate generates the trajectory on a miss
+   */
+  TrajectoryAction GetOrGenerate(
+      const std::string& primitive_id, const LaneCorridorPtr& target_corridor,
+      const State& ego_state, double start_time, double delta_time,
+      const std::vector<QuantizedValue>& additional_values,
+      const GenerateFunction& generate);
+
+  void Clear();
+
+  std::size_t GetSize() const;
+  std::size_t GetNumHits() const;
+  std::size_t GetNumMisses() const;
+  double GetHitRate() const;
+
+  double GetLonResolution() const { return lon_resolution_; }
+  double GetVelocityResolution() const { return velocity_resolution_; }
+  double GetAccelerationResolution() const { return acceleration_resolution_; }
+
+ private:
+  typedef std::tuple<std::string, LaneCorridorPtr, std::vector<int64_t>> Key;
+
+  Key MakeKey(const std::string& primitive_id,
+              const LaneCorridorPtr& target_corridor, const State& ego_state,
+              double delta_time,
+              const std::vector<QuantizedValue>& additional_values) const;
+
+  double lon_resolution_;
+  double lat_resolution_;
+  double angle_resolution_;
+  double velocity_resolution_;
+  double acceleration_resolution_;
+  double time_resolution_;
+  std::size_t max_size_;
+
+  mutable std::mutex mutex_;
+  std::map<Key, TrajectoryAction> relative_trajectories_;
+  std::size_t num_hits_;
+  std::size_t num_misses_;
+};
+
+typedef std::shared_ptr<PrimitiveTrajectoryCache> PrimitiveTrajectoryCachePtr;
+
+}  // namespace primitives
+}  // namespace behavior
+}  // namespace models
+}  // namespace bark
+
+#endif  // BARK_MODELS_BEHAVIOR_MOTION_PRIMITIVES_PRIMITIVES_PRIMITIVE_TRAJECTORY_CACHE_HPP_
@@ -50,21 +50,23 @@ BehaviorLaneChangeRuleBased::FrontRearAgents(
     const ObservedWorld& observed_world,
     const LaneCorridorPtr& lane_corr) const {
   AgentInformation front_info, rear_info;
-  const auto& front_rear = observed_world.GetAgentFrontRear(lane_corr);
-  const auto& ego_agent = observed_world.GetEgoAgent();
+  // shared with all other agents planning on the same world snapshot
+  const world::NeighborInformation neighbor_info =
+      observed_world.GetNeighborInformation(
+          observed_world.GetEgoAgentId(), lane_corr,
+          observed_world.GetFracLateralOffset());
+  const auto& front_rear = neighbor_info.front_rear;
   if (front_rear.front.first) {
     // front info
     front_info.agent_info = front_rear.front;
-    front_info.rel_velocity =
-        GetVelocity(front_rear.front.first) - GetVelocity(ego_agent);
+    front_info.rel_velocity = neighbor_info.rel_velocity_front;
     front_info.rel_distance = front_rear.front.second.lon;
     front_info.is_vehicle = true;
   }
   if (front_rear.rear.first) {
     // rear info
     rear_info.agent_info = front_rear.rear;
-    rear_info.rel_velocity =
-        GetVelocity(front_rear.rear.first) - GetVelocity(ego_agent);
+    rear_info.rel_velocity = neighbor_info.rel_velocity_rear;
     rear_info.rel_distance = front_rear.rear.second.lon;
     rear_info.is_vehicle = true;
   } else {
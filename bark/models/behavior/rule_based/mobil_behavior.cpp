@@ -99,7 +99,10 @@ BehaviorMobilRuleBased::ChooseLaneCorridor(
     for (const auto& li : lane_corr_infos) {
       VLOG(4) << li;
       double acc_change_ego, acc_behind, acc_change_behind;
-      if (li.front.agent_info.first) {
+      if (li.lane_corridor == lane_corr) {
+        // staying in the current lane corridor, already calculated above
+        acc_change_ego = acc_ego;
+      } else if (li.front.agent_info.first) {
         BARK_EXPECT_TRUE(li.front.rel_distance >= 0);
         acc_change_ego = CalcRawIDMAcc(
             li.front.rel_distance, GetVelocity(observed_world.GetEgoAgent()),
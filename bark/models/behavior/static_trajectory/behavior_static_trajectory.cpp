@@ -6,6 +6,8 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 
 #include "bark/commons/transformation/frenet_state.hpp"
@@ -21,17 +23,45 @@ using bark::models::dynamic::StateDefinition;
 BehaviorStaticTrajectory::BehaviorStaticTrajectory(
     const commons::ParamsPtr& params)
     : BehaviorModel(params, BehaviorStatus::NOT_STARTED_YET),
-      static_trajectory_(ReadInStaticTrajectory(params->GetListListFloat(
-          "static_trajectory",
-          "List of states that form a static trajectory to follow", {{}}))) {
+      static_trajectory_(std::make_shared<const Trajectory>(
+          ReadInStaticTrajectory(params->GetListListFloat(
+              "static_trajectory",
+              "List of states that form a static trajectory to follow",
+              {{}})))),
+      cursor_(0) {
   SetLastAction(LonLatAction{0.0, 0.0});
+  SetTimeBounds();
 }
 
 BehaviorStaticTrajectory::BehaviorStaticTrajectory(
     const commons::ParamsPtr& params, const Trajectory& static_trajectory)
     : BehaviorModel(params, BehaviorStatus::NOT_STARTED_YET),
-      static_trajectory_(static_trajectory) {
+      static_trajectory_(std::make_shared<const Trajectory>(static_trajectory)),
+      cursor_(0) {
   SetLastAction(LonLatAction{0.0, 0.0});
+  SetTimeBounds();
+}
+
+BehaviorStaticTrajectory::BehaviorStaticTrajectory(
+    const commons::ParamsPtr& params,
+    const StaticTrajectoryPtr& static_trajectory)
+    : BehaviorModel(params, BehaviorStatus::NOT_STARTED_YET),
+      static_trajectory_(static_trajectory),
+      cursor_(0) {
+  BARK_EXPECT_TRUE(bool(static_trajectory_));
+  SetLastAction(LonLatAction{0.0, 0.0});
+  SetTimeBounds();
+}
+
+void BehaviorStaticTrajectory::SetTimeBounds() {
+  const Trajectory& traj = *static_trajectory_;
+  if (traj.rows() == 0 || traj.cols() <= dynamic::TIME_POSITION) {
+    start_time_ = std::numeric_limits<double>::infinity();
+    end_time_ = -std::numeric_limits<double>::infinity();
+    return;
+  }
+  start_time_ = traj.col(dynamic::TIME_POSITION).minCoeff();
+  end_time_ = traj.col(dynamic::TIME_POSITION).maxCoeff();
 }
 
 Trajectory BehaviorStaticTrajectory::Plan(
@@ -58,7 +88,7 @@ Trajectory BehaviorStaticTrajectory::Plan(
   traj.row(0) = interp_start;
   traj.row(traj.rows() - 1) = interp_end;
   traj.block(1, 0, num_rows, traj.cols()) =
-      static_trajectory_.block(idx_start, 0, num_rows, traj.cols());
+      static_trajectory_->block(idx_start, 0, num_rows, traj.cols());
   this->SetLastTrajectory(traj);
   this->SetLastAction(BehaviorStaticTrajectory::CalculateAction(
       delta_time, observed_world, traj));
@@ -82,30 +112,46 @@ Action BehaviorStaticTrajectory::CalculateAction(
   return LonLatAction{acc_lat, acc_lon};
 }
 
-std::pair<int, int> BehaviorStaticTrajectory::Interpolate(
-    const double t, StateRowVector* interpolated) const {
-  StateRowVector delta;
-  double alpha;
-  int idx = -1;
-  if (static_trajectory_.rows() < 2) {
-    return {-1, -1};
+int BehaviorStaticTrajectory::FindSegment(const double t) const {
+  // returns the first segment i with t_i <= t <= t_i+1, requires
+  // non-decreasing time stamps
+  const Trajectory& traj = *static_trajectory_;
+  const int num_rows = traj.rows();
+  const auto time = [&traj](int i) {
+    return traj(i, dynamic::TIME_POSITION);
+  };
+  if (num_rows < 2 || t < time(0) || t > time(num_rows - 1)) {
+    return -1;
   }
-  for (int i = 0; i < static_trajectory_.rows() - 1; ++i) {
-    double t_i = static_trajectory_(i, dynamic::TIME_POSITION);
-    double t_i_succ = static_trajectory_(i + 1, dynamic::TIME_POSITION);
-
-    if (t_i <= t && t <= t_i_succ) {
-      idx = i;
-      break;
+  if (cursor_ + 1 < num_rows && time(cursor_) < t &&
+      t <= time(cursor_ + 1)) {
+    return cursor_;
+  }
+  // first row with t_j >= t
+  int low = 0, high = num_rows - 1;
+  while (low < high) {
+    const int mid = low + (high - low) / 2;
+    if (time(mid) < t) {
+      low = mid + 1;
+    } else {
+      high = mid;
     }
   }
+  cursor_ = std::max(low - 1, 0);
+  return cursor_;
+}
+
+std::pair<int, int> BehaviorStaticTrajectory::Interpolate(
+    const double t, StateRowVector* interpolated) const {
+  const Trajectory& traj = *static_trajectory_;
+  const int idx = FindSegment(t);
   if (idx < 0) {
     return {-1, -1};
   }
-  delta = static_trajectory_.row(idx + 1) - static_trajectory_.row(idx);
-  alpha = (t - static_trajectory_(idx, dynamic::TIME_POSITION)) /
-          delta(dynamic::TIME_POSITION);
-  *interpolated = (static_trajectory_.row(idx) + alpha * delta);
+  const StateRowVector delta = traj.row(idx + 1) - traj.row(idx);
+  const double alpha =
+      (t - traj(idx, dynamic::TIME_POSITION)) / delta(dynamic::TIME_POSITION);
+  *interpolated = (traj.row(idx) + alpha * delta);
   // Index of next valid entry
   if (alpha == 0.0) {
     return {idx - 1, idx + 1};
@@ -135,7 +181,7 @@ Trajectory BehaviorStaticTrajectory::ReadInStaticTrajectory(
 }
 
 const Trajectory& BehaviorStaticTrajectory::GetStaticTrajectory() const {
-  return static_trajectory_;
+  return *static_trajectory_;
 }
 
 void BehaviorStaticTrajectory::UpdateBehaviorStatus(
@@ -143,14 +189,9 @@ void BehaviorStaticTrajectory::UpdateBehaviorStatus(
   const double start_time = observed_world.GetWorldTime();
   const double end_time = start_time + delta_time;
 
-  const double start_time_static_traj =
-      (static_trajectory_.col(dynamic::TIME_POSITION)).minCoeff();
-  const double end_time_static_traj =
-      (static_trajectory_.col(dynamic::TIME_POSITION)).maxCoeff();
-
-  if (start_time_static_traj > start_time) {
+  if (start_time_ > start_time) {
     SetBehaviorStatus(BehaviorStatus::NOT_STARTED_YET);
-  } else if (end_time_static_traj <= end_time) {
+  } else if (end_time_ <= end_time) {
     VLOG(1) << "Agent " << observed_world.GetEgoAgentId()
             << ": Behavior status has expired!";
     SetBehaviorStatus(BehaviorStatus::EXPIRED);
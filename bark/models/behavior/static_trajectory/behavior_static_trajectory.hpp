@@ -27,6 +27,8 @@ using dynamic::Trajectory;
 using world::ObservedWorld;
 using world::objects::AgentId;
 using StateRowVector = Eigen::Matrix<State::Scalar, 1, Eigen::Dynamic>;
+//! static trajectories are immutable and shared between clones
+typedef std::shared_ptr<const Trajectory> StaticTrajectoryPtr;
 
 // model for replaying static trajectories
 // can e.g. be used for dataset replay
@@ -35,10 +37,15 @@ class BehaviorStaticTrajectory : public BehaviorModel {
   explicit BehaviorStaticTrajectory(const commons::ParamsPtr& params);
   BehaviorStaticTrajectory(const commons::ParamsPtr& params,
                            const Trajectory& static_trajectory);
+  BehaviorStaticTrajectory(const commons::ParamsPtr& params,
+                           const StaticTrajectoryPtr& static_trajectory);
   Trajectory Plan(double min_planning_time,
                   const world::ObservedWorld& observed_world) override;
   std::shared_ptr<BehaviorModel> Clone() const override;
   const Trajectory& GetStaticTrajectory() const;
+  StaticTrajectoryPtr GetSharedStaticTrajectory() const {
+    return static_trajectory_;
+  }
   void UpdateBehaviorStatus(double delta_time,
                             const world::ObservedWorld& observed_world);
   static Action CalculateAction(
@@ -48,9 +55,15 @@ class BehaviorStaticTrajectory : public BehaviorModel {
  private:
   static Trajectory ReadInStaticTrajectory(
       std::vector<std::vector<double>> list);
+  void SetTimeBounds();
+  int FindSegment(const double t) const;
   std::pair<int, int> Interpolate(const double t,
                                   StateRowVector* interpolated) const;
-  Trajectory static_trajectory_;
+  StaticTrajectoryPtr static_trajectory_;
+  double start_time_;
+  double end_time_;
+  // segment of the last lookup, consecutive plans query nearby times
+  mutable int cursor_;
 };
 
 }  // namespace behavior
@@ -41,8 +41,8 @@ class ExecutionModel : public commons::BaseType {
 
   virtual ~ExecutionModel() {}
 
-  State GetExecutedState() const { return last_state_; }
-  Trajectory GetLastTrajectory() const { return last_trajectory_; }
+  const State& GetExecutedState() const { return last_state_; }
+  const Trajectory& GetLastTrajectory() const { return last_trajectory_; }
 
   void SetLastState(const State& state) { last_state_ = state; }
 
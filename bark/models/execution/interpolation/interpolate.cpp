@@ -7,6 +7,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "bark/models/execution/interpolation/interpolate.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace bark {
@@ -38,36 +39,44 @@ std::pair<State, bool>
 ExecutionModelInterpolate::CheckIfTimeExactIsInTrajectory(
     const Trajectory& trajectory, const double& world_time) const {
   const double delta = 1e-3;
-  double start_time = trajectory(0, TIME_POSITION);
-  double end_time = trajectory(trajectory.rows() - 1, TIME_POSITION);
-  int half_traj_num = static_cast<int>(trajectory.rows() / 2);
-
-  // closer to the end; reverse; only need to check half of the traj.
-  if (fabs(world_time - end_time) < fabs(world_time - start_time)) {
-    for (int i = trajectory.rows() - 1; half_traj_num - 1 < i; i--)
-      if (fabs(trajectory(i, TIME_POSITION) - world_time) < delta)
-        return {State(trajectory.row(i)), true};
-  } else {
-    for (int i = 0; i < half_traj_num + 1; i++)
-      if (fabs(trajectory(i, TIME_POSITION) - world_time) < delta)
-        return {State(trajectory.row(i)), true};
+  const int lower_id = FindLowerTrajectoryRow(trajectory, world_time);
+  // only the bracketing rows can be within delta
+  for (int i = lower_id; i < std::min(lower_id + 2, int(trajectory.rows()));
+       i++) {
+    if (fabs(trajectory(i, TIME_POSITION) - world_time) < delta)
+      return {State(trajectory.row(i)), true};
   }
   return {State(), false};
 }
 
 std::pair<int, bool> ExecutionModelInterpolate::FindClosestLowerTrajectoryRow(
     const Trajectory& trajectory, const double& world_time) const {
-  const double delta = 1e-3;
-  int ret_idx = 0;
-  bool found_closest_pt = false;
-  for (int i = 0; i < trajectory.rows(); i++) {
-    if (world_time >= trajectory(i, TIME_POSITION)) {
-      ret_idx = i;
-      found_closest_pt = true;
-      break;
+  if (trajectory.rows() == 0 || world_time < trajectory(0, TIME_POSITION)) {
+    return {0, false};
+  }
+  return {FindLowerTrajectoryRow(trajectory, world_time), true};
+}
+
+int ExecutionModelInterpolate::FindLowerTrajectoryRow(
+    const Trajectory& trajectory, const double& world_time) const {
+  const int num_rows = trajectory.rows();
+  if (cursor_ + 1 < num_rows &&
+      trajectory(cursor_, TIME_POSITION) <= world_time &&
+      world_time < trajectory(cursor_ + 1, TIME_POSITION)) {
+    return cursor_;
+  }
+  // first row with a time larger than world_time
+  int low = 0, high = num_rows;
+  while (low < high) {
+    const int mid = low + (high - low) / 2;
+    if (trajectory(mid, TIME_POSITION) <= world_time) {
+      low = mid + 1;
+    } else {
+      high = mid;
     }
   }
-  return {ret_idx, found_closest_pt};
+  cursor_ = std::max(low - 1, 0);
+  return cursor_;
 }
 
 State ExecutionModelInterpolate::Interpolate(const State& p0, const State& p1,
@@ -79,6 +88,19 @@ State ExecutionModelInterpolate::Interpolate(const State& p0, const State& p1,
   return (1 - lambda) * p0 + (lambda)*p1;
 }
 
+void ExecutionModelInterpolate::Interpolate(const Trajectory& trajectory,
+                                            int lower_id, const double& time,
+                                            State* interpolated) const {
+  const double start_time = trajectory(lower_id, TIME_POSITION);
+  const double end_time = trajectory(lower_id + 1, TIME_POSITION);
+  const double lambda = fabs((time - start_time) / (end_time - start_time));
+  BARK_EXPECT_TRUE(end_time >= start_time && time >= start_time);
+  interpolated->resize(trajectory.cols());
+  interpolated->noalias() =
+      (1 - lambda) * trajectory.row(lower_id).transpose() +
+      lambda * trajectory.row(lower_id + 1).transpose();
+}
+
 void ExecutionModelInterpolate::Execute(const double& new_world_time,
                                         const Trajectory& trajectory,
                                         const DynamicModelPtr dynamic_model) {
@@ -100,25 +122,27 @@ void ExecutionModelInterpolate::Execute(const double& new_world_time,
   }
 
   // check if we can quickly find an exact point
-  std::pair<State, bool> has_exact_point =
-      CheckIfTimeExactIsInTrajectory(trajectory, new_world_time);
-  if (has_exact_point.second) {
-    SetLastState(has_exact_point.first);
+  const double delta = 1e-3;
+  const int lower_id = FindLowerTrajectoryRow(trajectory, new_world_time);
+  const int upper_id = lower_id + 1;
+  if (fabs(trajectory(lower_id, TIME_POSITION) - new_world_time) < delta) {
+    SetLastState(trajectory.row(lower_id));
+    return;
+  }
+  if (upper_id < trajectory.rows() &&
+      fabs(trajectory(upper_id, TIME_POSITION) - new_world_time) < delta) {
+    SetLastState(trajectory.row(upper_id));
     return;
   }
 
   // if not, interpolate
-  std::pair<int, bool> lower_idx =
-      FindClosestLowerTrajectoryRow(trajectory, new_world_time);
-  if (lower_idx.second == true) {
-    int lower_id = lower_idx.first;
-    int upper_id = lower_id + 1;
-    State p0 = trajectory.row(lower_id);
-    State p1 = trajectory.row(upper_id);
-    State interp_state = Interpolate(p0, p1, new_world_time);
-    SetLastState(interp_state);
+  if (upper_id < trajectory.rows() &&
+      trajectory(lower_id, TIME_POSITION) <= new_world_time) {
+    Interpolate(trajectory, lower_id, new_world_time, &interpolated_state_);
+    SetLastState(interpolated_state_);
     // assert that the interpolated point is near the world time
-    BARK_EXPECT_TRUE(fabs(interp_state(TIME_POSITION) - new_world_time) < 0.02);
+    BARK_EXPECT_TRUE(
+        fabs(interpolated_state_(TIME_POSITION) - new_world_time) < 0.02);
     return;
   } else {
     LOG(INFO) << "ExecutionStatus is invalid." << std::endl;
@@ -10,6 +10,7 @@
 #define BARK_MODELS_EXECUTION_INTERPOLATION_INTERPOLATE_HPP_
 
 #include <Eigen/Core>
+#include <utility>
 #include "bark/models/execution/execution_model.hpp"
 
 namespace bark {
@@ -22,7 +23,7 @@ using dynamic::State;
 class ExecutionModelInterpolate : public ExecutionModel {
  public:
   explicit ExecutionModelInterpolate(const ParamsPtr& params)
-      : ExecutionModel(params) {}
+      : ExecutionModel(params), cursor_(0), interpolated_state_() {}
   ~ExecutionModelInterpolate() {}
 
   /**
@@ -47,12 +48,28 @@ class ExecutionModelInterpolate : public ExecutionModel {
   std::pair<int, bool> FindClosestLowerTrajectoryRow(
       const Trajectory& trajectory, const double& world_time) const;
 
+  /**
+   * @brief  Last row with a time smaller or equal to world_time, 0 if
+   *         world_time is before the trajectory
+   * @note   Requires a monotonic time column. Checks the row of the last
+   *         lookup first and uses a binary search otherwise.
+   */
+  int FindLowerTrajectoryRow(const Trajectory& trajectory,
+                             const double& world_time) const;
+
   /**
    * @brief  Interpolates between two states
    * @retval State: interpolated state
    */
   State Interpolate(const State& p0, const State& p1, const double& time) const;
 
+  /**
+   * @brief  Interpolates between the rows lower_id and lower_id + 1
+   *         and writes the result into interpolated
+   */
+  void Interpolate(const Trajectory& trajectory, int lower_id,
+                   const double& time, State* interpolated) const;
+
   /**
    * @brief  Interpolates on trajectory
    */
@@ -61,6 +78,10 @@ class ExecutionModelInterpolate : public ExecutionModel {
                        const dynamic::DynamicModelPtr dynamic_model);
 
   virtual std::shared_ptr<ExecutionModel> Clone() const;
+
+ private:
+  mutable int cursor_;
+  State interpolated_state_;
 };
 
 inline std::shared_ptr<ExecutionModel> ExecutionModelInterpolate::Clone()
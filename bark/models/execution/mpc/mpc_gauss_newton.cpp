@@ -0,0 +1,309 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/models/execution/mpc/mpc_gauss_newton.hpp"
+#include <algorithm>
+#include <cmath>
+#include "bark/geometry/angle.hpp"
+#include "bark/models/dynamic/single_track.hpp"
+
+namespace bark {
+namespace models {
+namespace execution {
+
+using bark::geometry::NormToPI;
+using dynamic::SingleTrackModel;
+using dynamic::StateDefinition;
+
+ExecutionModelMpcGaussNewton::ExecutionModelMpcGaussNewton(
+    const ParamsPtr& params)
+    : ExecutionModel(params),
+      num_steps_(params->GetInt("ExecutionModelMpc::NumOptimizationSteps",
+                                "Number of states of the MPC horizon", 20)),
+      dt_(params->GetReal("ExecutionModelMpc::OptimizationStepSize",
+                          "Time between two states of the MPC horizon [s]",
+                          0.1)),
+      weight_position_(params->GetReal("ExecutionModelMpc::WeightPosition",
+                                       "Weight of the position error", 100.)),
+      weight_theta_(params->GetReal("ExecutionModelMpc::WeightTheta",
+                                    "Weight of the orientation error", 100.)),
+      weight_velocity_(params->GetReal("ExecutionModelMpc::WeightVelocity",
+                                       "Weight of the velocity error", 1.)),
+      weight_acceleration_(
+          params->GetReal("ExecutionModelMpc::WeightAcceleration",
+                          "Weight of the acceleration input", 10.)),
+      weight_steering_(params->GetReal("ExecutionModelMpc::WeightSteering",
+                                       "Weight of the steering input", 1.)),
+      max_iterations_(params->GetInt("ExecutionModelMpc::MaxIterations",
+                                     "Maximum Gauss-Newton iterations", 20)),
+      tolerance_(params->GetReal(
+          "ExecutionModelMpc::Tolerance",
+          "Relative cost decrease at which the optimization stops", 1e-6)),
+      wheel_base_(params->GetReal("DynamicModel::WheelBase",
+                                  "Wheel base of vehicle [m]", 2.7)),
+      acc_min_(params->GetReal("DynamicModel::LonAccelerationMin",
+                               "Minimum longitudinal acceleration", -8.0)),
+      acc_max_(params->GetReal("DynamicModel::LonAccelerationMax",
+                               "Maximum longitudinal acceleration", 4.0)),
+      delta_max_(params->GetReal("DynamicModel::DeltaMax",
+                                 "Maximum Steering Angle [rad]", 0.2)),
+      last_start_time_(0.),
+      has_solution_(false),
+      last_num_iterations_(0),
+      last_cost_(0.) {
+  BARK_EXPECT_TRUE(num_steps_ > 1 && dt_ > 0.);
+  const int num_inputs = num_steps_ - 1;
+  inputs_.assign(num_inputs, MpcInput::Zero());
+  candidate_inputs_.assign(num_inputs, MpcInput::Zero());
+  states_.assign(num_steps_, MpcState::Zero());
+  candidate_states_.assign(num_steps_, MpcState::Zero());
+  reference_.assign(num_steps_, MpcState::Zero());
+  const int num_residuals = num_inputs * (kStateSize + kInputSize);
+  jacobian_.setZero(num_residuals, num_inputs * kInputSize);
+  residuals_.setZero(num_residuals);
+  hessian_.setZero(num_inputs * kInputSize, num_inputs * kInputSize);
+  gradient_.setZero(num_inputs * kInputSize);
+  step_.setZero(num_inputs * kInputSize);
+}
+
+void ExecutionModelMpcGaussNewton::SampleReference(
+    const Trajectory& trajectory, double start_time) {
+  // the reference times are increasing, so the row cursor only moves forward
+  int row = 0;
+  const int last_row = trajectory.rows() - 1;
+  for (int k = 0; k < num_steps_; ++k) {
+    const double t = start_time + k * dt_;
+    while (row < last_row &&
+           trajectory(row + 1, StateDefinition::TIME_POSITION) <= t) {
+      ++row;
+    }
+    double lambda = 0.;
+    if (row < last_row) {
+      const double t0 = trajectory(row, StateDefinition::TIME_POSITION);
+      const double t1 = trajectory(row + 1, StateDefinition::TIME_POSITION);
+      lambda = std::min(std::max((t - t0) / (t1 - t0), 0.), 1.);
+    }
+    const int next_row = std::min(row + 1, last_row);
+    const auto interpolate = [&](int col) {
+      return (1. - lambda) * trajectory(row, col) +
+             lambda * trajectory(next_row, col);
+    };
+    const double theta0 = trajectory(row, StateDefinition::THETA_POSITION);
+    const double delta_theta = NormToPI(
+        trajectory(next_row, StateDefinition::THETA_POSITION) - theta0);
+    reference_[k] << interpolate(StateDefinition::X_POSITION),
+        interpolate(StateDefinition::Y_POSITION),
+        theta0 + lambda * delta_theta,
+        interpolate(StateDefinition::VEL_POSITION);
+  }
+}
+
+void ExecutionModelMpcGaussNewton::WarmStart(double start_time) {
+  const int num_inputs = num_steps_ - 1;
+  const int shift =
+      static_cast<int>(std::round((start_time - last_start_time_) / dt_));
+  if (!has_solution_ || shift < 0 || shift >= num_inputs) {
+    std::fill(inputs_.begin(), inputs_.end(), MpcInput::Zero());
+    return;
+  }
+  // shift the previous solution and repeat its last input
+  std::rotate(inputs_.begin(), inputs_.begin() + shift, inputs_.end());
+  std::fill(inputs_.end() - shift, inputs_.end(),
+            inputs_[num_inputs - shift - 1]);
+}
+
+double ExecutionModelMpcGaussNewton::Rollout(
+    const MpcState& x0, const std::vector<MpcInput>& inputs,
+    std::vector<MpcState>* states) const {
+  const double sqrt_w_pos = std::sqrt(weight_position_);
+  const double sqrt_w_theta = std::sqrt(weight_theta_);
+  const double sqrt_w_vel = std::sqrt(weight_velocity_);
+  double cost = 0.;
+  (*states)[0] = x0;
+  for (int k = 0; k < num_steps_ - 1; ++k) {
+    const MpcState& x = (*states)[k];
+    const MpcInput& u = inputs[k];
+    MpcState& x_next = (*states)[k + 1];
+    x_next(0) = x(0) + dt_ * x(3) * cos(x(2));
+    x_next(1) = x(1) + dt_ * x(3) * sin(x(2));
+    x_next(2) = x(2) + dt_ * x(3) * tan(u(1)) / wheel_base_;
+    x_next(3) = x(3) + dt_ * u(0);
+
+    const MpcState& ref = reference_[k + 1];
+    const double ex = sqrt_w_pos * (x_next(0) - ref(0));
+    const double ey = sqrt_w_pos * (x_next(1) - ref(1));
+    const double etheta = sqrt_w_theta * NormToPI(x_next(2) - ref(2));
+    const double ev = sqrt_w_vel * (x_next(3) - ref(3));
+    cost += ex * ex + ey * ey + etheta * etheta + ev * ev;
+    cost += weight_acceleration_ * u(0) * u(0) +
+            weight_steering_ * u(1) * u(1);
+  }
+  return 0.5 * cost;
+}
+
+void ExecutionModelMpcGaussNewton::Linearize(
+    const std::vector<MpcState>& states, const std::vector<MpcInput>& inputs) {
+  const int num_inputs = num_steps_ - 1;
+  const int input_offset = num_inputs * kStateSize;
+  const MpcState state_weights(
+      std::sqrt(weight_position_), std::sqrt(weight_position_),
+      std::sqrt(weight_theta_), std::sqrt(weight_velocity_));
+  const MpcInput input_weights(std::sqrt(weight_acceleration_),
+                               std::sqrt(weight_steering_));
+
+  // residuals, state k + 1 occupies rows [kStateSize * k, kStateSize * (k+1))
+  for (int k = 0; k < num_inputs; ++k) {
+    MpcState error = states[k + 1] - reference_[k + 1];
+    error(2) = NormToPI(error(2));
+    residuals_.segment<kStateSize>(kStateSize * k) =
+        state_weights.cwiseProduct(error);
+    residuals_.segment<kInputSize>(input_offset + kInputSize * k) =
+        input_weights.cwiseProduct(inputs[k]);
+  }
+
+  // analytic sensitivities of the Euler-discretized single track model
+  jacobian_.setZero();
+  for (int j = 0; j < num_inputs; ++j) {
+    const MpcState& x_j = states[j];
+    const double cos_delta = cos(inputs[j](1));
+    InputJacobian sensitivity = InputJacobian::Zero();
+    sensitivity(2, 1) = dt_ * x_j(3) / (wheel_base_ * cos_delta * cos_delta);
+    sensitivity(3, 0) = dt_;
+    for (int k = j; k < num_inputs; ++k) {
+      if (k > j) {
+        const MpcState& x_k = states[k];
+        StateJacobian a = StateJacobian::Identity();
+        a(0, 2) = -dt_ * x_k(3) * sin(x_k(2));
+        a(0, 3) = dt_ * cos(x_k(2));
+        a(1, 2) = dt_ * x_k(3) * cos(x_k(2));
+        a(1, 3) = dt_ * sin(x_k(2));
+        a(2, 3) = dt_ * tan(inputs[k](1)) / wheel_base_;
+        sensitivity = a * sensitivity;
+      }
+      jacobian_.block<kStateSize, kInputSize>(kStateSize * k, kInputSize * j) =
+          state_weights.asDiagonal() * sensitivity;
+    }
+    jacobian_.block<kInputSize, kInputSize>(input_offset + kInputSize * j,
+                                            kInputSize * j) =
+        input_weights.asDiagonal();
+  }
+}
+
+void ExecutionModelMpcGaussNewton::Optimize(const MpcState& x0) {
+  const int num_inputs = num_steps_ - 1;
+  double cost = Rollout(x0, inputs_, &states_);
+  double damping = 1e-4;
+  last_num_iterations_ = 0;
+  for (int iter = 0; iter < max_iterations_; ++iter) {
+    ++last_num_iterations_;
+    Linearize(states_, inputs_);
+    hessian_.noalias() = jacobian_.transpose() * jacobian_;
+    hessian_.diagonal().array() += damping;
+    gradient_.noalias() = jacobian_.transpose() * residuals_;
+    solver_.compute(hessian_);
+    step_ = -solver_.solve(gradient_);
+
+    for (int k = 0; k < num_inputs; ++k) {
+      candidate_inputs_[k] = inputs_[k] + step_.segment<kInputSize>(
+                                              kInputSize * k);
+      candidate_inputs_[k](0) =
+          std::min(std::max(candidate_inputs_[k](0), acc_min_), acc_max_);
+      candidate_inputs_[k](1) =
+          std::min(std::max(candidate_inputs_[k](1), -delta_max_), delta_max_);
+    }
+    const double candidate_cost =
+        Rollout(x0, candidate_inputs_, &candidate_states_);
+    if (candidate_cost < cost) {
+      const double decrease = cost - candidate_cost;
+      std::swap(inputs_, candidate_inputs_);
+      std::swap(states_, candidate_states_);
+      cost = candidate_cost;
+      damping = std::max(damping * 0.1, 1e-9);
+      if (decrease <= tolerance_ * cost) {
+        break;
+      }
+    } else {
+      // reject the step and move towards gradient descent
+      damping *= 10.;
+      if (damping > 1e6) {
+        break;
+      }
+    }
+  }
+  last_cost_ = cost;
+}
+
+void ExecutionModelMpcGaussNewton::Execute(
+    const double& new_world_time, const dynamic::Trajectory& trajectory,
+    const dynamic::DynamicModelPtr dynamic_model) {
+  if (GetExecutionStatus() == ExecutionStatus::INVALID) {
+    LOG(INFO) << "ExecutionStatus was and still is invalid." << std::endl;
+    return;
+  }
+  if (trajectory.rows() < 2) {
+    LOG(INFO) << "Trajectory with " << trajectory.rows()
+              << " points cannot be tracked." << std::endl;
+    SetExecutionStatus(ExecutionStatus::INVALID);
+    return;
+  }
+  const double start_time = trajectory(0, StateDefinition::TIME_POSITION);
+  const double horizon_end = start_time + (num_steps_ - 1) * dt_;
+  if (new_world_time < start_time || new_world_time > horizon_end) {
+    LOG(INFO) << "World time " << new_world_time << " out of MPC horizon ["
+              << start_time << ", " << horizon_end << "]." << std::endl;
+    SetExecutionStatus(ExecutionStatus::INVALID);
+    return;
+  }
+  SetExecutionStatus(ExecutionStatus::VALID);
+
+  // take the limits from the dynamic model if available
+  const State current_state = trajectory.row(0);
+  auto single_track = std::dynamic_pointer_cast<SingleTrackModel>(
+      dynamic_model);
+  if (single_track) {
+    wheel_base_ = single_track->GetWheelBase();
+    delta_max_ = single_track->GetSteeringAngleMax();
+    acc_min_ = single_track->GetLonAccelerationMin(current_state);
+    acc_max_ = single_track->GetLonAccelerationMax(current_state);
+  }
+
+  const MpcState x0(current_state(StateDefinition::X_POSITION),
+                    current_state(StateDefinition::Y_POSITION),
+                    current_state(StateDefinition::THETA_POSITION),
+                    current_state(StateDefinition::VEL_POSITION));
+  SampleReference(trajectory, start_time);
+  WarmStart(start_time);
+  Optimize(x0);
+  last_start_time_ = start_time;
+  has_solution_ = true;
+
+  // optimized trajectory and the state at the new world time
+  Trajectory optimized_trajectory(
+      num_steps_, static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  for (int k = 0; k < num_steps_; ++k) {
+    optimized_trajectory(k, StateDefinition::TIME_POSITION) =
+        start_time + k * dt_;
+    optimized_trajectory(k, StateDefinition::X_POSITION) = states_[k](0);
+    optimized_trajectory(k, StateDefinition::Y_POSITION) = states_[k](1);
+    optimized_trajectory(k, StateDefinition::THETA_POSITION) = states_[k](2);
+    optimized_trajectory(k, StateDefinition::VEL_POSITION) = states_[k](3);
+  }
+  SetLastTrajectory(optimized_trajectory);
+
+  const double step = (new_world_time - start_time) / dt_;
+  const int lower_id = std::min(static_cast<int>(step), num_steps_ - 2);
+  const double lambda = step - lower_id;
+  State new_state = (1. - lambda) * optimized_trajectory.row(lower_id) +
+                    lambda * optimized_trajectory.row(lower_id + 1);
+  new_state(StateDefinition::TIME_POSITION) = new_world_time;
+  SetLastState(new_state);
+}
+
+}  // namespace execution
+}  // namespace models
+}  // namespace bark
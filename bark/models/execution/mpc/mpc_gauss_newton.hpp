@@ -0,0 +1,119 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_MODELS_EXECUTION_MPC_MPC_GAUSS_NEWTON_HPP_
+#define BARK_MODELS_EXECUTION_MPC_MPC_GAUSS_NEWTON_HPP_
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <memory>
+#include <vector>
+
+#include "bark/models/execution/execution_model.hpp"
+
+namespace bark {
+namespace models {
+namespace execution {
+
+using bark::commons::ParamsPtr;
+using dynamic::DynamicModelPtr;
+using dynamic::State;
+using dynamic::Trajectory;
+
+/**
+ * @brief Fixed-horizon MPC tracking the behavior trajectory
+ *
+ * Optimizes acceleration and steering angle of the kinematic single track
+ * model over a fixed horizon with a damped Gauss-Newton method. The
+ * Jacobians are derived analytically with fixed-size matrices, and each
+ * step is warm-started from the shifted solution of the previous step.
+ */
+class ExecutionModelMpcGaussNewton : public ExecutionModel {
+ public:
+  static constexpr int kStateSize = 4;  // x, y, theta, v
+  static constexpr int kInputSize = 2;  // acceleration, steering angle
+  typedef Eigen::Matrix<double, kStateSize, 1> MpcState;
+  typedef Eigen::Matrix<double, kInputSize, 1> MpcInput;
+  typedef Eigen::Matrix<double, kStateSize, kStateSize> StateJacobian;
+  typedef Eigen::Matrix<double, kStateSize, kInputSize> InputJacobian;
+
+  explicit ExecutionModelMpcGaussNewton(const ParamsPtr& params);
+  ~ExecutionModelMpcGaussNewton() {}
+
+  /**
+   * @brief  Tracks the trajectory starting at its first row and sets the
+   *         optimized state at new_world_time
+   */
+  virtual void Execute(const double& new_world_time,
+                       const dynamic::Trajectory& trajectory,
+                       const dynamic::DynamicModelPtr dynamic_model);
+
+  virtual std::shared_ptr<ExecutionModel> Clone() const;
+
+  const std::vector<MpcInput>& GetLastInputs() const { return inputs_; }
+  int GetLastNumIterations() const { return last_num_iterations_; }
+  double GetLastCost() const { return last_cost_; }
+
+ private:
+  void SampleReference(const Trajectory& trajectory, double start_time);
+  void WarmStart(double start_time);
+  double Rollout(const MpcState& x0, const std::vector<MpcInput>& inputs,
+                 std::vector<MpcState>* states) const;
+  void Linearize(const std::vector<MpcState>& states,
+                 const std::vector<MpcInput>& inputs);
+  void Optimize(const MpcState& x0);
+
+  // parameters
+  int num_steps_;
+  double dt_;
+  double weight_position_;
+  double weight_theta_;
+  double weight_velocity_;
+  double weight_acceleration_;
+  double weight_steering_;
+  int max_iterations_;
+  double tolerance_;
+
+  // limits of the dynamic model of the last execution
+  double wheel_base_;
+  double acc_min_;
+  double acc_max_;
+  double delta_max_;
+
+  // solution of the last step, used for warm-starting
+  std::vector<MpcInput> inputs_;
+  std::vector<MpcState> states_;
+  double last_start_time_;
+  bool has_solution_;
+  int last_num_iterations_;
+  double last_cost_;
+
+  // preallocated work space
+  std::vector<MpcState> reference_;
+  std::vector<MpcInput> candidate_inputs_;
+  std::vector<MpcState> candidate_states_;
+  Eigen::MatrixXd jacobian_;
+  Eigen::VectorXd residuals_;
+  Eigen::MatrixXd hessian_;
+  Eigen::VectorXd gradient_;
+  Eigen::VectorXd step_;
+  Eigen::LDLT<Eigen::MatrixXd> solver_;
+};
+
+inline std::shared_ptr<ExecutionModel> ExecutionModelMpcGaussNewton::Clone()
+    const {
+  std::shared_ptr<ExecutionModelMpcGaussNewton> model_ptr =
+      std::make_shared<ExecutionModelMpcGaussNewton>(*this);
+  return std::dynamic_pointer_cast<ExecutionModel>(model_ptr);
+}
+
+}  // namespace execution
+}  // namespace models
+}  // namespace bark
+
+#endif  // BARK_MODELS_EXECUTION_MPC_MPC_GAUSS_NEWTON_HPP_
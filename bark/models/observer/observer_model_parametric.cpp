@@ -30,12 +30,17 @@ ObserverModelParametric::ObserverModelParametric(bark::commons::ParamsPtr params
   others_state_deviation_dist_(params->GetDistribution("ObserverModelParametric::OtherStateDeviationDist",
                                   "From what distribution is the others frenet state deviation"
                                   "sampled, must have dimension = 5",
-                                  "MultivariateDistribution")) {}
+                                  "MultivariateDistribution")),
+  counter_based_random_streams_(params->GetBool(
+      "ObserverModelParametric::CounterBasedRandomStreams",
+      "If true, deviations are drawn from random streams keyed by world time "
+      "and agent ids, which is reproducible in parallel simulations", false)) {}
 
 ObserverModelParametric::ObserverModelParametric(const ObserverModelParametric& observer_model) :
       ObserverModel(observer_model.GetParams()),
       ego_state_deviation_dist_(observer_model.ego_state_deviation_dist_),
-      others_state_deviation_dist_(observer_model.others_state_deviation_dist_) {}
+      others_state_deviation_dist_(observer_model.others_state_deviation_dist_),
+      counter_based_random_streams_(observer_model.counter_based_random_streams_) {}
 
 
 ObservedWorld ObserverModelParametric::Observe(
@@ -44,23 +49,37 @@ ObservedWorld ObserverModelParametric::Observe(
   // Clone world here since otherwise we change global world state
   auto observed_world = ObservedWorld(world->Clone(), agent_id);
 
-  AddStateDeviationFrenet(observed_world.GetEgoAgent(), ego_state_deviation_dist_);
+  // the stream key is only used with counter-based random streams
+  RandomStreamKey key{WorldTimeToTimeStep(world->GetWorldTime()), agent_id,
+                      RandomStreamPurpose("ObserverModelParametric", agent_id)};
+  const RandomStreamKey* stream_key =
+      counter_based_random_streams_ ? &key : nullptr;
+  AddStateDeviationFrenet(observed_world.GetEgoAgent(),
+                          ego_state_deviation_dist_, stream_key);
   for (auto& agent : observed_world.GetOtherAgents()) {
-    AddStateDeviationFrenet(agent.second, others_state_deviation_dist_);
+    key.agent_id = agent.first;
+    AddStateDeviationFrenet(agent.second, others_state_deviation_dist_,
+                            stream_key);
   }
 
+  // spatial queries have to see the deviated states
+  observed_world.UpdateAgentRTree();
   return observed_world;
 }
 
-void ObserverModelParametric::AddStateDeviationFrenet(const AgentPtr& agent, const DistributionPtr& multi_dim_distribution) const {
+void ObserverModelParametric::AddStateDeviationFrenet(
+    const AgentPtr& agent, const DistributionPtr& multi_dim_distribution,
+    const RandomStreamKey* key) const {
   // Get Current Frenet State of Agent
   const Point2d pos = agent->GetCurrentPosition();
   const auto& lane_corridor = agent->GetRoadCorridor()->GetCurrentLaneCorridor(pos);
   BARK_EXPECT_TRUE(bool(lane_corridor));
-  FrenetState current_frenet_state(agent->GetCurrentState(), lane_corridor->GetCenterLine());
+  FrenetState current_frenet_state =
+      agent->CurrentFrenetState(lane_corridor->GetCenterLine());
 
   // Add sampled frenet deviation to current frenet state
-  const auto frenet_deviation = multi_dim_distribution->Sample();
+  const auto frenet_deviation = key ? multi_dim_distribution->Sample(*key)
+                                    : multi_dim_distribution->Sample();
   BARK_EXPECT_TRUE(frenet_deviation.size() == 5); // Lat, Long, vlat, vlon, Orientation
 
   current_frenet_state.lon += frenet_deviation[0];
@@ -53,9 +53,12 @@ class ObserverModelParametric : public ObserverModel {
 
  private:
   void AddStateDeviationFrenet(const AgentPtr& agent,
-                         const DistributionPtr& multi_dim_distribution) const;
+                         const DistributionPtr& multi_dim_distribution,
+                         const bark::commons::RandomStreamKey* key) const;
   const DistributionPtr ego_state_deviation_dist_;
   const DistributionPtr others_state_deviation_dist_;
+  // draws keyed by world time, observed and observing agent if true
+  bool counter_based_random_streams_;
 };
 
 }  // namespace observer
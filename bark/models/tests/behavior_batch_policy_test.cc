@@ -0,0 +1,89 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/models/behavior/batch_policy/behavior_batch_policy.hpp"
+#include "bark/world/observed_world.hpp"
+#include "bark/world/tests/make_test_world.hpp"
+
+using bark::commons::SetterParams;
+using bark::models::behavior::BatchPolicy;
+using bark::models::behavior::BatchPolicyBehavior;
+using bark::models::behavior::BehaviorBatchPolicy;
+using bark::models::behavior::BehaviorModelPtr;
+using bark::models::dynamic::StateDefinition;
+using bark::world::ObservedWorld;
+using bark::world::WorldPtr;
+
+class CountingPolicy : public BatchPolicy {
+ public:
+  Eigen::MatrixXd Act(const Eigen::MatrixXd& observations) {
+    batch_sizes.push_back(observations.rows());
+    last_observations = observations;
+    Eigen::MatrixXd actions(observations.rows(), 2);
+    actions.col(0).setConstant(1.0);  // acceleration
+    actions.col(1).setZero();         // steering angle
+    return actions;
+  }
+
+  std::vector<int> batch_sizes;
+  Eigen::MatrixXd last_observations;
+};
+
+TEST(behavior_batch_policy, plan_agents_calls_policy_once) {
+  WorldPtr world = bark::world::tests::MakeTestWorldHighway();
+  auto params = std::make_shared<SetterParams>();
+  auto policy = std::make_shared<CountingPolicy>();
+  for (int id = 1; id <= 3; ++id) {
+    world->GetAgent(id)->SetBehaviorModel(
+        std::make_shared<BehaviorBatchPolicy>(params, policy));
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    world->Step(0.2);
+  }
+
+  // one call per step containing all agents of the policy
+  ASSERT_EQ(policy->batch_sizes, std::vector<int>({3, 3, 3}));
+  EXPECT_EQ(policy->last_observations.cols(), 4 * 5);
+  for (int id = 1; id <= 3; ++id) {
+    EXPECT_NEAR(world->GetAgent(id)->GetCurrentState()(
+                    StateDefinition::VEL_POSITION),
+                5.6, 0.05);
+  }
+  EXPECT_NEAR(
+      world->GetAgent(4)->GetCurrentState()(StateDefinition::VEL_POSITION),
+      5.0, 1e-6);
+}
+
+TEST(behavior_batch_policy, plan_without_world) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetInt("BehaviorBatchPolicy::NumNearestAgents", 2);
+  auto policy = std::make_shared<CountingPolicy>();
+  BehaviorModelPtr model = std::make_shared<BehaviorBatchPolicy>(params,
+                                                                 policy);
+  BehaviorModelPtr cloned_model = model->Clone();
+  EXPECT_EQ(std::dynamic_pointer_cast<BatchPolicyBehavior>(cloned_model)
+                ->GetBatchPolicy(),
+            policy);
+
+  ObservedWorld observed_world =
+      bark::world::tests::make_test_observed_world(1, 10.0, 5.0, 0.0);
+  const auto traj = cloned_model->Plan(0.2, observed_world);
+  ASSERT_EQ(policy->batch_sizes, std::vector<int>({1}));
+  ASSERT_EQ(policy->last_observations.cols(), 4 * 3);
+  // relative x-position of the agent in front
+  EXPECT_GT(policy->last_observations(0, 4), 10.0);
+  EXPECT_NEAR(policy->last_observations(0, 8), 0.0, 1e-9);
+  EXPECT_GT(traj(traj.rows() - 1, StateDefinition::VEL_POSITION), 5.0);
+}
@@ -15,6 +15,7 @@
 #include "bark/geometry/polygon.hpp"
 #include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
 #include "bark/models/behavior/idm/idm_classic.hpp"
+#include "bark/models/behavior/idm/stochastic/idm_stochastic.hpp"
 #include "bark/models/execution/interpolation/interpolate.hpp"
 #include "bark/world/observed_world.hpp"
 #include "bark/world/tests/make_test_world.hpp"
@@ -487,7 +488,24 @@ TEST(CalcNetDistance, behavior_idm_classic) {
   EXPECT_EQ(distance, distance_expected);
 }
 
+TEST(sample_parameters_clone, behavior_idm_stochastic) {
+  auto params = std::make_shared<SetterParams>();
+  params->SetInt("BehaviorIDMStochastic::SampleBatchSize", 8);
+  BehaviorIDMStochastic behavior(params);
+  behavior.SampleParameters();
+  auto behavior_clone =
+      std::dynamic_pointer_cast<BehaviorIDMStochastic>(behavior.Clone());
+
+  // the clone does not replay the parameter sets drawn ahead by the original
+  behavior.SampleParameters();
+  behavior_clone->SampleParameters();
+  EXPECT_NE(behavior_clone->GetDesiredVelocity(),
+            behavior.GetDesiredVelocity());
+  EXPECT_NE(behavior_clone->GetDesiredTimeHeadway(),
+            behavior.GetDesiredTimeHeadway());
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
@@ -161,6 +161,82 @@ TEST(primitive_constant_acceleration, behavior_test) {
       0.1);
 }
 
+TEST(primitive_trajectory_cache, behavior_test) {
+  using bark::models::behavior::primitives::AdjacentLaneCorridors;
+  using bark::models::behavior::primitives::PrimitiveConstAccStayLane;
+  auto params = std::make_shared<SetterParams>();
+  PrimitiveConstAccStayLane uncached_primitive(params, 1.0);
+  EXPECT_FALSE(uncached_primitive.GetTrajectoryCache());
+
+  params->SetBool("PrimitiveTrajectoryCache::Enabled", true);
+  DynamicModelPtr dynamics(new SingleTrackModel(params));
+  PrimitiveConstAccStayLane primitive(params, 1.0);
+  auto cache = primitive.GetTrajectoryCache();
+  ASSERT_TRUE(cache);
+
+  auto world1 = make_test_observed_world(0, 0.0, 5.0, 0.0);
+  std::const_pointer_cast<Agent>(world1.GetEgoAgent())
+      ->SetDynamicModel(dynamics);
+  AdjacentLaneCorridors corridors = GetCorridors(world1);
+  auto expected_traj = uncached_primitive.Plan(0.5, world1, corridors.current);
+  auto traj1 = primitive.Plan(0.5, world1, corridors.current);
+  EXPECT_EQ(cache->GetNumMisses(), 1);
+  EXPECT_EQ(cache->GetNumHits(), 0);
+  EXPECT_TRUE(traj1.isApprox(expected_traj));
+
+  // same quantized state, the cached trajectory is re-anchored
+  auto traj2 = primitive.Plan(0.5, world1, corridors.current);
+  EXPECT_EQ(cache->GetNumHits(), 1);
+  EXPECT_TRUE(traj2.isApprox(expected_traj, 1e-6));
+  EXPECT_TRUE(boost::get<Input>(primitive.Primitive::GetLastAction())
+                  .isApprox(boost::get<Input>(
+                      uncached_primitive.Primitive::GetLastAction())));
+
+  // primitives can share a cache, different accelerations are different keys
+  PrimitiveConstAccStayLane acc_primitive(params, 2.0);
+  acc_primitive.SetTrajectoryCache(cache);
+  acc_primitive.Plan(0.5, world1, corridors.current);
+  EXPECT_EQ(cache->GetNumMisses(), 2);
+  EXPECT_EQ(cache->GetSize(), 2);
+
+  cache->Clear();
+  EXPECT_EQ(cache->GetSize(), 0);
+}
+
+TEST(primitive_trajectory_cache, gap_keeping_test) {
+  using bark::models::behavior::primitives::AdjacentLaneCorridors;
+  using bark::models::behavior::primitives::PrimitiveGapKeeping;
+  auto params = std::make_shared<SetterParams>();
+  params->SetBool("PrimitiveTrajectoryCache::Enabled", true);
+  DynamicModelPtr dynamics(new SingleTrackModel(params));
+  PrimitiveGapKeeping primitive(params);
+  auto cache = primitive.GetTrajectoryCache();
+  ASSERT_TRUE(cache);
+
+  auto world1 = make_test_observed_world(1, 10.0, 5.0, 0.0);
+  std::const_pointer_cast<Agent>(world1.GetEgoAgent())
+      ->SetDynamicModel(dynamics);
+  AdjacentLaneCorridors corridors = GetCorridors(world1);
+  primitive.Plan(0.5, world1, corridors.current);
+  EXPECT_EQ(cache->GetNumMisses(), 1);
+
+  // the leading velocity is quantized with the velocity resolution, not
+  // with the longitudinal resolution
+  auto world2 = make_test_observed_world(1, 10.0, 5.0, 0.2);
+  std::const_pointer_cast<Agent>(world2.GetEgoAgent())
+      ->SetDynamicModel(dynamics);
+  PrimitiveGapKeeping primitive2(params);
+  primitive2.SetTrajectoryCache(cache);
+  primitive2.Plan(0.5, world2, GetCorridors(world2).current);
+  EXPECT_EQ(cache->GetNumMisses(), 2);
+  EXPECT_EQ(cache->GetNumHits(), 0);
+
+  PrimitiveGapKeeping primitive3(params);
+  primitive3.SetTrajectoryCache(cache);
+  primitive3.Plan(0.5, world2, GetCorridors(world2).current);
+  EXPECT_EQ(cache->GetNumHits(), 1);
+}
+
 TEST(primitive_change_left, behavior_test) {
   using bark::models::behavior::primitives::PrimitiveConstAccChangeToLeft;
   auto params = std::make_shared<SetterParams>();
@@ -151,6 +151,46 @@ TEST(behavior_static_trajectory, clone) {
   ASSERT_EQ(BehaviorStatus::EXPIRED, cloned_model->GetBehaviorStatus());
 }
 
+TEST(behavior_static_trajectory, shared_storage) {
+  Trajectory static_traj(4, static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  static_traj << 0, 0, 0, 0, 1, 1, 1, 0, 0, 1, 2, 2, 0, 0, 1, 3, 3, 0, 0, 1;
+
+  auto model = std::make_shared<BehaviorStaticTrajectory>(nullptr, static_traj);
+  auto cloned_model =
+      std::dynamic_pointer_cast<BehaviorStaticTrajectory>(model->Clone());
+  EXPECT_EQ(model->GetSharedStaticTrajectory(),
+            cloned_model->GetSharedStaticTrajectory());
+  EXPECT_EQ(static_traj, cloned_model->GetStaticTrajectory());
+}
+
+TEST(behavior_static_trajectory_plan, long_trajectory) {
+  const int num_rows = 1000;
+  const double dt = 0.1;
+  Trajectory static_traj(num_rows,
+                         static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  for (int i = 0; i < num_rows; ++i) {
+    static_traj.row(i) << i * dt, i * dt, 0, 0, 1;
+  }
+  BehaviorStaticTrajectory model(nullptr, static_traj);
+  auto observed_world =
+      bark::world::tests::make_test_observed_world(0, 0, 0, 0);
+
+  // steps forward use the cached segment, the jump back a binary search
+  for (double start : {0.0, 12.34, 12.54, 50.0, 3.05}) {
+    observed_world.SetWorldTime(start);
+    Trajectory traj = model.Plan(0.2, observed_world);
+    ASSERT_GE(traj.rows(), 2);
+    EXPECT_NEAR(start, traj(0, StateDefinition::TIME_POSITION), 1e-9);
+    EXPECT_NEAR(start, traj(0, StateDefinition::X_POSITION), 1e-9);
+    EXPECT_NEAR(start + 0.2,
+                traj(traj.rows() - 1, StateDefinition::X_POSITION), 1e-9);
+    for (int i = 1; i < traj.rows(); ++i) {
+      EXPECT_GT(traj(i, StateDefinition::TIME_POSITION),
+                traj(i - 1, StateDefinition::TIME_POSITION) - 1e-9);
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -6,8 +6,10 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <chrono>
 #include "bark/models/dynamic/single_track.hpp"
 #include "bark/models/execution/interpolation/interpolate.hpp"
+#include "bark/models/execution/mpc/mpc_gauss_newton.hpp"
 #include "gtest/gtest.h"
 //#include "bark/models/execution/mpc/mpc.hpp"
 #include "bark/commons/params/setter_params.hpp"
@@ -50,6 +52,136 @@ TEST(execution_model, execution_model_interpolate) {
   //   EXPECT_NEAR(next_state3(StateDefinition::Y_POSITION),0.9,0.001);
 }
 
+TEST(execution_model, execution_model_interpolate_lookup) {
+  auto params = std::make_shared<SetterParams>();
+
+  Trajectory test_trajectory(11, (int)StateDefinition::MIN_STATE_SIZE);
+  test_trajectory.setZero();
+  test_trajectory.col(StateDefinition::TIME_POSITION) =
+      Eigen::ArrayXd::LinSpaced(11, 0, 10);
+  test_trajectory.col(StateDefinition::X_POSITION) =
+      Eigen::ArrayXd::LinSpaced(11, 0, 20);
+  ExecutionModelInterpolate exec_model(params);
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, 4.5), 4);
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, 4.7), 4);
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, 5.0), 5);
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, 0.2), 0);
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, 10.0), 10);
+  EXPECT_EQ(exec_model.FindLowerTrajectoryRow(test_trajectory, -1.0), 0);
+  EXPECT_FALSE(
+      exec_model.FindClosestLowerTrajectoryRow(test_trajectory, -1.0).second);
+  EXPECT_EQ(
+      exec_model.FindClosestLowerTrajectoryRow(test_trajectory, 9.5).first, 9);
+  EXPECT_TRUE(
+      exec_model.CheckIfTimeExactIsInTrajectory(test_trajectory, 7.0).second);
+  EXPECT_FALSE(
+      exec_model.CheckIfTimeExactIsInTrajectory(test_trajectory, 7.5).second);
+
+  for (double t : {0.5, 4.0, 0.9, 9.99, 10.0}) {
+    exec_model.Execute(t, test_trajectory, dyn_model);
+    EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::VALID);
+    State state = exec_model.GetExecutedState();
+    EXPECT_NEAR(state(StateDefinition::TIME_POSITION), t, 1e-9);
+    EXPECT_NEAR(state(StateDefinition::X_POSITION), 2 * t, 1e-9);
+  }
+}
+
+TEST(execution_model, execution_model_interpolate_benchmark) {
+  // long trajectories as produced by search-based planners
+  auto params = std::make_shared<SetterParams>();
+  const int num_rows = 10000;
+  const int num_lookups = 100000;
+  Trajectory test_trajectory(num_rows, (int)StateDefinition::MIN_STATE_SIZE);
+  test_trajectory.setZero();
+  test_trajectory.col(StateDefinition::TIME_POSITION) =
+      Eigen::ArrayXd::LinSpaced(num_rows, 0, num_rows - 1) * 0.1;
+  test_trajectory.col(StateDefinition::X_POSITION) =
+      Eigen::ArrayXd::LinSpaced(num_rows, 0, num_rows - 1);
+  ExecutionModelInterpolate exec_model(params);
+  const double end_time =
+      test_trajectory(num_rows - 1, StateDefinition::TIME_POSITION);
+
+  State interpolated;
+  double sum_x = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_lookups; ++i) {
+    // monotonic queries as in a simulation
+    const double t = end_time * i / num_lookups;
+    const int lower_id = exec_model.FindLowerTrajectoryRow(test_trajectory, t);
+    exec_model.Interpolate(test_trajectory, lower_id, t, &interpolated);
+    sum_x += interpolated(StateDefinition::X_POSITION) - 10.0 * t;
+  }
+  auto sequential_time = std::chrono::steady_clock::now() - start;
+  EXPECT_NEAR(sum_x, 0.0, 1e-6);
+
+  sum_x = 0.0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_lookups; ++i) {
+    // scattered queries, a binary search each
+    const double t = end_time * ((i * 7919) % num_lookups) / num_lookups;
+    const int lower_id = exec_model.FindLowerTrajectoryRow(test_trajectory, t);
+    exec_model.Interpolate(test_trajectory, lower_id, t, &interpolated);
+    sum_x += interpolated(StateDefinition::X_POSITION) - 10.0 * t;
+  }
+  auto scattered_time = std::chrono::steady_clock::now() - start;
+  EXPECT_NEAR(sum_x, 0.0, 1e-6);
+
+  std::cout << num_lookups << " lookups in " << num_rows << " rows: "
+            << std::chrono::duration<double, std::milli>(sequential_time)
+                   .count()
+            << " ms sequential, "
+            << std::chrono::duration<double, std::milli>(scattered_time)
+                   .count()
+            << " ms scattered" << std::endl;
+}
+
+TEST(execution_model, execution_model_mpc_gauss_newton) {
+  auto params = std::make_shared<SetterParams>();
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  ExecutionModelMpcGaussNewton exec_model(params);
+
+  // circular arc with constant velocity and yaw rate
+  const int num_rows = 61;
+  const double velocity = 5.0, yaw_rate = 0.2;
+  Trajectory trajectory(num_rows, (int)StateDefinition::MIN_STATE_SIZE);
+  for (int i = 0; i < num_rows; ++i) {
+    const double t = i * 0.1;
+    const double theta = yaw_rate * t;
+    trajectory.row(i) << t, velocity / yaw_rate * sin(theta),
+        velocity / yaw_rate * (1 - cos(theta)), theta, velocity;
+  }
+
+  exec_model.Execute(0.2, trajectory, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::VALID);
+  State state = exec_model.GetExecutedState();
+  EXPECT_NEAR(state(StateDefinition::TIME_POSITION), 0.2, 1e-9);
+  EXPECT_NEAR(state(StateDefinition::X_POSITION), trajectory(2, 1), 0.05);
+  EXPECT_NEAR(state(StateDefinition::Y_POSITION), trajectory(2, 2), 0.05);
+  EXPECT_NEAR(state(StateDefinition::VEL_POSITION), velocity, 0.1);
+  const int cold_iterations = exec_model.GetLastNumIterations();
+
+  // the next step starts from the shifted solution
+  Trajectory shifted = trajectory.bottomRows(num_rows - 2);
+  exec_model.Execute(0.4, shifted, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::VALID);
+  state = exec_model.GetExecutedState();
+  EXPECT_NEAR(state(StateDefinition::X_POSITION), trajectory(4, 1), 0.05);
+  EXPECT_NEAR(state(StateDefinition::Y_POSITION), trajectory(4, 2), 0.05);
+  EXPECT_LE(exec_model.GetLastNumIterations(), cold_iterations);
+
+  // outside of the horizon
+  exec_model.Execute(10.0, shifted, dyn_model);
+  EXPECT_EQ(exec_model.GetExecutionStatus(), ExecutionStatus::INVALID);
+
+  // too short to be tracked
+  ExecutionModelMpcGaussNewton empty_exec_model(params);
+  Trajectory empty_trajectory(0, (int)StateDefinition::MIN_STATE_SIZE);
+  empty_exec_model.Execute(0.2, empty_trajectory, dyn_model);
+  EXPECT_EQ(empty_exec_model.GetExecutionStatus(), ExecutionStatus::INVALID);
+}
+
 /*
 TEST(execution_model, execution_model_mpc) {
 
@@ -21,7 +21,8 @@ from bark.core.world import World
 from bark.runtime.commons.parameters import ParameterServer
 from bark.runtime.runtime import Runtime
 from bark.runtime.viewer.matplotlib_viewer import MPViewer
-from bark.core.models.behavior import BehaviorModel, BehaviorDynamicModel
+from bark.core.models.behavior import BehaviorModel, BehaviorDynamicModel, \
+  BatchPolicy, BehaviorBatchPolicy
 from bark.core.models.dynamic import SingleTrackModel
 
 
@@ -69,6 +70,20 @@ class PythonBehaviorModelWrapperInheritance(BehaviorModel):
     return self
 
 
+class PythonBatchPolicy(BatchPolicy):
+  """Dummy batched policy that accelerates all agents
+  """
+  def __init__(self):
+    BatchPolicy.__init__(self)
+    self.batch_sizes = []
+
+  def Act(self, observations):
+    self.batch_sizes.append(observations.shape[0])
+    actions = np.zeros((observations.shape[0], 2))
+    actions[:, 0] = 1.
+    return actions
+
+
 class PyBehaviorModelTests(unittest.TestCase):
   def test_python_model(self):
     param_server = ParameterServer(
@@ -114,6 +129,26 @@ class PyBehaviorModelTests(unittest.TestCase):
       np.array([1., 1.], dtype=np.float32))
     world.Step(0.2)
 
+  def test_python_batch_policy(self):
+    param_server = ParameterServer(
+      filename= os.path.join(os.path.dirname(__file__),"../../runtime/tests/data/deterministic_scenario.json"))
+    mapfile = os.path.join(os.path.dirname(__file__),"../../runtime/tests/data/city_highway_straight.xodr")
+    param_server["Scenario"]["Generation"]["DeterministicScenarioGeneration"]["MapFilename"] = mapfile
+
+    scenario_generation = DeterministicScenarioGeneration(num_scenarios=3,
+                                                          random_seed=0,
+                                                          params=param_server)
+    scenario, idx = scenario_generation.get_next_scenario()
+    world = scenario.GetWorldState()
+    policy = PythonBatchPolicy()
+    for agent_id in world.agents:
+      world.GetAgent(agent_id).behavior_model = \
+        BehaviorBatchPolicy(param_server, policy)
+    world.Step(0.2)
+    world.Step(0.2)
+    # one Python call per step for all agents
+    self.assertEqual(policy.batch_sizes, [len(world.agents)] * 2)
+
 
 if __name__ == '__main__':
   unittest.main()
\ No newline at end of file
@@ -0,0 +1,125 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "benchmark.hpp"
+#include "bark/benchmark/benchmark_executor.hpp"
+#include "bark/benchmark/result_store.hpp"
+
+namespace py = pybind11;
+using namespace bark::benchmark;
+
+void python_benchmark(py::module m) {
+  py::enum_<TerminalOperator>(m, "TerminalOperator", py::arithmetic())
+      .value("IS_TRUE", TerminalOperator::IS_TRUE)
+      .value("GREATER", TerminalOperator::GREATER)
+      .value("GREATER_EQUAL", TerminalOperator::GREATER_EQUAL)
+      .value("LESS", TerminalOperator::LESS)
+      .value("LESS_EQUAL", TerminalOperator::LESS_EQUAL)
+      .value("EQUAL", TerminalOperator::EQUAL)
+      .export_values();
+
+  py::class_<TerminalCondition>(m, "TerminalCondition")
+      .def(py::init<TerminalOperator, double>(),
+           py::arg("op") = TerminalOperator::IS_TRUE,
+           py::arg("threshold") = 0.0)
+      .def("__call__", &TerminalCondition::IsSatisfied)
+      .def_readonly("op", &TerminalCondition::op)
+      .def_readonly("threshold", &TerminalCondition::threshold)
+      .def("__repr__",
+           [](const TerminalCondition& c) {
+             return "bark.core.benchmark.TerminalCondition";
+           })
+      .def(py::pickle(
+          [](const TerminalCondition& c) {
+            return py::make_tuple(static_cast<unsigned int>(c.op),
+                                  c.threshold);
+          },
+          [](py::tuple t) {
+            if (t.size() != 2)
+              throw std::runtime_error("Invalid terminal condition state!");
+            return TerminalCondition(
+                static_cast<TerminalOperator>(t[0].cast<unsigned int>()),
+                t[1].cast<double>());
+          }));
+
+  py::class_<EpisodeResult>(m, "EpisodeResult")
+      .def_readonly("steps", &EpisodeResult::steps)
+      .def_readonly("terminal_reasons", &EpisodeResult::terminal_reasons)
+      .def_readonly("evaluation", &EpisodeResult::evaluation)
+      .def_readonly("exception_message", &EpisodeResult::exception_message)
+      .def("ExceptionRaised", &EpisodeResult::ExceptionRaised);
+
+  py::enum_<ColumnType>(m, "ColumnType", py::arithmetic())
+      .value("BOOL", ColumnType::BOOL)
+      .value("INT", ColumnType::INT)
+      .value("DOUBLE", ColumnType::DOUBLE)
+      .value("STRING", ColumnType::STRING)
+      .export_values();
+
+  // values are exchanged as numpy arrays, only strings as lists
+  py::class_<Column>(m, "Column")
+      .def(py::init([](const std::string& name, ColumnType type,
+                       const std::vector<uint8_t>& valid,
+                       const std::vector<int64_t>& ints,
+                       const std::vector<double>& doubles,
+                       const std::vector<std::string>& strings) {
+             return Column{name, type, valid, ints, doubles, strings};
+           }),
+           py::arg("name"), py::arg("type"), py::arg("valid"),
+           py::arg("ints") = std::vector<int64_t>(),
+           py::arg("doubles") = std::vector<double>(),
+           py::arg("strings") = std::vector<std::string>())
+      .def_readonly("name", &Column::name)
+      .def_readonly("type", &Column::type)
+      .def_property_readonly("valid",
+                             [](const Column& c) {
+                               return py::array_t<bool>(
+                                   c.valid.size(),
+                                   reinterpret_cast<const bool*>(
+                                       c.valid.data()));
+                             })
+      .def_property_readonly("ints",
+                             [](const Column& c) {
+                               return py::array_t<int64_t>(c.ints.size(),
+                                                           c.ints.data());
+                             })
+      .def_property_readonly("doubles",
+                             [](const Column& c) {
+                               return py::array_t<double>(c.doubles.size(),
+                                                          c.doubles.data());
+                             })
+      .def_readonly("strings", &Column::strings)
+      .def("__len__", &Column::Size);
+
+  py::class_<ResultStoreWriter>(m, "ResultStoreWriter")
+      .def(py::init<const std::string&>())
+      .def("AppendChunk", &ResultStoreWriter::AppendChunk,
+           py::call_guard<py::gil_scoped_release>())
+      .def_property_readonly("filename", &ResultStoreWriter::GetFilename);
+
+  py::class_<ResultStoreReader>(m, "ResultStoreReader")
+      .def(py::init<const std::string&>())
+      .def("ReadColumn", &ResultStoreReader::ReadColumn,
+           py::call_guard<py::gil_scoped_release>())
+      .def("HasColumn", &ResultStoreReader::HasColumn)
+      .def_property_readonly("column_names",
+                             &ResultStoreReader::GetColumnNames)
+      .def_property_readonly("num_rows", &ResultStoreReader::GetNumRows)
+      .def_property_readonly("num_chunks", &ResultStoreReader::GetNumChunks);
+
+  py::class_<BenchmarkExecutor>(m, "BenchmarkExecutor")
+      .def(py::init<const TerminalConditions&, double, int>(),
+           py::arg("terminal_conditions"), py::arg("step_time"),
+           py::arg("max_steps") = 10000)
+      .def("Run", &BenchmarkExecutor::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def_property_readonly("terminal_conditions",
+                             &BenchmarkExecutor::GetTerminalConditions)
+      .def_property_readonly("step_time", &BenchmarkExecutor::GetStepTime)
+      .def_property_readonly("max_steps", &BenchmarkExecutor::GetMaxSteps);
+}
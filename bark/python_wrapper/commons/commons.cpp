@@ -10,6 +10,7 @@
 #include "bark/commons/base_type.hpp"
 #include "bark/commons/params/setter_params.hpp"
 #include "bark/commons/transformation/frenet.hpp"
+#include "bark/commons/transformation/frenet_cache.hpp"
 #include "bark/python_wrapper/polymorphic_conversion.hpp"
 #include "bark/python_wrapper/tests/logging_tests.hpp"
 #include "bark/runtime/tests/py_param_server_test_helper.hpp"
@@ -74,6 +75,16 @@ void python_commons(py::module m) {
       .def_readwrite("vlat", &transformation::FrenetState::vlat)
       .def_readwrite("angle", &transformation::FrenetState::angle);
 
+  m.def("GetFrenetCacheStatistics", []() {
+    const auto statistics = transformation::FrenetCache::GetStatistics();
+    py::dict d;
+    d["projections"] = statistics.projections;
+    d["reused"] = statistics.reused;
+    return d;
+  });
+  m.def("ResetFrenetCacheStatistics",
+        &transformation::FrenetCache::ResetStatistics);
+
   m.def("SetLogLevel", [](int level) { FLAGS_minloglevel = level; });
   m.def("SetVerboseLevel", [](int level) { FLAGS_v = level; });
 
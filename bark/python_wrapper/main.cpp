@@ -6,6 +6,7 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include "benchmark.hpp"
 #include "commons/commons.hpp"
 #include "geometry/geometry.hpp"
 #include "models/models.hpp"
@@ -31,6 +32,8 @@ PYBIND11_MODULE(core, m) {
   python_viewer(m.def_submodule("viewer", "submodule containing the viewer"));
   python_runtime(
       m.def_submodule("runtime", "submodule containing the runtime"));
+  python_benchmark(m.def_submodule(
+      "benchmark", "submodule containing the native benchmark executor"));
 #ifdef LTL_RULES
   define_rule_monitor(
       m.def_submodule("ltl", "submodule containing the rule monitor"));
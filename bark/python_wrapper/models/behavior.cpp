@@ -7,6 +7,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "behavior.hpp"
+#include "bark/models/behavior/batch_policy/behavior_batch_policy.hpp"
 #include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
 #include "bark/models/behavior/dynamic_model/dynamic_model.hpp"
 #include "bark/models/behavior/idm/idm_classic.hpp"
@@ -45,7 +46,8 @@ void python_behavior(py::module m) {
       .def("GetLastSolutionTime", &BehaviorModel::GetLastSolutionTime)
       .def("ActionToBehavior", &BehaviorModel::ActionToBehavior)
       .def_property("last_trajectory", &BehaviorModel::GetLastTrajectory,
-                    &BehaviorModel::SetLastTrajectory);
+                    &BehaviorModel::SetLastTrajectory,
+                    py::return_value_policy::copy);
 
   py::class_<BehaviorConstantAcceleration, BehaviorModel,
              shared_ptr<BehaviorConstantAcceleration>>(m,
@@ -193,7 +195,11 @@ void python_behavior(py::module m) {
                                                    "BehaviorMotionPrimitives")
       .def("ActionToBehavior", &BehaviorMotionPrimitives::ActionToBehavior)
       .def_property_readonly("num_motion_primitives",
-                             &BehaviorMotionPrimitives::GetNumMotionPrimitives);
+                             &BehaviorMotionPrimitives::GetNumMotionPrimitives)
+      .def("GetValidActions", &BehaviorMotionPrimitives::GetValidActions)
+      .def("ExpandAll", &BehaviorMotionPrimitives::ExpandAll,
+           py::arg("observed_world"), py::arg("time_span"),
+           py::arg("num_threads") = 1);
 
   py::class_<BehaviorMPContinuousActions, BehaviorMotionPrimitives,
              shared_ptr<BehaviorMPContinuousActions>>(
@@ -327,6 +333,27 @@ void python_behavior(py::module m) {
                 PythonToParams(t[0].cast<py::tuple>()));
           }));
 
+  py::class_<BatchPolicy, PyBatchPolicy, shared_ptr<BatchPolicy>>(
+      m, "BatchPolicy")
+      .def(py::init<>())
+      .def("Act", &BatchPolicy::Act);
+
+  // the policy is kept alive by the Python behavior model, policies that are
+  // only referenced by copies of the behavior model have to be kept alive
+  // in Python
+  py::class_<BehaviorBatchPolicy, BehaviorDynamicModel,
+             shared_ptr<BehaviorBatchPolicy>>(m, "BehaviorBatchPolicy")
+      .def(py::init<const bark::commons::ParamsPtr&, const BatchPolicyPtr&>(),
+           py::keep_alive<1, 3>())
+      .def("Observe", &BehaviorBatchPolicy::Observe)
+      .def("SetBatchAction", &BehaviorBatchPolicy::SetBatchAction)
+      .def_property_readonly("policy", &BehaviorBatchPolicy::GetBatchPolicy)
+      .def_property_readonly("num_nearest_agents",
+                             &BehaviorBatchPolicy::GetNumNearestAgents)
+      .def("__repr__", [](const BehaviorBatchPolicy& b) {
+        return "bark.behavior.BehaviorBatchPolicy";
+      });
+
   py::class_<BehaviorStaticTrajectory, BehaviorModel,
              shared_ptr<BehaviorStaticTrajectory>>(m,
                                                    "BehaviorStaticTrajectory")
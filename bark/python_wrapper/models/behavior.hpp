@@ -11,6 +11,7 @@
 #include <memory>
 #include "bark/python_wrapper/common.hpp"
 
+#include "bark/models/behavior/batch_policy.hpp"
 #include "bark/models/behavior/behavior_model.hpp"
 #include "bark/models/behavior/motion_primitives/primitives/primitive.hpp"
 #include "bark/models/dynamic/dynamic_model.hpp"
@@ -18,6 +19,7 @@
 
 namespace py = pybind11;
 using bark::models::behavior::Action;
+using bark::models::behavior::BatchPolicy;
 using bark::models::behavior::BehaviorModel;
 using bark::models::behavior::primitives::Primitive;
 using bark::models::dynamic::DynamicModelPtr;
@@ -45,6 +47,15 @@ class PyBehaviorModel : public BehaviorModel {
   }
 };
 
+class PyBatchPolicy : public BatchPolicy {
+ public:
+  using BatchPolicy::BatchPolicy;
+
+  Eigen::MatrixXd Act(const Eigen::MatrixXd& observations) {
+    PYBIND11_OVERLOAD_PURE(Eigen::MatrixXd, BatchPolicy, Act, observations);
+  }
+};
+
 class PyPrimitive : public Primitive {
  public:
   using Primitive::Primitive;
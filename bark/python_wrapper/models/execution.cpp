@@ -9,6 +9,7 @@
 #include "execution.hpp"
 #include <string>
 #include "bark/models/execution/interpolation/interpolate.hpp"
+#include "bark/models/execution/mpc/mpc_gauss_newton.hpp"
 //#include "bark/models/execution/mpc/mpc.hpp"
 
 namespace py = pybind11;
@@ -22,9 +23,11 @@ void python_execution(py::module m) {
       m, "ExecutionModel")
       .def(py::init<const ParamsPtr&>())
       .def("Execute", &ExecutionModel::Execute)
-      .def_property_readonly("last_state", &ExecutionModel::GetExecutedState)
+      .def_property_readonly("last_state", &ExecutionModel::GetExecutedState,
+                             py::return_value_policy::copy)
       .def_property_readonly("last_trajectory",
-                             &ExecutionModel::GetLastTrajectory);
+                             &ExecutionModel::GetLastTrajectory,
+                             py::return_value_policy::copy);
 
   py::class_<ExecutionModelInterpolate, ExecutionModel,
              shared_ptr<ExecutionModelInterpolate>>(m,
@@ -43,4 +46,16 @@ void python_execution(py::module m) {
               throw std::runtime_error("Invalid tyoe of execution model!");
             return new ExecutionModelInterpolate(nullptr);
           }));
+
+  py::class_<ExecutionModelMpcGaussNewton, ExecutionModel,
+             shared_ptr<ExecutionModelMpcGaussNewton>>(
+      m, "ExecutionModelMpcGaussNewton")
+      .def(py::init<const ParamsPtr&>())
+      .def_property_readonly("last_num_iterations",
+                             &ExecutionModelMpcGaussNewton::GetLastNumIterations)
+      .def_property_readonly("last_cost",
+                             &ExecutionModelMpcGaussNewton::GetLastCost)
+      .def("__repr__", [](const ExecutionModelMpcGaussNewton& m) {
+        return "bark.dynamic.ExecutionModelMpcGaussNewton";
+      });
 }
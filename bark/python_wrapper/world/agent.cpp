@@ -40,19 +40,24 @@ void python_agent(py::module m) {
            py::arg("goal_definition") = nullptr,
            py::arg("map_interface") = nullptr, py::arg("model_3d") = Model3D())
       .def("__repr__", [](const Agent& a) { return "bark.agent.Agent"; })
-      .def_property_readonly("history", &Agent::GetStateInputHistory)
+      .def_property_readonly("history", &Agent::GetStateInputHistory,
+                             py::return_value_policy::copy)
       .def_property_readonly("shape", &Agent::GetShape)
       .def_property_readonly("id", &Agent::GetAgentId)
       .def_property_readonly("followed_trajectory",
-                             &Agent::GetExecutionTrajectory)
+                             &Agent::GetExecutionTrajectory,
+                             py::return_value_policy::copy)
       .def_property_readonly("planned_trajectory",
-                             &Agent::GetBehaviorTrajectory)
+                             &Agent::GetBehaviorTrajectory,
+                             py::return_value_policy::copy)
       .def_property("behavior_model", &Agent::GetBehaviorModel,
                     &Agent::SetBehaviorModel)
       .def_property_readonly("execution_model", &Agent::GetExecutionModel)
       .def_property_readonly("dynamic_model", &Agent::GetDynamicModel)
       .def_property_readonly("model3d", &Agent::GetModel3d)
-      .def_property_readonly("state", &Agent::GetCurrentState)
+      .def_property_readonly("state", &Agent::GetCurrentState,
+                             py::return_value_policy::copy)
+      .def("GetHistoryStateArray", &Agent::GetHistoryStateArray)
       .def_property("road_corridor", &Agent::GetRoadCorridor,
                     &Agent::SetRoadCorridor)
       .def_property("goal_definition", &Agent::GetGoalDefinition,
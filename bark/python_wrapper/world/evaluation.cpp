@@ -157,6 +157,19 @@ void python_evaluation(py::module m) {
       .def("PairwiseDirectionalEvaluate",
            py::overload_cast<const World&>(
                &EvaluatorRSS::PairwiseDirectionalEvaluate))
+      .def("GetStageTimings",
+           [](const EvaluatorRSS& e) {
+             const auto& timings = e.GetStageTimings();
+             py::dict d;
+             d["match_object"] = timings.match_object;
+             d["route"] = timings.route;
+             d["world_model"] = timings.world_model;
+             d["rss_check"] = timings.rss_check;
+             d["num_checks"] = timings.num_checks;
+             d["num_routes_planned"] = timings.num_routes_planned;
+             d["num_routes_cached"] = timings.num_routes_cached;
+             return d;
+           })
       .def("__repr__", [](const EvaluatorRSS& g) {
         return "bark.core.world.evaluation.EvaluatorRSS";
       });
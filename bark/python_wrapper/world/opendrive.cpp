@@ -100,6 +100,8 @@ void python_opendrive(py::module m) {
                     &XodrLane::SetRoadMark)
       .def_property("speed", &XodrLane::GetSpeed, &XodrLane::SetSpeed)
       .def("append", &XodrLane::append, "Append lane")
+      .def("FinishLine", &XodrLane::FinishLine,
+           "Store the appended line in single precision")
       .def("CreateLaneFromLaneWidth", &CreateLaneFromLaneWidth, "Create lane")
       .def("__repr__", [](const XodrLane& l) {
         std::stringstream ss;
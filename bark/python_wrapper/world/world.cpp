@@ -18,6 +18,7 @@
 #include "bark/python_wrapper/world/world.hpp"
 #include "bark/world/map/roadgraph.hpp"
 #include "bark/world/observed_world.hpp"
+#include "bark/world/serialization/world_serialization.hpp"
 #include "bark/world/tests/make_test_world.hpp"
 #include "bark/python_wrapper/world/prediction.hpp"
 
@@ -26,6 +27,8 @@ using namespace bark::world::objects;
 using namespace bark::world::map;
 using namespace bark::world::opendrive;
 using bark::commons::ParamsPtr;
+using bark::geometry::Point2d;
+using bark::geometry::Polygon;
 using bark::models::behavior::Action;
 using bark::models::behavior::BehaviorDynamicModel;
 using bark::models::behavior::BehaviorIDMClassic;
@@ -36,43 +39,79 @@ using bark::world::WorldPtr;
 void python_world(py::module m) {
   py::class_<World, std::shared_ptr<World>>(m, "World")
       .def(py::init<ParamsPtr>())
-      .def("Step", &World::Step)
-      .def("PlanAgents", &World::PlanAgents)
-      .def("Execute", &World::Execute)
-      .def("Observe", &World::Observe)
+      .def("Step", &World::Step,
+           py::call_guard<py::gil_scoped_release>())
+      .def("PlanAgents", &World::PlanAgents,
+           py::call_guard<py::gil_scoped_release>())
+      .def("Execute", &World::Execute,
+           py::call_guard<py::gil_scoped_release>())
+      .def("Observe", &World::Observe,
+           py::call_guard<py::gil_scoped_release>())
       .def("AddAgent", &World::AddAgent)
       .def("RemoveAgentById", &World::RemoveAgentById)
       .def("AddObject", &World::AddObject)
       .def("GetParams", &World::GetParams)
-      .def("UpdateAgentRTree", &World::UpdateAgentRTree)
+      .def("UpdateAgentRTree", &World::UpdateAgentRTree,
+           py::call_guard<py::gil_scoped_release>())
       .def("ClearEvaluators", &World::ClearEvaluators)
       .def("SetMap", &World::SetMap)
       .def("AddEvaluator", &World::AddEvaluator)
       .def("GetNearestAgents", &World::GetNearestAgents)
+      .def("GetAgentsWithinRadius",
+           py::overload_cast<const Polygon&, double>(
+               &World::GetAgentsWithinRadius, py::const_))
+      .def("GetAgentsWithinRadius",
+           py::overload_cast<const Point2d&, double, bool>(
+               &World::GetAgentsWithinRadius, py::const_),
+           py::arg("position"), py::arg("radius"),
+           py::arg("valid_agents_only") = true)
       .def_property_readonly("evaluators", &World::GetEvaluators)
-      .def("Evaluate", &World::Evaluate)
+      .def("Evaluate", &World::Evaluate,
+           py::call_guard<py::gil_scoped_release>())
       .def_property_readonly("agents", &World::GetAgents)
+      .def("GetStateArray", &World::GetStateArray)
       .def_property_readonly("agents_valid", &World::GetValidAgents)
       .def_property_readonly("objects", &World::GetObjects)
       .def_property("time", &World::GetWorldTime, &World::SetWorldTime)
       .def_property_readonly("bounding_box", &World::BoundingBox)
       .def("GetAgent", &World::GetAgent)
       .def_property("map", &World::GetMap, &World::SetMap)
-      .def("Copy", &World::Clone)
+      .def("Copy", &World::Clone,
+           py::call_guard<py::gil_scoped_release>())
       .def_property("observer_model", &World::GetObserverModel,
                     &World::SetObserverModel)
-      .def("GetWorldAtTime", &World::GetWorldAtTime)
+      .def("GetWorldAtTime", &World::GetWorldAtTime,
+           py::call_guard<py::gil_scoped_release>())
+      .def("Serialize",
+           [](const World& w) {
+             std::string data;
+             {
+               py::gil_scoped_release release;
+               data = bark::world::serialization::SerializeWorld(w);
+             }
+             return py::bytes(data);
+           })
       // .def("FillWorldFromCarla",&World::FillWorldFromCarla)
       // .def("PlanAgents",&World::PlanSpecificAgents)
       .def("__repr__", [](const World& a) { return "bark.core.world.World"; });
 
   m.def("MakeTestWorldHighway", &bark::world::tests::MakeTestWorldHighway);
 
+  m.def(
+      "DeserializeWorld",
+      [](const std::string& data, const MapInterfacePtr& map) {
+        return bark::world::serialization::DeserializeWorld(data, map);
+      },
+      py::arg("data"), py::arg("map_interface"),
+      py::call_guard<py::gil_scoped_release>());
+  m.def("ComputeMapHash", &bark::world::serialization::ComputeMapHash);
+
   py::class_<ObservedWorld, World, std::shared_ptr<ObservedWorld>>(
       m, "ObservedWorld")
       .def(py::init<const WorldPtr&, const AgentId&>())
       .def_property_readonly("ego_agent", &ObservedWorld::GetEgoAgent)
-      .def("Evaluate", &ObservedWorld::Evaluate)
+      .def("Evaluate", &ObservedWorld::Evaluate,
+           py::call_guard<py::gil_scoped_release>())
       .def("GetAgentInFront",
            py::overload_cast<>(&ObservedWorld::GetAgentInFront, py::const_))
       .def("GetAgentInFront", py::overload_cast<const LaneCorridorPtr&>(
@@ -87,8 +126,14 @@ void python_world(py::module m) {
       .def_property_readonly("other_agents", &ObservedWorld::GetOtherAgents)
       .def_property_readonly("ego_state", &ObservedWorld::CurrentEgoState)
       .def_property_readonly("ego_position", &ObservedWorld::CurrentEgoPosition)
+      .def("GetValidOtherAgentsWithinRadius",
+           &ObservedWorld::GetValidOtherAgentsWithinRadius)
       .def("PredictWithOthersIDM",
-           &ObservedWorld::Predict<BehaviorIDMClassic, BehaviorDynamicModel>)
+           &ObservedWorld::Predict<BehaviorIDMClassic, BehaviorDynamicModel>,
+           py::call_guard<py::gil_scoped_release>())
+      .def("ExpandAll", &ObservedWorld::ExpandAll, py::arg("time_span"),
+           py::arg("ego_actions"), py::arg("num_threads") = 1,
+           py::call_guard<py::gil_scoped_release>())
       .def_property_readonly("other_agents", &ObservedWorld::GetOtherAgents)
       .def("__repr__", [](const ObservedWorld& a) {
         return "bark.core.world.ObservedWorld";
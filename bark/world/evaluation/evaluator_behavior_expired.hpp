@@ -32,6 +32,8 @@ class EvaluatorBehaviorExpired : public BaseEvaluator {
       : agent_id_(agent_id) {}
   virtual ~EvaluatorBehaviorExpired() {}
 
+  AgentId GetAgentId() const { return agent_id_; }
+
   virtual EvaluationReturn Evaluate(const world::World& world) {
     const auto agent_ptr = world.GetAgent(agent_id_);
     if (agent_ptr) {
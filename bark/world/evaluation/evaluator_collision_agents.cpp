@@ -7,6 +7,8 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "bark/world/evaluation/evaluator_collision_agents.hpp"
+#include <vector>
+
 #include "bark/world/world.hpp"
 
 namespace bark {
@@ -14,26 +16,23 @@ namespace world {
 namespace evaluation {
 
 EvaluationReturn EvaluatorCollisionAgents::Evaluate(const world::World& world) {
-  bark::geometry::Polygon poly_agent1;
-  bark::geometry::Polygon poly_agent2;
-  bool colliding = false;
+  // each polygon is computed once instead of once per pair
+  const AgentMap valid_agents = world.GetValidAgents();
+  std::vector<bark::geometry::Polygon> polygons(valid_agents.size());
+  std::size_t i = 0;
+  for (const auto& agent : valid_agents) {
+    agent.second->GetPolygonFromState(agent.second->GetCurrentState(),
+                                      &polygons[i++]);
+  }
 
-  for (auto agent_outer : world.GetValidAgents()) {
-    poly_agent1 = agent_outer.second->GetPolygonFromState(
-        agent_outer.second->GetCurrentState());
-    for (auto agent_inner : world.GetValidAgents()) {
-      poly_agent2 = agent_inner.second->GetPolygonFromState(
-          agent_inner.second->GetCurrentState());
-      if (agent_inner.first != agent_outer.first) {
-        if (Collide(poly_agent1, poly_agent2)) {
-          colliding = true;
-          break;
-        }
+  for (std::size_t outer = 0; outer < polygons.size(); ++outer) {
+    for (std::size_t inner = outer + 1; inner < polygons.size(); ++inner) {
+      if (Collide(polygons[outer], polygons[inner])) {
+        return true;
       }
-      if (colliding == true) break;
     }
   }
-  return colliding;
+  return false;
 }
 
 }  // namespace evaluation
@@ -31,10 +31,11 @@ EvaluationReturn EvaluatorCollisionEgoAgent::Evaluate(
   const Polygon& ego_polygon = ego_agent->GetPolygonFromState(ego_state);
   AgentMap nearby_agents = world.GetNearestAgents(ego_position, num_agents);
 
+  Polygon agent_polygon;
   for (const auto& agent : nearby_agents) {
     if (this->agent_id_ != agent.second->GetAgentId()) {
-      const Polygon& agent_polygon =
-          agent.second->GetPolygonFromState(agent.second->GetCurrentState());
+      agent.second->GetPolygonFromState(agent.second->GetCurrentState(),
+                                        &agent_polygon);
       if (Collide(ego_polygon, agent_polygon)) {
         colliding = true;
         break;
@@ -55,10 +56,11 @@ EvaluationReturn EvaluatorCollisionEgoAgent::Evaluate(
   AgentMap nearby_agents =
       observed_world.GetNearestAgents(ego_position, num_agents);
 
+  Polygon agent_polygon;
   for (const auto& agent : nearby_agents) {
     if (ego_agent->GetAgentId() != agent.second->GetAgentId()) {
-      const Polygon& agent_polygon =
-          agent.second->GetPolygonFromState(agent.second->GetCurrentState());
+      agent.second->GetPolygonFromState(agent.second->GetCurrentState(),
+                                        &agent_polygon);
       if (Collide(ego_polygon, agent_polygon)) {
         colliding = true;
         break;
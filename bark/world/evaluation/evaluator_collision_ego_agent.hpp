@@ -27,6 +27,9 @@ class EvaluatorCollisionEgoAgent : public BaseEvaluator {
   explicit EvaluatorCollisionEgoAgent(const AgentId& agent_id)
       : agent_id_(agent_id) {}
   virtual ~EvaluatorCollisionEgoAgent() {}
+
+  AgentId GetAgentId() const { return agent_id_; }
+
   virtual EvaluationReturn Evaluate(const world::World& world);
   virtual EvaluationReturn Evaluate(const world::ObservedWorld& observed_world);
 
@@ -29,6 +29,8 @@ class EvaluatorDistanceToGoal : public BaseEvaluator {
       : agent_id_(agent_id) {}
   virtual ~EvaluatorDistanceToGoal() {}
 
+  AgentId GetAgentId() const { return agent_id_; }
+
   virtual EvaluationReturn Evaluate(const world::World& world) {
     const auto& agent = world.GetAgent(agent_id_);
     BARK_EXPECT_TRUE(bool(agent));
@@ -28,9 +28,11 @@ class EvaluatorDrivableArea : public BaseEvaluator {
       : agent_id_(agent_id) {}
   virtual ~EvaluatorDrivableArea() {}
 
+  AgentId GetAgentId() const { return agent_id_; }
+
   virtual EvaluationReturn Evaluate(const world::World& world) {
     using bark::geometry::Polygon;
-    namespace bg = boost::geometry;
+    using bark::geometry::Within;
 
     if (agent_id_ != std::numeric_limits<AgentId>::max()) {
       const auto& agent = world.GetAgent(agent_id_);
@@ -38,18 +40,20 @@ class EvaluatorDrivableArea : public BaseEvaluator {
         return true;
       }
       Polygon poly_agent = agent->GetPolygonFromState(agent->GetCurrentState());
-      const auto& poly_road = agent->GetRoadCorridor()->GetPolygon();
-      if (!bg::within(poly_agent.obj_, poly_road.obj_)) {
+      const auto& poly_road = agent->GetRoadCorridor()->GetPreparedPolygon();
+      if (!Within(poly_agent, poly_road)) {
         return true;
       }
       return false;
     }
 
+    Polygon poly_agent;
     for (const auto& agent : world.GetValidAgents()) {
-      Polygon poly_agent =
-          agent.second->GetPolygonFromState(agent.second->GetCurrentState());
-      auto poly_road = agent.second->GetRoadCorridor()->GetPolygon();
-      if (!bg::within(poly_agent.obj_, poly_road.obj_)) {
+      agent.second->GetPolygonFromState(agent.second->GetCurrentState(),
+                                        &poly_agent);
+      const auto& poly_road =
+          agent.second->GetRoadCorridor()->GetPreparedPolygon();
+      if (!Within(poly_agent, poly_road)) {
         return true;
       }
     }
@@ -59,12 +63,12 @@ class EvaluatorDrivableArea : public BaseEvaluator {
   virtual EvaluationReturn Evaluate(
       const world::ObservedWorld& observed_world) {
     using bark::geometry::Polygon;
-    namespace bg = boost::geometry;
+    using bark::geometry::Within;
 
     const auto& agent = observed_world.GetEgoAgent();
     Polygon poly_agent = agent->GetPolygonFromState(agent->GetCurrentState());
-    const auto& poly_road = agent->GetRoadCorridor()->GetPolygon();
-    if (!bg::within(poly_agent.obj_, poly_road.obj_)) {
+    const auto& poly_road = agent->GetRoadCorridor()->GetPreparedPolygon();
+    if (!Within(poly_agent, poly_road)) {
       return true;
     }
     return false;
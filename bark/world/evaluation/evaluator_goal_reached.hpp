@@ -29,6 +29,8 @@ class EvaluatorGoalReached : public BaseEvaluator {
       : agent_id_(agent_id) {}
   virtual ~EvaluatorGoalReached() {}
 
+  AgentId GetAgentId() const { return agent_id_; }
+
   virtual EvaluationReturn Evaluate(const world::World& world) {
     if (agent_id_ == std::numeric_limits<AgentId>::max()) {
       int goal_reached_count = 0;
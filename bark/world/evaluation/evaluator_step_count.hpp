@@ -26,6 +26,9 @@ class EvaluatorStepCount : public BaseEvaluator {
   EvaluatorStepCount() : steps_(0) {}
   virtual ~EvaluatorStepCount() {}
 
+  int GetSteps() const { return steps_; }
+  void SetSteps(int steps) { steps_ = steps; }
+
   EvaluationReturn Evaluate(const world::World& world) {
     this->steps_++;
     return this->steps_;
@@ -20,7 +20,8 @@ bool bark::world::evaluation::AgentBeyondPointLabelFunction::EvaluateAgent(
   const auto lc =
       other_agent->GetRoadCorridor()->GetCurrentLaneCorridor(agent_pos);
   if (lc) {
-    FrenetPosition agent_frenet(agent_pos, lc->GetCenterLine());
+    FrenetPosition agent_frenet =
+        other_agent->CurrentFrenetState(lc->GetCenterLine());
     FrenetPosition point_frenet(beyond_point_, lc->GetCenterLine());
     return ((agent_frenet.lon - point_frenet.lon) > 0);
   }
@@ -22,6 +22,7 @@ class AgentNearLabelFunction : public MultiAgentLabelFunction {
   bool EvaluateAgent(const world::ObservedWorld& observed_world,
                      const AgentPtr& other_agent) const override;
   double GetDistanceThres() const { return distance_thres_; }
+  double GetRelevantRadius() const override { return distance_thres_; }
 
  private:
   double distance_thres_;
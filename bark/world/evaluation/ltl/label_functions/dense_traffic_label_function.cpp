@@ -26,8 +26,9 @@ LabelMap DenseTrafficLabelFunction::Evaluate(
   const world::ObservedWorld& observed_world) const {
   int agent_count = 0;
   const auto& ego_pos = observed_world.GetEgoAgent()->GetCurrentPosition();
-  // TODO(@cirrostratus1): Use rtree for performance
-  for (const auto& agent : observed_world.GetOtherAgents()) {
+  auto near_agents = observed_world.GetAgentsWithinRadius(ego_pos, radius_);
+  near_agents.erase(observed_world.GetEgoAgentId());
+  for (const auto& agent : near_agents) {
     const auto& other_pos = agent.second->GetCurrentPosition();
     if (std::abs(geometry::Distance(ego_pos, other_pos)) < radius_) {
       ++agent_count;
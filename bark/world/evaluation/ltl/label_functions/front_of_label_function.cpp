@@ -20,10 +20,10 @@ bool bark::world::evaluation::FrontOfLabelFunction::EvaluateAgent(
     if (!other_lane) {
       return false;
     } else {
-      FrenetPosition f_ego(ego_agent->GetCurrentPosition(),
-                           other_lane->GetCenterLine());
-      FrenetPosition f_other(other_agent->GetCurrentPosition(),
-                             other_lane->GetCenterLine());
+      FrenetPosition f_ego =
+          ego_agent->CurrentFrenetState(other_lane->GetCenterLine());
+      FrenetPosition f_other =
+          other_agent->CurrentFrenetState(other_lane->GetCenterLine());
       return ((f_other.lon + other_agent->GetShape().front_dist_) <=
               (f_ego.lon - ego_agent->GetShape().rear_dist_));
     }
@@ -12,9 +12,22 @@ using bark::world::evaluation::LabelMap;
 LabelMap bark::world::evaluation::MultiAgentLabelFunction::Evaluate(
     const bark::world::ObservedWorld& observed_world) const {
   const auto other_agents = observed_world.GetValidOtherAgents();
+  const double radius = this->GetRelevantRadius();
   LabelMap labels;
+  if (radius < 0.0) {
+    for (const auto& agent : other_agents) {
+      bool res = this->EvaluateAgent(observed_world, agent.second);
+      labels.insert({this->GetLabel(agent.first), res});
+    }
+    return labels;
+  }
+
+  // every agent gets a label, only the near ones have to be evaluated
+  const auto near_agents =
+      observed_world.GetValidOtherAgentsWithinRadius(radius);
   for (const auto& agent : other_agents) {
-    bool res = this->EvaluateAgent(observed_world, agent.second);
+    bool res = near_agents.count(agent.first) > 0 &&
+               this->EvaluateAgent(observed_world, agent.second);
     labels.insert({this->GetLabel(agent.first), res});
   }
   return labels;
@@ -23,6 +23,9 @@ class MultiAgentLabelFunction : public BaseLabelFunction {
   LabelMap Evaluate(const world::ObservedWorld& observed_world) const override;
   virtual bool EvaluateAgent(const world::ObservedWorld& observed_world,
                              const AgentPtr& other_agent) const = 0;
+  //! EvaluateAgent has to be false for agents farther away from the ego
+  //! agent, these are pruned via the agent R-tree; negative to disable
+  virtual double GetRelevantRadius() const { return -1.0; }
 };
 
 }  // namespace evaluation
@@ -53,16 +53,11 @@ class EvaluatorRSS : public BaseEvaluator {
   // at a safe distance, the longitudinal RSS situtation is safe but the
   // lateral one is unsafety.
   virtual EvaluationReturn Evaluate(const World& world) {
-    WorldPtr cloned_world = world.Clone();
     if (world.GetAgent(agent_id_)) {
-      std::vector<ObservedWorld> observed_worlds =
-          cloned_world->Observe({agent_id_});
-      if (observed_worlds.size() > 0) {
-        return rss_.GetSafetyReponse(observed_worlds[0]);
-      } else {
-        LOG(INFO) << "EvaluatorRSS not possible for agent " << agent_id_;
-        return false;
-      }
+      // the observer clones the world, no further copy is needed
+      const ObservedWorld observed_world =
+          world.GetObserverModel()->Observe(world.Clone(), agent_id_);
+      return rss_.GetSafetyReponse(observed_world);
     } else {
       LOG(INFO) << "EvaluatorRSS not possible for agent " << agent_id_;
       return false;
@@ -99,7 +94,7 @@ class EvaluatorRSS : public BaseEvaluator {
     rss_proper_response_ = rss_.GetRSSResponse();
     rss_state_snapshot_ = rss_.GetRSSStateSnapshot();
     GenerateSafetyPolygons(observed_world);
-    return rss_.GetSafetyReponse(observed_world);
+    return result;
   };
 
   // Returns an unorder_map indicating the pairwise safety respone of the
@@ -149,6 +144,10 @@ class EvaluatorRSS : public BaseEvaluator {
   std::vector<SafetyPolygon> GetSafetyPolygons() const {
     return safety_polygons_;
   }
+
+  const RssStageTimings& GetStageTimings() const {
+    return rss_.GetStageTimings();
+  }
   
   virtual ~EvaluatorRSS() {}
 
@@ -8,6 +8,8 @@
 
 #include "bark/world/evaluation/rss/rss_interface.hpp"
 
+#include <chrono>
+
 using ::ad::map::point::ENUCoordinate;
 using ::ad::map::route::FullRoute;
 using ::ad::physics::Acceleration;
@@ -20,6 +22,42 @@ namespace bark {
 namespace world {
 namespace evaluation {
 
+namespace {
+
+// Adds the lifetime of the timer to the given stage time
+class StageTimer {
+ public:
+  explicit StageTimer(double* stage_time)
+      : stage_time_(stage_time), start_(std::chrono::steady_clock::now()) {}
+  ~StageTimer() {
+    *stage_time_ += std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start_)
+                        .count();
+  }
+
+ private:
+  double* stage_time_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Lane of the most probable map matched center point of the object
+std::optional<::ad::map::lane::LaneId> GetMatchedLaneId(
+    const ::ad::map::match::Object& match_object) {
+  const auto& positions =
+      match_object.mapMatchedBoundingBox.referencePointPositions[int32_t(
+          ::ad::map::match::ObjectReferencePoints::Center)];
+  if (positions.empty()) {
+    return std::nullopt;
+  }
+  const auto most_probable = std::max_element(
+      positions.begin(), positions.end(), [](const auto& a, const auto& b) {
+        return a.probability < b.probability;
+      });
+  return most_probable->lanePoint.paraPoint.laneId;
+}
+
+}  // namespace
+
 bool RssInterface::InitializeOpenDriveMap(
     const std::string& opendrive_file_name) {
   std::ifstream opendrive_file(opendrive_file_name);
@@ -209,6 +247,61 @@ bool RssInterface::GenerateRoute(const Point2d& agent_center,
   return is_valid_route_found;
 }
 
+bool RssInterface::GetRoute(const AgentId& agent_id,
+                            const Point2d& agent_center,
+                            const Point2d& agent_goal,
+                            const ::ad::map::match::Object& match_object,
+                            FullRoute& route) {
+  StageTimer timer(&stage_timings_.route);
+  const auto lane_id = GetMatchedLaneId(match_object);
+  const auto cached = route_cache_.find(agent_id);
+  if (lane_id && cached != route_cache_.end() &&
+      cached->second.lane_id == *lane_id &&
+      bg::equals(cached->second.goal, agent_goal)) {
+    route = cached->second.route;
+    ++stage_timings_.num_routes_cached;
+    return true;
+  }
+
+  // a lane change or a new goal invalidates the route
+  route_cache_.erase(agent_id);
+  ++stage_timings_.num_routes_planned;
+  const bool is_valid_route_found =
+      GenerateRoute(agent_center, agent_goal, match_object, route);
+  if (lane_id && is_valid_route_found) {
+    route_cache_[agent_id] = RssRouteCacheEntry{*lane_id, agent_goal, route};
+  }
+  return is_valid_route_found;
+}
+
+::ad::map::match::Object RssInterface::GetMatchObject(
+    const AgentId& agent_id, const models::dynamic::State& agent_state,
+    const Polygon& agent_shape) {
+  StageTimer timer(&stage_timings_.match_object);
+  const auto cached = match_object_cache_.find(agent_id);
+  if (cached != match_object_cache_.end() &&
+      cached->second.state(X_POSITION) == agent_state(X_POSITION) &&
+      cached->second.state(Y_POSITION) == agent_state(Y_POSITION) &&
+      cached->second.state(THETA_POSITION) == agent_state(THETA_POSITION)) {
+    return cached->second.match_object;
+  }
+  auto match_object = GenerateMatchObject(agent_state, agent_shape);
+  match_object_cache_[agent_id] =
+      RssMatchObjectCacheEntry{agent_state, match_object};
+  return match_object;
+}
+
+void RssInterface::PruneCaches(const AgentMap& agents) {
+  for (auto it = route_cache_.begin(); it != route_cache_.end();) {
+    it = agents.count(it->first) ? std::next(it) : route_cache_.erase(it);
+  }
+  for (auto it = match_object_cache_.begin();
+       it != match_object_cache_.end();) {
+    it = agents.count(it->first) ? std::next(it)
+                                 : match_object_cache_.erase(it);
+  }
+}
+
 AgentState RssInterface::ConvertAgentState(
     const models::dynamic::State& agent_state,
     const ::ad::rss::world::RssDynamics& agent_dynamics) {
@@ -257,25 +350,53 @@ Distance RssInterface::CalculateMaxStoppingDistance(
   return traveled_distance_when_responsing + braking_distance_after_responsing;
 }
 
+std::pair<double, double> RssInterface::GetStoppingDistanceBounds(
+    double speed_magnitude) {
+  const int bucket =
+      static_cast<int>(std::floor(speed_magnitude / speed_bucket_width_));
+  auto stopping_distance = [this](int bucket) {
+    auto cached = stopping_distance_cache_.find(bucket);
+    if (cached == stopping_distance_cache_.end()) {
+      const double distance = static_cast<double>(CalculateMaxStoppingDistance(
+          Speed(bucket * speed_bucket_width_), rss_dynamics_others_));
+      cached = stopping_distance_cache_.emplace(bucket, distance).first;
+    }
+    return cached->second;
+  };
+  // the stopping distance grows with the speed
+  return std::make_pair(stopping_distance(bucket),
+                        stopping_distance(bucket + 1));
+}
+
 bool RssInterface::GetRelevantAgents(const AgentMap& agents,
                                      const Point2d& ego_center,
                                      const AgentId& ego_id,
                                      const Distance& ego_max_stopping_distance,
                                      std::vector<AgentPtr>& relevant_agents) {
+  const double ego_distance = static_cast<double>(ego_max_stopping_distance);
   for (const auto& other_agent : agents) {
     AgentId other_agent_id = other_agent.second->GetAgentId();
     if (other_agent_id != ego_id) {
-      double other_agent_speed =
-          other_agent.second->GetCurrentState()(VEL_POSITION);
-      double relevant_distance =
-          (static_cast<double>(ego_max_stopping_distance) +
-           CalculateMaxStoppingDistance(other_agent_speed,
-                                        rss_dynamics_others_)) *
-          scaling_relevant_range_;
-
-      if (geometry::Distance(ego_center,
-                             other_agent.second->GetCurrentPosition()) <
-          relevant_distance) {
+      const double other_agent_speed =
+          std::fabs(other_agent.second->GetCurrentState()(VEL_POSITION));
+      const double distance = geometry::Distance(
+          ego_center, other_agent.second->GetCurrentPosition());
+
+      // the exact stopping distance is only needed within the bucket bounds
+      const auto bounds = GetStoppingDistanceBounds(other_agent_speed);
+      if (distance >= (ego_distance + bounds.second) * scaling_relevant_range_) {
+        continue;
+      }
+      bool is_relevant =
+          distance < (ego_distance + bounds.first) * scaling_relevant_range_;
+      if (!is_relevant) {
+        double relevant_distance =
+            (ego_distance + CalculateMaxStoppingDistance(
+                                other_agent_speed, rss_dynamics_others_)) *
+            scaling_relevant_range_;
+        is_relevant = distance < relevant_distance;
+      }
+      if (is_relevant) {
         relevant_agents.push_back(other_agent.second);
       }
     }
@@ -289,6 +410,7 @@ bool RssInterface::CreateWorldModel(
     const ::ad::map::match::Object& ego_match_object,
     const ::ad::map::route::FullRoute& ego_route,
     ::ad::rss::world::WorldModel& rss_world) {
+  StageTimer timer(&stage_timings_.world_model);
   geometry::Point2d ego_center(ego_rss_state.center.x, ego_rss_state.center.y);
   auto ego_av = CalculateAngularVelocity(
       agents.find(ego_id)->second->GetStateInputHistory());
@@ -316,9 +438,8 @@ bool RssInterface::CreateWorldModel(
   for (const auto& other : relevant_agents) {
     const models::dynamic::State other_state = other->GetCurrentState();
 
-    Polygon other_shape = other->GetShape();
     auto const other_match_object =
-        GenerateMatchObject(other_state, other_shape);
+        GetMatchObject(other->GetAgentId(), other_state, other->GetShape());
 
     auto other_av = CalculateAngularVelocity(other->GetStateInputHistory());
 
@@ -348,6 +469,8 @@ bool RssInterface::CreateWorldModel(
 bool RssInterface::RssCheck(
     const ::ad::rss::world::WorldModel& world_model,
     ::ad::rss::state::RssStateSnapshot& rss_state_snapshot) {
+  StageTimer timer(&stage_timings_.rss_check);
+  ++stage_timings_.num_checks;
   ::ad::rss::core::RssCheck rss_check;
   // Describes the relative relation between two objects in possible
   // situations
@@ -409,7 +532,7 @@ bool RssInterface::GenerateRSSWorld(const ObservedWorld& observed_world,
       Point2d(agent_state(X_POSITION), agent_state(Y_POSITION));
 
   const auto& road_corr = agent->GetRoadCorridor();
-  if (!bark::geometry::Collide(agent_goal, road_corr->GetPolygon())) {
+  if (!bark::geometry::Collide(agent_goal, road_corr->GetPreparedPolygon())) {
     LOG(ERROR) << "agent " << agent_id << " at position "
                << boost::geometry::get<0>(agent_center) << ", "
                << boost::geometry::get<1>(agent_center) << " with goal at "
@@ -418,14 +541,28 @@ bool RssInterface::GenerateRSSWorld(const ObservedWorld& observed_world,
                << " cannot reach goal, as it's not inside road corridor";
   }
 
+  const AgentMap& agents = observed_world.GetAgents();
+  PruneCaches(agents);
+
   ::ad::map::match::Object agent_match_object =
-      GenerateMatchObject(agent_state, agent_shape);
+      GetMatchObject(agent_id, agent_state, agent_shape);
   ::ad::map::route::FullRoute agent_rss_route;
-  GenerateRoute(agent_center, agent_goal, agent_match_object, agent_rss_route);
+  GetRoute(agent_id, agent_center, agent_goal, agent_match_object,
+           agent_rss_route);
   AgentState agent_rss_state =
       ConvertAgentState(agent_state, rss_dynamics_ego_);
 
-  AgentMap other_agents = observed_world.GetAgents();  // GetOtherAgents();
+  // no agent beyond the relevant distance at the top speed can be relevant;
+  // the box distance of the query never exceeds the center distance checked
+  // by GetRelevantAgents, which also sees agents that are not valid
+  const double max_relevant_distance =
+      (static_cast<double>(agent_rss_state.max_stopping_distance) +
+       GetStoppingDistanceBounds(observed_world.GetMaxAgentSpeed()).second) *
+      scaling_relevant_range_;
+  AgentMap other_agents = observed_world.GetAgentsWithinRadius(
+      agent_center, max_relevant_distance, false);
+  other_agents[agent_id] = agent;
+
   bool result =
       CreateWorldModel(other_agents, agent_id, agent_rss_state,
                        agent_match_object, agent_rss_route, rss_world);
@@ -14,6 +14,7 @@
 #include <optional>
 #include <streambuf>
 #include <string>
+#include <unordered_map>
 
 #include "bark/geometry/line.hpp"
 #include "bark/geometry/polygon.hpp"
@@ -23,6 +24,7 @@
 #include "bark/world/observed_world.hpp"
 
 #include <spdlog/spdlog.h>
+#include <ad/map/lane/LaneId.hpp>
 #include <ad/map/lane/Operation.hpp>
 #include <ad/map/match/AdMapMatching.hpp>
 #include <ad/map/match/Object.hpp>
@@ -77,6 +79,32 @@ typedef std::unordered_map<objects::AgentId, bool> PairwiseEvaluationReturn;
 typedef std::unordered_map<objects::AgentId, std::pair<bool, bool>>
     PairwiseDirectionalEvaluationReturn;
 
+// Accumulated wall time in seconds spent in the stages of the RSS checks
+// as well as the number of planned and reused routes
+struct RssStageTimings {
+  double match_object = 0.;
+  double route = 0.;
+  double world_model = 0.;
+  double rss_check = 0.;
+  int num_checks = 0;
+  int num_routes_planned = 0;
+  int num_routes_cached = 0;
+};
+
+// Route of an agent that stays valid as long as the agent is matched to the
+// same lane and keeps its goal
+struct RssRouteCacheEntry {
+  ::ad::map::lane::LaneId lane_id;
+  Point2d goal;
+  ::ad::map::route::FullRoute route;
+};
+
+// Map matching result of an agent, reused while the agent does not move
+struct RssMatchObjectCacheEntry {
+  models::dynamic::State state;
+  ::ad::map::match::Object match_object;
+};
+
 
 // An interface that provides a wrapper for the RSS library.
 // It provides functionality to convert a BARK into a RSS world and to
@@ -107,10 +135,15 @@ class RssInterface {
       "EvaluatorRss::RoutePredictRange",
       "Describes the distance for returning all routes.",
       50);
+    speed_bucket_width_ = params->GetReal(
+      "EvaluatorRss::SpeedBucketWidth",
+      "Speed resolution of the memoized stopping distances of other agents",
+      1);
 
     // Sanity check
     // assert(boost::filesystem::exists(opendrive_file_name));
     assert(scaling_relevant_range_ >= 1.);
+    assert(speed_bucket_width_ > 0.);
 
     // the debugging level in RSS
     spdlog::set_level(spdlog::level::off);
@@ -180,6 +213,20 @@ class RssInterface {
                      const ::ad::map::match::Object& match_object,
                      ::ad::map::route::FullRoute& route);
 
+  // Returns the cached route of the agent if it is still matched to the
+  // same lane and has the same goal, otherwise calls GenerateRoute. Only
+  // routes that reach the goal are cached.
+  bool GetRoute(const AgentId& agent_id, const Point2d& agent_center,
+                const Point2d& agent_goal,
+                const ::ad::map::match::Object& match_object,
+                ::ad::map::route::FullRoute& route);
+
+  // Returns the cached match object of the agent if its pose did not change,
+  // otherwise calls GenerateMatchObject
+  ::ad::map::match::Object GetMatchObject(
+      const AgentId& agent_id, const models::dynamic::State& agent_state,
+      const Polygon& agent_shape);
+
   AgentState ConvertAgentState(
       const models::dynamic::State& agent_state,
       const ::ad::rss::world::RssDynamics& agent_dynamics);
@@ -188,6 +235,10 @@ class RssInterface {
       const ::ad::physics::Speed& speed,
       const ::ad::rss::world::RssDynamics& agent_dynamics);
 
+  // Lower and upper bound of the maximum stopping distance of other agents,
+  // memoized at the edges of the speed bucket containing the speed magnitude
+  std::pair<double, double> GetStoppingDistanceBounds(double speed_magnitude);
+
   // Determine which agent is close thus enough relevent for safety checking
   bool GetRelevantAgents(const AgentMap& agents, const Point2d& ego_center,
                          const AgentId& ego_id,
@@ -208,7 +259,10 @@ class RssInterface {
   bool RssCheck(const ::ad::rss::world::WorldModel& world_model,
                 ::ad::rss::state::RssStateSnapshot& rss_state_snapshot);
 
-  // Generates an RSS world from a BARK world
+  // Generates an RSS world from a BARK world, only agents found by an
+  // R-tree query with the relevant distance at the top speed of all agents
+  // are checked by GetRelevantAgents, which yields the same relevant agents
+  // as checking all agents of the world
   bool GenerateRSSWorld(const ObservedWorld& observed_world,
                         ::ad::rss::world::WorldModel& rss_world);
 
@@ -230,6 +284,14 @@ class RssInterface {
     return rss_state_snapshot_;
   }
 
+  const RssStageTimings& GetStageTimings() const { return stage_timings_; }
+
+  void ResetStageTimings() { stage_timings_ = RssStageTimings(); }
+
+  // Removes the cached routes and match objects of agents that are not
+  // part of the given agents anymore
+  void PruneCaches(const AgentMap& agents);
+
  private:
   // For a detailed explanation of parameters, please see:
   // https://intel.github.io/ad-rss-lib/ad_rss/Appendix-ParameterDiscussion/#parameter-discussion
@@ -240,12 +302,20 @@ class RssInterface {
   // When a route to the goal cannnot be found, route_predict_range describes
   // the distance for returning all routes having less than the distance
   double route_predict_range_;
+  double speed_bucket_width_ = 1.;
+  // maximum stopping distance of other agents at a multiple of the bucket
+  // width, stays valid as the dynamics do not change
+  std::unordered_map<int, double> stopping_distance_cache_;
   ::ad::map::point::CoordinateTransform rss_coordinate_transform_ =
       ::ad::map::point::CoordinateTransform();
   // Contains longitudinal and lateral response of the ego object, a list of
   // id of the dangerous objects
   ::ad::rss::state::ProperResponse rss_proper_response_;
   ::ad::rss::state::RssStateSnapshot rss_state_snapshot_;
+
+  std::unordered_map<AgentId, RssRouteCacheEntry> route_cache_;
+  std::unordered_map<AgentId, RssMatchObjectCacheEntry> match_object_cache_;
+  RssStageTimings stage_timings_;
 };
 
 }  // namespace evaluation
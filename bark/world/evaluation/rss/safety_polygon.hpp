@@ -123,7 +123,7 @@ inline bool ComputeSafetyPolygon(
     // draws the polygon in relation to the other agent
     if (directional == LonDirectionMode::AUTO) {
       // calculate if the agent is in front or behind
-      auto other_agent = observed_world.GetAgents()[safe_poly.agent_id];
+      auto other_agent = observed_world.GetAgent(safe_poly.agent_id);
       if (!other_agent) {
         VLOG(4) << "SafetyPolygon could not be computed" << std::endl;
         return false;
@@ -9,7 +9,7 @@
 #ifndef BARK_WORLD_GOAL_DEFINITION_POLYGON_HPP_
 #define BARK_WORLD_GOAL_DEFINITION_POLYGON_HPP_
 
-#include "bark/geometry/polygon.hpp"
+#include "bark/geometry/prepared_polygon.hpp"
 #include "bark/world/goal_definition/goal_definition.hpp"
 
 namespace bark {
@@ -27,10 +27,12 @@ class GoalDefinitionPolygon : public GoalDefinition {
 
   virtual bool AtGoal(const bark::world::objects::Agent& agent);
 
-  const bark::geometry::Polygon& GetShape() const { return goal_shape_; }
+  const bark::geometry::Polygon& GetShape() const {
+    return goal_shape_.GetPolygon();
+  }
 
  private:
-  bark::geometry::Polygon goal_shape_;
+  bark::geometry::PreparedPolygon goal_shape_;
 };
 
 }  // namespace goal_definition
@@ -15,10 +15,7 @@ namespace world {
 namespace goal_definition {
 
 namespace bg = boost::geometry;
-using bark::geometry::GetNearestPointAndS;
 using bark::geometry::GetPointAtS;
-using bark::geometry::GetTangentAngleAtS;
-using bark::geometry::SignedAngleDiff;
 using bark::geometry::Line;
 using bark::geometry::Point2d;
 using bark::geometry::Polygon;
@@ -50,7 +47,6 @@ GoalDefinitionStateLimitsFrenet::GoalDefinitionStateLimitsFrenet(
 bool GoalDefinitionStateLimitsFrenet::AtGoal(
     const bark::world::objects::Agent& agent) {
   const auto agent_state = agent.GetCurrentState();
-  const auto agent_angle = agent_state[bark::models::dynamic::StateDefinition::THETA_POSITION];
   const Point2d agent_pos = agent.GetCurrentPosition();
   const auto agent_velocity =
       agent_state[bark::models::dynamic::StateDefinition::VEL_POSITION];
@@ -64,11 +60,7 @@ bool GoalDefinitionStateLimitsFrenet::AtGoal(
     return false;
   }
 
-  const std::tuple<Point2d, double, uint> nearest_point =
-      GetNearestPointAndS(center_line_, agent_pos);
-  const auto tangent_angle =
-      GetTangentAngleAtS(center_line_, std::get<double>(nearest_point));
-  const auto angle_diff = SignedAngleDiff(tangent_angle, agent_angle);
+  const auto angle_diff = agent.CurrentFrenetState(center_line_).angle;
 
   if (angle_diff <= max_orientation_differences_.first &&
       angle_diff >= -max_orientation_differences_.second) {
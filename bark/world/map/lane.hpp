@@ -21,6 +21,7 @@ namespace map {
 
 using LaneId = unsigned int;
 using bark::geometry::Line;
+using bark::geometry::LocalLine;
 using bark::geometry::Polygon;
 using bark::world::opendrive::XodrLane;
 using bark::world::opendrive::XodrLanePtr;
@@ -30,11 +31,12 @@ using bark::world::opendrive::XodrRoadMark;
 using bark::world::opendrive::XodrRoadPtr;
 
 struct Boundary {
-  Line GetLine() const { return line_; }
+  Line GetLine() const { return line_.ToLine(); }
   XodrRoadMark GetType() const { return type_; }
-  void SetLine(const Line& line) { line_ = line; }
+  void SetLine(const Line& line) { line_ = LocalLine(line); }
   void SetType(const XodrRoadMark& type) { type_ = type; }
-  Line line_;
+  //! single-precision storage, the line is only read through GetLine
+  LocalLine line_;
   XodrRoadMark type_;
 };
 
@@ -4,4 +4,27 @@
 // Tobias Kessler
 //
 // This work is licensed under the terms of the MIT license.
-// For a copy, see <https://opensource.org/licenses/MIT>.
\ No newline at end of file
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/world/map/lane_corridor.hpp"
+
+namespace bark {
+namespace world {
+namespace map {
+
+std::shared_ptr<const FrenetProjector> LaneCorridor::GetCenterLineProjector()
+    const {
+  const auto line_derivatives = center_line_.GetSharedDerivatives();
+  std::lock_guard<std::mutex> lock(center_line_projector_->mutex);
+  if (!center_line_projector_->projector ||
+      center_line_projector_->line_derivatives != line_derivatives) {
+    center_line_projector_->projector =
+        std::make_shared<const FrenetProjector>(center_line_);
+    center_line_projector_->line_derivatives = line_derivatives;
+  }
+  return center_line_projector_->projector;
+}
+
+}  // namespace map
+}  // namespace world
+}  // namespace bark
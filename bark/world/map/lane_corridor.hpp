@@ -12,9 +12,11 @@
 #include <boost/functional/hash.hpp>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
+#include "bark/commons/transformation/frenet_projection.hpp"
 #include "bark/geometry/geometry.hpp"
 #include "bark/world/map/lane.hpp"
 #include "bark/world/map/road.hpp"
@@ -29,6 +31,15 @@ using bark::geometry::Point2d;
 using bark::geometry::Polygon;
 using bark::geometry::Within;
 using bark::world::opendrive::XodrRoadId;
+using bark::commons::transformation::FrenetProjector;
+
+//! projector of a center line, valid while line_derivatives are the
+//! derivatives of the center line
+struct CenterLineProjectorCache {
+  std::mutex mutex;
+  std::shared_ptr<const bark::geometry::LineDerivatives> line_derivatives;
+  std::shared_ptr<const FrenetProjector> projector;
+};
 
 struct LaneCorridor {
   using LaneCorridorPtr = std::shared_ptr<LaneCorridor>;
@@ -54,6 +65,12 @@ struct LaneCorridor {
     return GetLength() - GetS(pt);
   }
 
+  /**
+   * @brief Batch projector of the center line, built on the first call and
+   *        rebuilt only after the center line was modified; thread-safe
+   */
+  std::shared_ptr<const FrenetProjector> GetCenterLineProjector() const;
+
   double GetLaneWidth(const Point2d& pt) {
     uint idx = FindNearestIdx(GetCenterLine(), pt);
     // assumption: center, left and right have same # elements
@@ -88,6 +105,9 @@ struct LaneCorridor {
   Polygon merged_polygon_;
   Line left_boundary_;
   Line right_boundary_;
+  //! shared by copies, which rebuild it only if their center lines differ
+  std::shared_ptr<CenterLineProjectorCache> center_line_projector_ =
+      std::make_shared<CenterLineProjectorCache>();
 };
 using LaneCorridorPtr = std::shared_ptr<LaneCorridor>;
 
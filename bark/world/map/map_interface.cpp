@@ -29,8 +29,8 @@ bool MapInterface::interface_from_opendrive(
     for (auto& lane_section : road.second->GetLaneSections()) {
       for (auto& lane : lane_section->GetLanes()) {
         if (lane.second->GetLanePosition() == 0) continue;
-        LineSegment lane_segment(*lane.second->GetLine().begin(),
-                                 *(lane.second->GetLine().end() - 1));
+        const Line lane_line = lane.second->GetLine();
+        LineSegment lane_segment(*lane_line.begin(), *(lane_line.end() - 1));
         rtree_lane_.insert(std::make_pair(lane_segment, lane.second));
       }
     }
@@ -163,8 +163,8 @@ void MapInterface::CalculateLaneCorridors(RoadCorridorPtr& road_corridor,
     lane_corridor->SetCenterLine(current_lane->GetCenterLine());
     lane_corridor->SetFineCenterLine(current_lane->GetCenterLine());
     // lane_corridor->SetMergedPolygon(current_lane->GetPolygon());
-    lane_corridor->SetLeftBoundary(current_lane->GetLeftBoundary().line_);
-    lane_corridor->SetRightBoundary(current_lane->GetRightBoundary().line_);
+    lane_corridor->SetLeftBoundary(current_lane->GetLeftBoundary().GetLine());
+    lane_corridor->SetRightBoundary(current_lane->GetRightBoundary().GetLine());
     lane_corridor->SetLane(total_s, current_lane);
 
     // add initial lane
@@ -181,12 +181,13 @@ void MapInterface::CalculateLaneCorridors(RoadCorridorPtr& road_corridor,
       lane_corridor->SetFineCenterLine(new_center);
       
       Line new_left = bark::geometry::ConcatenateLinestring(
-          lane_corridor->GetLeftBoundary(), next_lane->GetLeftBoundary().line_);
+          lane_corridor->GetLeftBoundary(),
+          next_lane->GetLeftBoundary().GetLine());
       lane_corridor->SetLeftBoundary(new_left);
 
       Line new_right = bark::geometry::ConcatenateLinestring(
           lane_corridor->GetRightBoundary(),
-          next_lane->GetRightBoundary().line_);
+          next_lane->GetRightBoundary().GetLine());
       lane_corridor->SetRightBoundary(new_right);
       // std::cout << "New Poly" << std::endl;
       // std::cout << next_lane->GetPolygon().ToArray() << std::endl;
@@ -366,8 +367,8 @@ void MapInterface::GenerateRoadCorridor(
       // compute center line
       if (left_boundary_lane_id.second && right_boundary_lane_id.second)
         lane.second->SetCenterLine(
-            ComputeCenterLine(lane.second->GetLeftBoundary().line_,
-                              lane.second->GetRightBoundary().line_));
+            ComputeCenterLine(lane.second->GetLeftBoundary().GetLine(),
+                              lane.second->GetRightBoundary().GetLine()));
     }
   }
 
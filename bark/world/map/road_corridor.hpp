@@ -28,6 +28,7 @@ using bark::geometry::BufferPolygon;
 using bark::geometry::Line;
 using bark::geometry::Point2d;
 using bark::geometry::Polygon;
+using bark::geometry::PreparedPolygon;
 using bark::geometry::Within;
 using bark::world::opendrive::XodrDrivingDirection;
 using bark::world::opendrive::XodrRoadId;
@@ -39,7 +40,8 @@ struct RoadCorridor {
     return roads_.at(road_id);
   }
   Roads GetRoads() const { return roads_; }
-  Polygon GetPolygon() const { return road_polygon_; }
+  const Polygon& GetPolygon() const { return road_polygon_.GetPolygon(); }
+  const PreparedPolygon& GetPreparedPolygon() const { return road_polygon_; }
   Lanes GetLanes(const RoadId& road_id) const {
     return this->GetRoad(road_id)->GetLanes();
   }
@@ -114,16 +116,18 @@ struct RoadCorridor {
     }
     Polygon poly_buffered_merged;
     BufferPolygon(merged_polygon, -buffer_dist, &poly_buffered_merged);
-    road_polygon_ = poly_buffered_merged;
+    road_polygon_ = PreparedPolygon(poly_buffered_merged);
     return true;
   }
-  void SetPolygon(const Polygon& poly) { road_polygon_ = poly; }
+  void SetPolygon(const Polygon& poly) {
+    road_polygon_ = PreparedPolygon(poly);
+  }
   void SetRoadIds(const std::vector<XodrRoadId>& road_ids) {
     road_ids_ = road_ids;
   }
 
   Roads roads_;
-  Polygon road_polygon_;
+  PreparedPolygon road_polygon_;
   std::vector<LaneCorridorPtr> unique_lane_corridors_;
   std::vector<XodrRoadId> road_ids_;
   XodrDrivingDirection driving_direction_;
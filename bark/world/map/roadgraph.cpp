@@ -661,7 +661,8 @@ std::pair<PolygonPtr, bool> Roadgraph::ComputeXodrLanePolygon(
   if (lb.first && lb.second) {
     success = true;
 
-    for (auto const& p : lb.first->GetLine()) {
+    const Line inner = lb.first->GetLine();
+    for (auto const& p : inner) {
       polygon->AddPoint(p);
     }
     // outer
@@ -672,7 +673,7 @@ std::pair<PolygonPtr, bool> Roadgraph::ComputeXodrLanePolygon(
       polygon->AddPoint(p);
     }
     // Polygons need to be closed!
-    polygon->AddPoint(*(lb.first->GetLine().begin()));
+    polygon->AddPoint(*(inner.begin()));
   }
   return std::make_pair(polygon, success);
 }
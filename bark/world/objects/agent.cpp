@@ -7,6 +7,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "bark/world/objects/agent.hpp"
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include "bark/world/objects/object.hpp"
@@ -69,7 +70,8 @@ Agent::Agent(const Agent& other_agent)
       history_(other_agent.history_),
       max_history_length_(other_agent.max_history_length_),
       first_valid_timestamp_(other_agent.first_valid_timestamp_),
-      goal_definition_(other_agent.goal_definition_) {}
+      goal_definition_(other_agent.goal_definition_),
+      frenet_cache_(other_agent.frenet_cache_) {}
 
 void Agent::PlanBehavior(const double& min_planning_dt,
                          const ObservedWorld& observed_world) {
@@ -112,17 +114,35 @@ FrenetPosition Agent::CurrentFrenetPosition() const {
     // (until better failure handling implemented)
     return FrenetPosition(0.0, std::numeric_limits<double>::max());
   }
-  FrenetPosition frenet_pos(pos, lane_corridor->GetCenterLine());
-  return frenet_pos;
+  return CurrentFrenetState(lane_corridor->GetCenterLine());
+}
+
+Trajectory Agent::GetHistoryStateArray() const {
+  int state_size = 0;
+  for (const auto& state_action : history_) {
+    state_size =
+        std::max(state_size, static_cast<int>(state_action.first.size()));
+  }
+  Trajectory states = Trajectory::Zero(history_.size(), state_size);
+  for (std::size_t i = 0; i < history_.size(); ++i) {
+    const State& state = history_[i].first;
+    states.row(i).head(state.size()) = state.transpose();
+  }
+  return states;
 }
 
 Polygon Agent::GetPolygonFromState(const State& state) const {
+  Polygon polygon;
+  GetPolygonFromState(state, &polygon);
+  return polygon;
+}
+
+void Agent::GetPolygonFromState(const State& state, Polygon* polygon) const {
   Pose agent_pose(state(StateDefinition::X_POSITION),
                   state(StateDefinition::Y_POSITION),
                   state(StateDefinition::THETA_POSITION));
-  std::shared_ptr<Polygon> polygon(std::dynamic_pointer_cast<Polygon>(
-      this->GetShape().Transform(agent_pose)));
-  return *polygon;
+  *polygon = this->GetShape();
+  polygon->TransformInPlace(agent_pose);
 }
 
 bool Agent::AtGoal() const {
@@ -135,7 +155,7 @@ bool Agent::InsideRoadCorridor() const {
     return false;
   } else {
     Polygon agent_poly = GetPolygonFromState(GetCurrentState());
-    bool inside = Within(agent_poly, road_corridor_->GetPolygon());
+    bool inside = Within(agent_poly, road_corridor_->GetPreparedPolygon());
     return inside;
   }
 }
@@ -11,6 +11,7 @@
 
 #include "bark/commons/base_type.hpp"
 #include "bark/commons/transformation/frenet.hpp"
+#include "bark/commons/transformation/frenet_cache.hpp"
 #include "bark/geometry/polygon.hpp"
 #include "bark/models/behavior/behavior_model.hpp"
 #include "bark/models/dynamic/dynamic_model.hpp"
@@ -27,7 +28,9 @@ class ObservedWorld;
 namespace objects {
 
 typedef unsigned int AgentId;
+using bark::commons::transformation::FrenetCache;
 using bark::commons::transformation::FrenetPosition;
+using bark::commons::transformation::FrenetState;
 using bark::world::goal_definition::GoalDefinition;
 using bark::world::goal_definition::GoalDefinitionPtr;
 using bark::world::map::MapInterfacePtr;
@@ -106,19 +109,29 @@ class Agent : public Object {
 
   DynamicModelPtr GetDynamicModel() const { return dynamic_model_; }
 
-  StateActionHistory GetStateInputHistory() const { return history_; }
+  //! the reference dangles after the next push to or erase from the history
+  const StateActionHistory& GetStateInputHistory() const { return history_; }
 
   GoalDefinitionPtr GetGoalDefinition() const { return goal_definition_; }
 
-  Trajectory GetExecutionTrajectory() const {
+  //! the reference dangles once the execution model is stepped again
+  const Trajectory& GetExecutionTrajectory() const {
     return execution_model_->GetLastTrajectory();
   }
 
-  Trajectory GetBehaviorTrajectory() const {
+  //! the reference dangles once the behavior model plans again
+  const Trajectory& GetBehaviorTrajectory() const {
     return behavior_model_->GetLastTrajectory();
   }
 
-  State GetCurrentState() const { return history_.back().first; }
+  //! the reference dangles after the next push to or erase from the history
+  const State& GetCurrentState() const { return history_.back().first; }
+
+  /**
+   * @brief  Returns the states of the history as rows of a trajectory,
+   *         oldest state first
+   */
+  Trajectory GetHistoryStateArray() const;
 
   Point2d GetCurrentPosition() const {
     const State& state = GetCurrentState();
@@ -128,8 +141,20 @@ class Agent : public Object {
 
   FrenetPosition CurrentFrenetPosition() const;
 
+  /**
+   * @brief  Frenet state of the current state w.r.t. a long-lived line,
+   *         e.g. a lane corridor center line. The result is cached until
+   *         the state of the agent changes.
+   */
+  FrenetState CurrentFrenetState(const bark::geometry::Line& line) const {
+    return frenet_cache_.Get(GetCurrentState(), line);
+  }
+
   Polygon GetPolygonFromState(const State& state) const;
 
+  //! writes the shape at the pose of state to polygon, reusing its storage
+  void GetPolygonFromState(const State& state, Polygon* polygon) const;
+
   const RoadCorridorPtr GetRoadCorridor() const { return road_corridor_; }
 
   BehaviorStatus GetBehaviorStatus() const {
@@ -193,6 +218,7 @@ class Agent : public Object {
   uint32_t max_history_length_;
   GoalDefinitionPtr goal_definition_;
   double first_valid_timestamp_;
+  FrenetCache frenet_cache_;
 };
 
 typedef std::shared_ptr<Agent> AgentPtr;
@@ -12,7 +12,7 @@ namespace bark {
 namespace world {
 namespace objects {
 
-AgentId Object::agent_count = 0;
+std::atomic<AgentId> Object::agent_count(0);
 
 Object::Object(const geometry::Polygon& shape, const commons::ParamsPtr& params,
                const geometry::Model3D& model_3d)
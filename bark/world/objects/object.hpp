@@ -9,6 +9,7 @@
 #ifndef BARK_WORLD_OBJECTS_OBJECT_HPP_
 #define BARK_WORLD_OBJECTS_OBJECT_HPP_
 
+#include <atomic>
 #include "bark/commons/commons.hpp"
 #include "bark/geometry/model_3d.hpp"
 #include "bark/geometry/polygon.hpp"
@@ -33,7 +34,7 @@ class Object : public commons::BaseType {
 
   virtual ~Object() {}
 
-  geometry::Polygon GetShape() const { return shape_; }
+  const geometry::Polygon& GetShape() const { return shape_; }
   geometry::Model3D GetModel3d() const { return model_3d_; }
 
   AgentId GetAgentId() const { return agent_id_; }
@@ -47,7 +48,8 @@ class Object : public commons::BaseType {
   geometry::Model3D model_3d_;
   AgentId agent_id_;
 
-  static AgentId agent_count;
+  // atomic so that agents can be created from multiple threads
+  static std::atomic<AgentId> agent_count;
 };
 
 typedef std::shared_ptr<Object> ObjectPtr;
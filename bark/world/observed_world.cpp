@@ -6,7 +6,10 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <thread>
 
 #include "bark/models/behavior/motion_primitives/motion_primitives.hpp"
 #include "bark/world/observed_world.hpp"
@@ -16,6 +19,7 @@ namespace world {
 
 using bark::geometry::Point2d;
 using bark::models::behavior::BehaviorMotionPrimitives;
+using bark::models::behavior::BehaviorStatus;
 using bark::models::behavior::BehaviorMotionPrimitivesPtr;
 using bark::models::dynamic::State;
 using bark::world::AgentMap;
@@ -28,17 +32,16 @@ FrontRearAgents ObservedWorld::GetAgentFrontRear() const {
   }
 
   AgentId id = GetEgoAgentId();
-  FrontRearAgents fr_agent = GetAgentFrontRearForId(id, lane_corridor, GetFracLateralOffset());
-
-  return fr_agent;
+  return GetNeighborInformation(id, lane_corridor, GetFracLateralOffset())
+      .front_rear;
 }
 
 FrontRearAgents ObservedWorld::GetAgentFrontRear(
     const LaneCorridorPtr& lane_corridor) const {
   BARK_EXPECT_TRUE(lane_corridor != nullptr);
   AgentId id = GetEgoAgentId();
-  FrontRearAgents fr_agent = GetAgentFrontRearForId(id, lane_corridor, GetFracLateralOffset());
-  return fr_agent;
+  return GetNeighborInformation(id, lane_corridor, GetFracLateralOffset())
+      .front_rear;
 }
 
 AgentFrenetPair ObservedWorld::GetAgentInFront(
@@ -158,6 +161,116 @@ ObservedWorldPtr ObservedWorld::Predict(
   return next_world;
 }
 
+std::vector<ObservedWorldPtr> ObservedWorld::ExpandAll(
+    double time_span, const std::vector<DiscreteAction>& ego_actions,
+    unsigned int num_threads) const {
+  std::shared_ptr<ObservedWorld> common_world =
+      std::dynamic_pointer_cast<ObservedWorld>(ObservedWorld::Clone());
+  common_world->UpdateAgentRTree();
+  WorldPtr current_world(common_world->Clone());
+  const auto observer = common_world->GetObserverModel();
+  const double world_time = common_world->GetWorldTime();
+  const double inc_world_time = world_time + time_span;
+
+  // the plans of the other agents are shared among all ego actions
+  for (auto& agent : common_world->GetAgents()) {
+    if (agent.first == ego_agent_id_ ||
+        !agent.second->IsValidAtTime(world_time)) {
+      continue;
+    }
+    ObservedWorld observed_world = observer->Observe(current_world,
+                                                     agent.first);
+    agent.second->PlanBehavior(time_span, observed_world);
+    if (agent.second->GetBehaviorStatus() == BehaviorStatus::VALID)
+      agent.second->PlanExecution(inc_world_time);
+  }
+
+  // the ego agent observes the same snapshot for all actions
+  std::shared_ptr<ObservedWorld> ego_observed_world;
+  const AgentPtr& ego_agent = common_world->GetEgoAgent();
+  if (ego_agent && ego_agent->IsValidAtTime(world_time)) {
+    ego_observed_world = std::make_shared<ObservedWorld>(
+        observer->Observe(current_world, ego_agent_id_));
+  }
+
+  // ego behavior models keep planning state, clones planned in parallel
+  // must not share it
+  num_threads = std::min<unsigned int>(
+      std::max<unsigned int>(num_threads, 1), ego_actions.size());
+  if (num_threads > 1 && ego_agent) {
+    const auto ego_behavior_model =
+        std::dynamic_pointer_cast<BehaviorMotionPrimitives>(
+            ego_agent->GetBehaviorModel());
+    if (ego_behavior_model && !ego_behavior_model->HasIndependentClones()) {
+      LOG(WARNING) << "Ego behavior model cannot be copied for parallel "
+                      "expansion, expanding serially.";
+      num_threads = 1;
+    }
+  }
+
+  std::vector<ObservedWorldPtr> next_worlds(ego_actions.size());
+  auto expand = [&](std::size_t idx,
+                    const std::shared_ptr<ObservedWorld>& ego_world) {
+    std::shared_ptr<ObservedWorld> next_world =
+        std::dynamic_pointer_cast<ObservedWorld>(common_world->Clone());
+    if (ego_world) {
+      const AgentPtr& next_ego_agent = next_world->GetEgoAgent();
+      std::shared_ptr<BehaviorMotionPrimitives> ego_behavior_model =
+          std::dynamic_pointer_cast<BehaviorMotionPrimitives>(
+              next_ego_agent->GetBehaviorModel());
+      if (ego_behavior_model && num_threads > 1) {
+        // world clones share parts of the model, e.g. primitives
+        ego_behavior_model =
+            std::dynamic_pointer_cast<BehaviorMotionPrimitives>(
+                ego_behavior_model->CloneIndependent());
+        next_ego_agent->SetBehaviorModel(ego_behavior_model);
+      }
+      if (ego_behavior_model) {
+        ego_behavior_model->ActionToBehavior(ego_actions.at(idx));
+      } else {
+        LOG(ERROR)
+            << "Currently only BehaviorMotionPrimitive model supported for "
+               "ego prediction, adjust prediction settings.";  // NOLINT
+      }
+      next_ego_agent->PlanBehavior(time_span, *ego_world);
+      if (next_ego_agent->GetBehaviorStatus() == BehaviorStatus::VALID)
+        next_ego_agent->PlanExecution(inc_world_time);
+    }
+    next_world->Execute(time_span);
+    next_worlds.at(idx) = next_world;
+  };
+
+  if (num_threads <= 1) {
+    for (std::size_t idx = 0; idx < ego_actions.size(); ++idx) {
+      expand(idx, ego_observed_world);
+    }
+  } else {
+    // each worker plans on its own copy of the ego observation, planning
+    // modifies the observed agents, e.g. their dynamic models
+    std::vector<std::shared_ptr<ObservedWorld>> worker_worlds(num_threads);
+    for (auto& worker_world : worker_worlds) {
+      if (ego_observed_world) {
+        worker_world = std::dynamic_pointer_cast<ObservedWorld>(
+            ego_observed_world->Clone());
+      }
+    }
+    std::atomic<std::size_t> next_idx(0);
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < num_threads; ++i) {
+      workers.emplace_back([&, i]() {
+        for (std::size_t idx = next_idx++; idx < ego_actions.size();
+             idx = next_idx++) {
+          expand(idx, worker_worlds.at(i));
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+  return next_worlds;
+}
+
 ObservedWorldPtr ObservedWorld::ObserveForOtherAgent(
     const AgentId& other_agent_id) const {
   std::shared_ptr<ObservedWorld> others_world =
@@ -180,5 +293,13 @@ AgentMap ObservedWorld::GetValidOtherAgents() const {
   return tmp_map;
 }
 
+AgentMap ObservedWorld::GetValidOtherAgentsWithinRadius(double radius) const {
+  const auto ego_agent = GetEgoAgent();
+  auto tmp_map = World::GetAgentsWithinRadius(
+      ego_agent->GetPolygonFromState(ego_agent->GetCurrentState()), radius);
+  tmp_map.erase(ego_agent_id_);
+  return tmp_map;
+}
+
 }  // namespace world
 }  // namespace bark
@@ -11,6 +11,7 @@
 
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include "bark/geometry/geometry.hpp"
 #include "bark/models/dynamic/dynamic_model.hpp"
 #include "bark/world/prediction/prediction_settings.hpp"
@@ -78,6 +79,14 @@ class ObservedWorld : public World {
 
   AgentMap GetValidOtherAgents() const;
 
+  /**
+   * @brief Valid other agents that may be within radius of the ego shape
+   *
+   * R-tree pre-filter based on bounding boxes, see
+   * World::GetAgentsWithinRadius
+   */
+  AgentMap GetValidOtherAgentsWithinRadius(double radius) const;
+
   const std::shared_ptr<BehaviorModel> GetEgoBehaviorModel() const {
     return World::GetAgent(ego_agent_id_)->GetBehaviorModel();
   }
@@ -121,6 +130,28 @@ class ObservedWorld : public World {
                            const std::unordered_map<AgentId, BehaviorModelPtr>
                                other_behaviors) const;
 
+  /**
+   * @brief Predicts the successor world for every given ego action in one call
+   *
+   * Requires the ego agent to have a motion primitive based behavior model.
+   * The world snapshot observed by all agents and the planning of the other
+   * agents do not depend on the ego action and are thus computed only once.
+   * Per action, only the ego agent is planned and the world is executed.
+   *
+   * @param time_span prediction time span
+   * @param ego_actions distinct motion primitive actions of the ego agent
+   * Each thread plans the ego agent on its own copy of the observed world
+   * and of the ego behavior model. If the model cannot be copied without
+   * sharing planning state, e.g. with primitives implemented in Python,
+   * the actions are expanded serially.
+   *
+   * @param num_threads number of threads expanding the actions in parallel
+   * @return successor worlds in the order of ego_actions
+   */
+  std::vector<ObservedWorldPtr> ExpandAll(
+      double time_span, const std::vector<DiscreteAction>& ego_actions,
+      unsigned int num_threads = 1) const;
+
   template <class Behavior, class EgoBehavior>
   ObservedWorldPtr Predict(double time_span, const Action& ego_action) const {
     std::shared_ptr<ObservedWorld> next_obs_world =
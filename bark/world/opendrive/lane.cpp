@@ -51,14 +51,26 @@ bool XodrLane::append(geometry::Line previous_line,
   if (boost::geometry::intersects(tmp_line.obj_)) {
     LOG(ERROR) << "CreateLineWithOffsetFromLine yields intersecting line";
   }
-  line_.AppendLinestring(tmp_line);
-
-  if (boost::geometry::intersects(line_.obj_)) {
-    LOG(ERROR) << "XodrLane line has self-intersection";
+  if (!appended_line_) {
+    appended_line_ = std::make_unique<geometry::Line>(line_.ToLine());
+  }
+  // AddPoint extends s incrementally, so appending stays linear
+  for (const auto& point : tmp_line) {
+    appended_line_->AddPoint(point);
   }
   return true;
 }
 
+void XodrLane::FinishLine() {
+  if (appended_line_) {
+    if (boost::geometry::intersects(appended_line_->obj_)) {
+      LOG(ERROR) << "XodrLane line has self-intersection";
+    }
+    line_ = LocalLine(*appended_line_);
+    appended_line_.reset();
+  }
+}
+
 }  // namespace opendrive
 }  // namespace world
 }  // namespace bark
@@ -10,10 +10,12 @@
 #define BARK_WORLD_OPENDRIVE_LANE_HPP_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include "bark/geometry/commons.hpp"
 #include "bark/geometry/line.hpp"
+#include "bark/geometry/local_line.hpp"
 #include "bark/world/opendrive/commons.hpp"
 
 namespace bark {
@@ -21,6 +23,7 @@ namespace world {
 namespace opendrive {
 
 using bark::geometry::Line;
+using bark::geometry::LocalLine;
 using bark::geometry::Point2d;
 
 class XodrLane {
@@ -33,6 +36,9 @@ class XodrLane {
         lane_position_(lane->lane_position_),
         link_(lane->link_),
         line_(lane->line_),
+        appended_line_(lane->appended_line_
+                           ? std::make_unique<Line>(*lane->appended_line_)
+                           : nullptr),
         lane_type_(lane->lane_type_),
         driving_direction_(lane->driving_direction_),
         road_mark_(lane->road_mark_),
@@ -42,7 +48,10 @@ class XodrLane {
 
   //! setter functions
   void SetId(const XodrLaneId lane_id) { lane_id_ = lane_id; }
-  void SetLine(const Line line) { line_ = line; }
+  void SetLine(const Line line) {
+    line_ = LocalLine(line);
+    appended_line_.reset();
+  }
   void SetLink(const XodrLaneLink link) { link_ = link; }
   void SetSpeed(double speed) { speed_ = speed; }
   void SetLaneType(const XodrLaneType lt) { lane_type_ = lt; }
@@ -54,11 +63,20 @@ class XodrLane {
     lane_position_ = lane_position;
   }
 
+  //! appends in double precision, FinishLine stores the result
   bool append(Line previous_line, XodrLaneWidth lane_width_current,
               double s_inc);
 
+  //! converts the appended line to single precision, called when the lane
+  //! is added to a lane section
+  void FinishLine();
+
   //! getter functions
-  Line GetLine() const { return line_; }
+  Line GetLine() const {
+    return appended_line_ ? *appended_line_ : line_.ToLine();
+  }
+  //! single-precision storage of the line, complete after FinishLine
+  const LocalLine& GetLocalLine() const { return line_; }
 
   XodrLaneLink GetLink() const { return link_; }
   XodrRoadMark GetRoad_mark() const { return road_mark_; }
@@ -74,7 +92,9 @@ class XodrLane {
   XodrLaneId lane_id_;
   XodrLanePosition lane_position_;
   XodrLaneLink link_;
-  Line line_;
+  LocalLine line_;
+  //! line under construction by append, empty once finished
+  std::unique_ptr<Line> appended_line_;
 
   XodrLaneType lane_type_;
   XodrDrivingDirection driving_direction_;
@@ -106,6 +126,7 @@ inline XodrLanePtr CreateLaneFromLaneWidth(XodrLanePosition lane_position,
                                            double s_inc = 0.05f) {
   std::shared_ptr<XodrLane> ret_lane(new XodrLane(lane_position));
   ret_lane->append(previous_line, lane_width_current, s_inc);
+  ret_lane->FinishLine();
   return ret_lane;
 }
 
@@ -18,6 +18,7 @@ namespace world {
 namespace opendrive {
 
 void XodrLaneSection::AddLane(const XodrLanePtr& lane) {
+  lane->FinishLine();
   lanes_[lane->GetId()] = lane;
 }
 
@@ -0,0 +1,1034 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "bark/world/serialization/world_serialization.hpp"
+
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
+#include "bark/models/behavior/dynamic_model/dynamic_model.hpp"
+#include "bark/models/behavior/idm/idm_classic.hpp"
+#include "bark/models/behavior/idm/idm_lane_tracking.hpp"
+#include "bark/models/behavior/not_started/behavior_not_started.hpp"
+#include "bark/models/behavior/rule_based/intersection_behavior.hpp"
+#include "bark/models/behavior/rule_based/lane_change_behavior.hpp"
+#include "bark/models/behavior/rule_based/mobil_behavior.hpp"
+#include "bark/models/behavior/static_trajectory/behavior_static_trajectory.hpp"
+#include "bark/models/dynamic/single_track.hpp"
+#include "bark/models/execution/interpolation/interpolate.hpp"
+#include "bark/models/execution/mpc/mpc_gauss_newton.hpp"
+#include "bark/world/evaluation/evaluator_behavior_expired.hpp"
+#include "bark/world/evaluation/evaluator_collision_agents.hpp"
+#include "bark/world/evaluation/evaluator_collision_ego_agent.hpp"
+#include "bark/world/evaluation/evaluator_distance_to_goal.hpp"
+#include "bark/world/evaluation/evaluator_drivable_area.hpp"
+#include "bark/world/evaluation/evaluator_goal_reached.hpp"
+#include "bark/world/evaluation/evaluator_step_count.hpp"
+#include "bark/world/goal_definition/goal_definition_polygon.hpp"
+#include "bark/world/goal_definition/goal_definition_sequential.hpp"
+#include "bark/world/goal_definition/goal_definition_state_limits.hpp"
+#include "bark/world/goal_definition/goal_definition_state_limits_frenet.hpp"
+
+namespace bark {
+namespace world {
+namespace serialization {
+
+using commons::CondensedParamList;
+using commons::ListFloat;
+using commons::ListListFloat;
+using commons::Parameter;
+using commons::ParamsPtr;
+using commons::SetterParams;
+using geometry::Line;
+using geometry::Point2d;
+using geometry::Polygon;
+using geometry::Pose;
+using models::behavior::Action;
+using models::behavior::BehaviorModelPtr;
+using models::behavior::BehaviorStatus;
+using models::behavior::Continuous1DAction;
+using models::behavior::DiscreteAction;
+using models::behavior::LonLatAction;
+using models::behavior::StateActionHistory;
+using models::dynamic::DynamicModelPtr;
+using models::dynamic::Input;
+using models::dynamic::State;
+using models::dynamic::Trajectory;
+using models::execution::ExecutionModelPtr;
+using models::execution::ExecutionStatus;
+using objects::Agent;
+using objects::AgentId;
+using objects::AgentPtr;
+using objects::Object;
+using objects::ObjectPtr;
+using world::evaluation::EvaluatorPtr;
+using world::goal_definition::GoalDefinitionPtr;
+
+namespace {
+
+const char kMagic[8] = {'B', 'A', 'R', 'K', 'W', 'R', 'L', 'D'};
+
+// type tags, only ever append to keep older data readable
+enum BehaviorType : uint8_t {
+  BEHAVIOR_CONSTANT_ACCELERATION = 0,
+  BEHAVIOR_IDM_CLASSIC = 1,
+  BEHAVIOR_IDM_LANE_TRACKING = 2,
+  BEHAVIOR_LANE_CHANGE_RULE_BASED = 3,
+  BEHAVIOR_INTERSECTION_RULE_BASED = 4,
+  BEHAVIOR_MOBIL_RULE_BASED = 5,
+  BEHAVIOR_STATIC_TRAJECTORY = 6,
+  BEHAVIOR_NOT_STARTED = 7,
+  BEHAVIOR_DYNAMIC_MODEL = 8
+};
+
+enum DynamicType : uint8_t { DYNAMIC_SINGLE_TRACK = 0 };
+
+enum ExecutionType : uint8_t {
+  EXECUTION_INTERPOLATE = 0,
+  EXECUTION_MPC_GAUSS_NEWTON = 1
+};
+
+enum GoalType : uint8_t {
+  GOAL_NONE = 0,
+  GOAL_POLYGON = 1,
+  GOAL_STATE_LIMITS = 2,
+  GOAL_STATE_LIMITS_FRENET = 3,
+  GOAL_SEQUENTIAL = 4
+};
+
+enum EvaluatorType : uint8_t {
+  EVALUATOR_GOAL_REACHED = 0,
+  EVALUATOR_DISTANCE_TO_GOAL = 1,
+  EVALUATOR_BEHAVIOR_EXPIRED = 2,
+  EVALUATOR_DRIVABLE_AREA = 3,
+  EVALUATOR_COLLISION_EGO_AGENT = 4,
+  EVALUATOR_COLLISION_AGENTS = 5,
+  EVALUATOR_STEP_COUNT = 6
+};
+
+template <typename T>
+bool IsType(const T& base, const std::type_info& type) {
+  return typeid(base) == type;
+}
+
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(std::string* buffer) : buffer_(buffer) {}
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable values can be written");
+    buffer_->append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void WriteString(const std::string& value) {
+    Write<uint32_t>(value.size());
+    buffer_->append(value);
+  }
+
+  void WriteDoubles(const double* values, std::size_t size) {
+    buffer_->append(reinterpret_cast<const char*>(values),
+                    size * sizeof(double));
+  }
+
+  void WriteVector(const Eigen::VectorXd& vector) {
+    Write<uint32_t>(vector.size());
+    WriteDoubles(vector.data(), vector.size());
+  }
+
+  void WriteMatrix(const Eigen::MatrixXd& matrix) {
+    Write<uint32_t>(matrix.rows());
+    Write<uint32_t>(matrix.cols());
+    WriteDoubles(matrix.data(), matrix.size());
+  }
+
+  void WritePoints(const std::vector<Point2d>& points) {
+    Write<uint32_t>(points.size());
+    for (const Point2d& point : points) {
+      Write<double>(boost::geometry::get<0>(point));
+      Write<double>(boost::geometry::get<1>(point));
+    }
+  }
+
+  void WritePolygon(const Polygon& polygon) {
+    Write<double>(polygon.center_(0));
+    Write<double>(polygon.center_(1));
+    Write<double>(polygon.center_(2));
+    WritePoints(polygon.obj_.outer());
+  }
+
+  void WriteLine(const Line& line) { WritePoints(line.obj_); }
+
+  void WriteAction(const Action& action) {
+    Write<uint8_t>(action.which());
+    if (const DiscreteAction* a = boost::get<DiscreteAction>(&action)) {
+      Write<DiscreteAction>(*a);
+    } else if (const Continuous1DAction* a =
+                   boost::get<Continuous1DAction>(&action)) {
+      Write<Continuous1DAction>(*a);
+    } else if (const Input* a = boost::get<Input>(&action)) {
+      WriteVector(*a);
+    } else {
+      const LonLatAction& lon_lat = boost::get<LonLatAction>(action);
+      Write<double>(lon_lat.acc_lat);
+      Write<double>(lon_lat.acc_lon);
+    }
+  }
+
+  void WritePair(const std::pair<double, double>& pair) {
+    Write<double>(pair.first);
+    Write<double>(pair.second);
+  }
+
+ private:
+  std::string* buffer_;
+};
+
+class BinaryReader {
+ public:
+  explicit BinaryReader(const std::string& buffer)
+      : data_(buffer.data()), size_(buffer.size()), offset_(0) {}
+
+  template <typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable values can be read");
+    T value;
+    std::memcpy(&value, Advance(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string ReadString() {
+    const uint32_t size = Read<uint32_t>();
+    return std::string(Advance(size), size);
+  }
+
+  void ReadDoubles(double* values, std::size_t size) {
+    std::memcpy(values, Advance(size * sizeof(double)), size * sizeof(double));
+  }
+
+  Eigen::VectorXd ReadVector() {
+    const uint32_t size = Read<uint32_t>();
+    CheckSize(static_cast<std::size_t>(size) * sizeof(double));
+    Eigen::VectorXd vector(size);
+    ReadDoubles(vector.data(), vector.size());
+    return vector;
+  }
+
+  Eigen::MatrixXd ReadMatrix() {
+    const uint32_t rows = Read<uint32_t>();
+    const uint32_t cols = Read<uint32_t>();
+    CheckSize(static_cast<std::size_t>(rows) * cols * sizeof(double));
+    Eigen::MatrixXd matrix(rows, cols);
+    ReadDoubles(matrix.data(), matrix.size());
+    return matrix;
+  }
+
+  std::vector<Point2d> ReadPoints() {
+    const uint32_t num_points = Read<uint32_t>();
+    CheckSize(static_cast<std::size_t>(num_points) * 2 * sizeof(double));
+    std::vector<Point2d> points;
+    points.reserve(num_points);
+    for (uint32_t i = 0; i < num_points; ++i) {
+      const double x = Read<double>();
+      const double y = Read<double>();
+      points.emplace_back(x, y);
+    }
+    return points;
+  }
+
+  Polygon ReadPolygon() {
+    const double x = Read<double>();
+    const double y = Read<double>();
+    const double theta = Read<double>();
+    return Polygon(Pose(x, y, theta), ReadPoints());
+  }
+
+  Line ReadLine() {
+    Line line;
+    for (const Point2d& point : ReadPoints()) {
+      line.AddPoint(point);
+    }
+    return line;
+  }
+
+  Action ReadAction() {
+    switch (Read<uint8_t>()) {
+      case 0:
+        return Action(Read<DiscreteAction>());
+      case 1:
+        return Action(Read<Continuous1DAction>());
+      case 2:
+        return Action(Input(ReadVector()));
+      case 3: {
+        LonLatAction lon_lat;
+        lon_lat.acc_lat = Read<double>();
+        lon_lat.acc_lon = Read<double>();
+        return Action(lon_lat);
+      }
+      default:
+        throw std::runtime_error("Invalid action type in serialized world!");
+    }
+  }
+
+  std::pair<double, double> ReadPair() {
+    const double first = Read<double>();
+    const double second = Read<double>();
+    return std::make_pair(first, second);
+  }
+
+  bool AtEnd() const { return offset_ == size_; }
+
+  //! throws if less than size bytes are left
+  void CheckSize(std::size_t size) const {
+    if (size > size_ - offset_) {
+      throw std::runtime_error("Serialized world is truncated!");
+    }
+  }
+
+ private:
+
+  const char* Advance(std::size_t size) {
+    CheckSize(size);
+    const char* position = data_ + offset_;
+    offset_ += size;
+    return position;
+  }
+
+  const char* data_;
+  std::size_t size_;
+  std::size_t offset_;
+};
+
+//! parameters are often shared between models, so they are stored once
+class ParamsTable {
+ public:
+  int32_t Add(const ParamsPtr& params) {
+    if (!params) {
+      return -1;
+    }
+    auto it = indices_.find(params.get());
+    if (it != indices_.end()) {
+      return it->second;
+    }
+    const int32_t index = params_.size();
+    indices_[params.get()] = index;
+    params_.push_back(params);
+    return index;
+  }
+
+  void Write(BinaryWriter* writer) const {
+    writer->Write<uint32_t>(params_.size());
+    for (const ParamsPtr& params : params_) {
+      const CondensedParamList param_list = params->GetCondensedParamList();
+      writer->Write<uint32_t>(param_list.size());
+      for (const auto& param : param_list) {
+        writer->WriteString(param.first);
+        writer->Write<uint8_t>(param.second.which());
+        if (const bool* value = boost::get<bool>(&param.second)) {
+          writer->Write<uint8_t>(*value);
+        } else if (const double* value = boost::get<double>(&param.second)) {
+          writer->Write<double>(*value);
+        } else if (const int* value = boost::get<int>(&param.second)) {
+          writer->Write<int32_t>(*value);
+        } else if (const std::string* value =
+                       boost::get<std::string>(&param.second)) {
+          writer->WriteString(*value);
+        } else if (const ListListFloat* value =
+                       boost::get<ListListFloat>(&param.second)) {
+          writer->Write<uint32_t>(value->size());
+          for (const ListFloat& list : *value) {
+            writer->Write<uint32_t>(list.size());
+            writer->WriteDoubles(list.data(), list.size());
+          }
+        } else {
+          const ListFloat& list = boost::get<ListFloat>(param.second);
+          writer->Write<uint32_t>(list.size());
+          writer->WriteDoubles(list.data(), list.size());
+        }
+      }
+    }
+  }
+
+  void Read(BinaryReader* reader) {
+    const uint32_t num_params = reader->Read<uint32_t>();
+    for (uint32_t i = 0; i < num_params; ++i) {
+      CondensedParamList param_list;
+      const uint32_t num_values = reader->Read<uint32_t>();
+      for (uint32_t j = 0; j < num_values; ++j) {
+        const std::string name = reader->ReadString();
+        switch (reader->Read<uint8_t>()) {
+          case 0:
+            param_list.emplace_back(name,
+                                    Parameter(reader->Read<uint8_t>() != 0));
+            break;
+          case 1:
+            param_list.emplace_back(name, Parameter(reader->Read<double>()));
+            break;
+          case 2:
+            param_list.emplace_back(
+                name, Parameter(static_cast<int>(reader->Read<int32_t>())));
+            break;
+          case 3:
+            param_list.emplace_back(name, Parameter(reader->ReadString()));
+            break;
+          case 4: {
+            const uint32_t num_lists = reader->Read<uint32_t>();
+            reader->CheckSize(static_cast<std::size_t>(num_lists) *
+                              sizeof(uint32_t));
+            ListListFloat lists(num_lists);
+            for (ListFloat& list : lists) {
+              list = ReadList(reader);
+            }
+            param_list.emplace_back(name, Parameter(lists));
+            break;
+          }
+          case 5:
+            param_list.emplace_back(name, Parameter(ReadList(reader)));
+            break;
+          default:
+            throw std::runtime_error(
+                "Invalid parameter type in serialized world!");
+        }
+      }
+      params_.push_back(std::make_shared<SetterParams>(false, param_list));
+    }
+  }
+
+  ParamsPtr Get(int32_t index) const {
+    if (index < 0) {
+      return nullptr;
+    }
+    if (static_cast<std::size_t>(index) >= params_.size()) {
+      throw std::runtime_error("Invalid parameter index in serialized world!");
+    }
+    return params_[index];
+  }
+
+ private:
+  static ListFloat ReadList(BinaryReader* reader) {
+    const uint32_t size = reader->Read<uint32_t>();
+    reader->CheckSize(static_cast<std::size_t>(size) * sizeof(double));
+    ListFloat list(size);
+    reader->ReadDoubles(list.data(), list.size());
+    return list;
+  }
+
+  std::map<const commons::Params*, int32_t> indices_;
+  std::vector<ParamsPtr> params_;
+};
+
+//! evaluator type with its constructor arguments
+struct EvaluatorRecord {
+  uint8_t type = 0;
+  AgentId agent_id = 0;  //! observed agent of agent-based evaluators
+  int32_t steps = 0;     //! counted steps of EvaluatorStepCount
+};
+
+//! returns false for evaluators that cannot be serialized
+bool GetEvaluatorRecord(const evaluation::BaseEvaluator& e,
+                        EvaluatorRecord* record) {
+  using namespace bark::world::evaluation;
+  *record = EvaluatorRecord();
+  if (IsType(e, typeid(EvaluatorGoalReached))) {
+    record->type = EVALUATOR_GOAL_REACHED;
+    record->agent_id = static_cast<const EvaluatorGoalReached&>(e).GetAgentId();
+  } else if (IsType(e, typeid(EvaluatorDistanceToGoal))) {
+    record->type = EVALUATOR_DISTANCE_TO_GOAL;
+    record->agent_id =
+        static_cast<const EvaluatorDistanceToGoal&>(e).GetAgentId();
+  } else if (IsType(e, typeid(EvaluatorBehaviorExpired))) {
+    record->type = EVALUATOR_BEHAVIOR_EXPIRED;
+    record->agent_id =
+        static_cast<const EvaluatorBehaviorExpired&>(e).GetAgentId();
+  } else if (IsType(e, typeid(EvaluatorDrivableArea))) {
+    record->type = EVALUATOR_DRIVABLE_AREA;
+    record->agent_id =
+        static_cast<const EvaluatorDrivableArea&>(e).GetAgentId();
+  } else if (IsType(e, typeid(EvaluatorCollisionEgoAgent))) {
+    record->type = EVALUATOR_COLLISION_EGO_AGENT;
+    record->agent_id =
+        static_cast<const EvaluatorCollisionEgoAgent&>(e).GetAgentId();
+  } else if (IsType(e, typeid(EvaluatorCollisionAgents))) {
+    record->type = EVALUATOR_COLLISION_AGENTS;
+  } else if (IsType(e, typeid(EvaluatorStepCount))) {
+    record->type = EVALUATOR_STEP_COUNT;
+    record->steps = static_cast<const EvaluatorStepCount&>(e).GetSteps();
+  } else {
+    return false;
+  }
+  return true;
+}
+
+//! index of the lane corridor in the road corridor of the agent, -1 if none
+int32_t GetLaneCorridorIndex(const Agent& agent,
+                             const map::LaneCorridorPtr& lane_corridor) {
+  if (!lane_corridor) {
+    return -1;
+  }
+  const auto& road_corridor = agent.GetRoadCorridor();
+  if (road_corridor) {
+    const auto lane_corridors = road_corridor->GetUniqueLaneCorridors();
+    for (std::size_t i = 0; i < lane_corridors.size(); ++i) {
+      if (lane_corridors[i] == lane_corridor) {
+        return i;
+      }
+    }
+  }
+  throw std::runtime_error(
+      "Lane corridor of agent " + std::to_string(agent.GetAgentId()) +
+      " is not part of its road corridor and cannot be serialized!");
+}
+
+map::LaneCorridorPtr GetLaneCorridor(const Agent& agent, int32_t index) {
+  if (index < 0) {
+    return nullptr;
+  }
+  const auto& road_corridor = agent.GetRoadCorridor();
+  if (!road_corridor ||
+      static_cast<std::size_t>(index) >=
+          road_corridor->GetUniqueLaneCorridors().size()) {
+    throw std::runtime_error(
+        "Invalid lane corridor index in serialized world!");
+  }
+  return road_corridor->GetUniqueLaneCorridors()[index];
+}
+
+// Serialization is done in two passes: the models are written into a body
+// buffer while collecting their parameters, then the parameter table is
+// written in front of the body.
+class WorldWriter {
+ public:
+  explicit WorldWriter(std::string* body) : writer_(body) {}
+
+  void WriteObject(const Object& object) {
+    writer_.Write<AgentId>(object.GetAgentId());
+    writer_.Write<int32_t>(params_.Add(object.GetParams()));
+    writer_.WritePolygon(object.GetShape());
+  }
+
+  void WriteAgent(const Agent& agent) {
+    WriteObject(agent);
+    writer_.Write<double>(agent.GetFirstValidTimestamp());
+    const StateActionHistory history = agent.GetStateInputHistory();
+    writer_.Write<uint32_t>(history.size());
+    for (const auto& state_action : history) {
+      writer_.WriteVector(state_action.first);
+      writer_.WriteAction(state_action.second);
+    }
+    WriteBehaviorModel(agent);
+    WriteDynamicModel(agent.GetDynamicModel());
+    WriteExecutionModel(agent.GetExecutionModel());
+    WriteGoalDefinition(agent.GetGoalDefinition());
+  }
+
+  bool WriteEvaluator(const std::string& name, const EvaluatorPtr& evaluator) {
+    EvaluatorRecord record;
+    if (!GetEvaluatorRecord(*evaluator, &record)) {
+      return false;
+    }
+    writer_.WriteString(name);
+    writer_.Write<uint8_t>(record.type);
+    writer_.Write<AgentId>(record.agent_id);
+    writer_.Write<int32_t>(record.steps);
+    return true;
+  }
+
+  int32_t AddParams(const ParamsPtr& params) { return params_.Add(params); }
+  const ParamsTable& GetParamsTable() const { return params_; }
+  BinaryWriter* GetWriter() { return &writer_; }
+
+ private:
+  void WriteBehaviorModel(const Agent& agent) {
+    using namespace bark::models::behavior;
+    const BehaviorModel& b = *agent.GetBehaviorModel();
+    uint8_t type;
+    if (IsType(b, typeid(BehaviorConstantAcceleration))) {
+      type = BEHAVIOR_CONSTANT_ACCELERATION;
+    } else if (IsType(b, typeid(BehaviorIDMClassic))) {
+      type = BEHAVIOR_IDM_CLASSIC;
+    } else if (IsType(b, typeid(BehaviorIDMLaneTracking))) {
+      type = BEHAVIOR_IDM_LANE_TRACKING;
+    } else if (IsType(b, typeid(BehaviorLaneChangeRuleBased))) {
+      type = BEHAVIOR_LANE_CHANGE_RULE_BASED;
+    } else if (IsType(b, typeid(BehaviorIntersectionRuleBased))) {
+      type = BEHAVIOR_INTERSECTION_RULE_BASED;
+    } else if (IsType(b, typeid(BehaviorMobilRuleBased))) {
+      type = BEHAVIOR_MOBIL_RULE_BASED;
+    } else if (IsType(b, typeid(BehaviorStaticTrajectory))) {
+      type = BEHAVIOR_STATIC_TRAJECTORY;
+    } else if (IsType(b, typeid(BehaviorNotStarted))) {
+      type = BEHAVIOR_NOT_STARTED;
+    } else if (IsType(b, typeid(BehaviorDynamicModel))) {
+      type = BEHAVIOR_DYNAMIC_MODEL;
+    } else {
+      throw std::runtime_error(std::string("Behavior model ") +
+                               typeid(b).name() + " cannot be serialized!");
+    }
+    writer_.Write<uint8_t>(type);
+    writer_.Write<int32_t>(params_.Add(b.GetParams()));
+    writer_.Write<uint32_t>(b.GetBehaviorStatus());
+    writer_.Write<double>(b.GetLastSolutionTime());
+    writer_.WriteAction(b.GetLastAction());
+    writer_.WriteAction(b.GetAction());
+    writer_.WriteMatrix(b.GetLastTrajectory());
+    if (type == BEHAVIOR_STATIC_TRAJECTORY) {
+      writer_.WriteMatrix(
+          static_cast<const BehaviorStaticTrajectory&>(b).GetStaticTrajectory());
+    }
+    // the lane corridors an IDM plans on are kept between steps
+    if (const BaseIDM* idm = dynamic_cast<const BaseIDM*>(&b)) {
+      writer_.Write<int32_t>(
+          GetLaneCorridorIndex(agent, idm->GetLaneCorridor()));
+      writer_.Write<int32_t>(
+          GetLaneCorridorIndex(agent, idm->GetConstantLaneCorridor()));
+    }
+  }
+
+  void WriteDynamicModel(const DynamicModelPtr& dynamic_model) {
+    using bark::models::dynamic::SingleTrackModel;
+    if (!IsType(*dynamic_model, typeid(SingleTrackModel))) {
+      throw std::runtime_error(std::string("Dynamic model ") +
+                               typeid(*dynamic_model).name() +
+                               " cannot be serialized!");
+    }
+    writer_.Write<uint8_t>(DYNAMIC_SINGLE_TRACK);
+    writer_.Write<int32_t>(params_.Add(dynamic_model->GetParams()));
+  }
+
+  void WriteExecutionModel(const ExecutionModelPtr& execution_model) {
+    using bark::models::execution::ExecutionModelInterpolate;
+    using bark::models::execution::ExecutionModelMpcGaussNewton;
+    uint8_t type;
+    if (IsType(*execution_model, typeid(ExecutionModelInterpolate))) {
+      type = EXECUTION_INTERPOLATE;
+    } else if (IsType(*execution_model,
+                      typeid(ExecutionModelMpcGaussNewton))) {
+      type = EXECUTION_MPC_GAUSS_NEWTON;
+    } else {
+      throw std::runtime_error(std::string("Execution model ") +
+                               typeid(*execution_model).name() +
+                               " cannot be serialized!");
+    }
+    writer_.Write<uint8_t>(type);
+    writer_.Write<int32_t>(params_.Add(execution_model->GetParams()));
+    writer_.Write<uint32_t>(execution_model->GetExecutionStatus());
+    writer_.WriteVector(execution_model->GetExecutedState());
+    writer_.WriteMatrix(execution_model->GetLastTrajectory());
+  }
+
+  void WriteGoalDefinition(const GoalDefinitionPtr& goal_definition) {
+    using namespace bark::world::goal_definition;
+    if (!goal_definition) {
+      writer_.Write<uint8_t>(GOAL_NONE);
+      return;
+    }
+    const GoalDefinition& g = *goal_definition;
+    if (IsType(g, typeid(GoalDefinitionPolygon))) {
+      writer_.Write<uint8_t>(GOAL_POLYGON);
+      writer_.WritePolygon(g.GetShape());
+    } else if (IsType(g, typeid(GoalDefinitionStateLimits))) {
+      const auto& goal = static_cast<const GoalDefinitionStateLimits&>(g);
+      writer_.Write<uint8_t>(GOAL_STATE_LIMITS);
+      writer_.WritePolygon(goal.GetXyLimits());
+      writer_.WritePair(goal.GetAngleLimits());
+    } else if (IsType(g, typeid(GoalDefinitionStateLimitsFrenet))) {
+      const auto& goal = static_cast<const GoalDefinitionStateLimitsFrenet&>(g);
+      writer_.Write<uint8_t>(GOAL_STATE_LIMITS_FRENET);
+      writer_.WriteLine(goal.GetCenterLine());
+      writer_.WritePair(goal.GetMaxLateralDistance());
+      writer_.WritePair(goal.GetMaxOrientationDifferences());
+      writer_.WritePair(goal.GetVelocityRange());
+    } else if (IsType(g, typeid(GoalDefinitionSequential))) {
+      const auto& goal = static_cast<const GoalDefinitionSequential&>(g);
+      writer_.Write<uint8_t>(GOAL_SEQUENTIAL);
+      const auto sequential_goals = goal.GetSequentialGoals();
+      writer_.Write<uint32_t>(sequential_goals.size());
+      for (const auto& sequential_goal : sequential_goals) {
+        WriteGoalDefinition(sequential_goal);
+      }
+    } else {
+      throw std::runtime_error(std::string("Goal definition ") +
+                               typeid(g).name() + " cannot be serialized!");
+    }
+  }
+
+  BinaryWriter writer_;
+  ParamsTable params_;
+};
+
+class WorldReader {
+ public:
+  WorldReader(BinaryReader* reader, const ParamsTable& params,
+              const map::MapInterfacePtr& map)
+      : reader_(reader), params_(params), map_(map) {}
+
+  ObjectPtr ReadObject() {
+    const AgentId agent_id = reader_->Read<AgentId>();
+    const ParamsPtr params = params_.Get(reader_->Read<int32_t>());
+    auto object = std::make_shared<Object>(reader_->ReadPolygon(), params);
+    object->SetAgentId(agent_id);
+    return object;
+  }
+
+  AgentPtr ReadAgent() {
+    const AgentId agent_id = reader_->Read<AgentId>();
+    const ParamsPtr params = params_.Get(reader_->Read<int32_t>());
+    const Polygon shape = reader_->ReadPolygon();
+    const double first_valid_timestamp = reader_->Read<double>();
+    StateActionHistory history(reader_->Read<uint32_t>());
+    for (auto& state_action : history) {
+      state_action.first = reader_->ReadVector();
+      state_action.second = reader_->ReadAction();
+    }
+    if (history.empty()) {
+      throw std::runtime_error("Agent without state in serialized world!");
+    }
+    int32_t lane_corridor_index = -1, constant_lane_corridor_index = -1;
+    const BehaviorModelPtr behavior_model = ReadBehaviorModel(
+        &lane_corridor_index, &constant_lane_corridor_index);
+    const DynamicModelPtr dynamic_model = ReadDynamicModel();
+    const ExecutionModelPtr execution_model = ReadExecutionModel();
+    const GoalDefinitionPtr goal_definition = ReadGoalDefinition();
+
+    auto agent = std::make_shared<Agent>(
+        history.back().first, behavior_model, dynamic_model, execution_model,
+        shape, params, goal_definition, map_);
+    agent->SetAgentId(agent_id);
+    agent->SetFirstValidTimestamp(first_valid_timestamp);
+    agent->SetStateInputHistory(history);
+    // lane corridors are resolved in the road corridor of the new agent
+    if (auto idm = std::dynamic_pointer_cast<models::behavior::BaseIDM>(
+            behavior_model)) {
+      idm->SetLaneCorridor(GetLaneCorridor(*agent, lane_corridor_index));
+      idm->SetConstantLaneCorridor(
+          GetLaneCorridor(*agent, constant_lane_corridor_index));
+    }
+    return agent;
+  }
+
+  EvaluatorPtr ReadEvaluator() {
+    using namespace bark::world::evaluation;
+    EvaluatorRecord record;
+    record.type = reader_->Read<uint8_t>();
+    record.agent_id = reader_->Read<AgentId>();
+    record.steps = reader_->Read<int32_t>();
+    const AgentId agent_id = record.agent_id;
+    switch (record.type) {
+      case EVALUATOR_GOAL_REACHED:
+        return std::make_shared<EvaluatorGoalReached>(agent_id);
+      case EVALUATOR_DISTANCE_TO_GOAL:
+        return std::make_shared<EvaluatorDistanceToGoal>(agent_id);
+      case EVALUATOR_BEHAVIOR_EXPIRED:
+        return std::make_shared<EvaluatorBehaviorExpired>(agent_id);
+      case EVALUATOR_DRIVABLE_AREA:
+        return std::make_shared<EvaluatorDrivableArea>(agent_id);
+      case EVALUATOR_COLLISION_EGO_AGENT:
+        return std::make_shared<EvaluatorCollisionEgoAgent>(agent_id);
+      case EVALUATOR_COLLISION_AGENTS:
+        return std::make_shared<EvaluatorCollisionAgents>();
+      case EVALUATOR_STEP_COUNT: {
+        auto evaluator = std::make_shared<EvaluatorStepCount>();
+        evaluator->SetSteps(record.steps);
+        return evaluator;
+      }
+      default:
+        throw std::runtime_error("Invalid evaluator type in serialized world!");
+    }
+  }
+
+ private:
+  //! the lane corridor indices of IDM models are returned, as they can
+  //! only be resolved once the agent has its road corridor
+  BehaviorModelPtr ReadBehaviorModel(int32_t* lane_corridor_index,
+                                     int32_t* constant_lane_corridor_index) {
+    using namespace bark::models::behavior;
+    const uint8_t type = reader_->Read<uint8_t>();
+    const ParamsPtr params = params_.Get(reader_->Read<int32_t>());
+    const BehaviorStatus status =
+        static_cast<BehaviorStatus>(reader_->Read<uint32_t>());
+    const double last_solution_time = reader_->Read<double>();
+    const Action last_action = reader_->ReadAction();
+    const Action action_to_behavior = reader_->ReadAction();
+    const Trajectory last_trajectory = reader_->ReadMatrix();
+
+    BehaviorModelPtr behavior_model;
+    switch (type) {
+      case BEHAVIOR_CONSTANT_ACCELERATION:
+        behavior_model = std::make_shared<BehaviorConstantAcceleration>(params);
+        break;
+      case BEHAVIOR_IDM_CLASSIC:
+        behavior_model = std::make_shared<BehaviorIDMClassic>(params);
+        break;
+      case BEHAVIOR_IDM_LANE_TRACKING:
+        behavior_model = std::make_shared<BehaviorIDMLaneTracking>(params);
+        break;
+      case BEHAVIOR_LANE_CHANGE_RULE_BASED:
+        behavior_model = std::make_shared<BehaviorLaneChangeRuleBased>(params);
+        break;
+      case BEHAVIOR_INTERSECTION_RULE_BASED:
+        behavior_model =
+            std::make_shared<BehaviorIntersectionRuleBased>(params);
+        break;
+      case BEHAVIOR_MOBIL_RULE_BASED:
+        behavior_model = std::make_shared<BehaviorMobilRuleBased>(params);
+        break;
+      case BEHAVIOR_STATIC_TRAJECTORY:
+        behavior_model = std::make_shared<BehaviorStaticTrajectory>(
+            params, reader_->ReadMatrix());
+        break;
+      case BEHAVIOR_NOT_STARTED:
+        behavior_model = std::make_shared<BehaviorNotStarted>(params);
+        break;
+      case BEHAVIOR_DYNAMIC_MODEL:
+        behavior_model = std::make_shared<BehaviorDynamicModel>(params);
+        break;
+      default:
+        throw std::runtime_error(
+            "Invalid behavior model type in serialized world!");
+    }
+    behavior_model->SetBehaviorStatus(status);
+    behavior_model->SetLastSolutionTime(last_solution_time);
+    behavior_model->SetLastAction(last_action);
+    behavior_model->ActionToBehavior(action_to_behavior);
+    behavior_model->SetLastTrajectory(last_trajectory);
+    if (std::dynamic_pointer_cast<BaseIDM>(behavior_model)) {
+      *lane_corridor_index = reader_->Read<int32_t>();
+      *constant_lane_corridor_index = reader_->Read<int32_t>();
+    }
+    return behavior_model;
+  }
+
+  DynamicModelPtr ReadDynamicModel() {
+    if (reader_->Read<uint8_t>() != DYNAMIC_SINGLE_TRACK) {
+      throw std::runtime_error(
+          "Invalid dynamic model type in serialized world!");
+    }
+    return std::make_shared<models::dynamic::SingleTrackModel>(
+        params_.Get(reader_->Read<int32_t>()));
+  }
+
+  ExecutionModelPtr ReadExecutionModel() {
+    using bark::models::execution::ExecutionModelInterpolate;
+    using bark::models::execution::ExecutionModelMpcGaussNewton;
+    const uint8_t type = reader_->Read<uint8_t>();
+    const ParamsPtr params = params_.Get(reader_->Read<int32_t>());
+    ExecutionModelPtr execution_model;
+    switch (type) {
+      case EXECUTION_INTERPOLATE:
+        execution_model = std::make_shared<ExecutionModelInterpolate>(params);
+        break;
+      case EXECUTION_MPC_GAUSS_NEWTON:
+        execution_model =
+            std::make_shared<ExecutionModelMpcGaussNewton>(params);
+        break;
+      default:
+        throw std::runtime_error(
+            "Invalid execution model type in serialized world!");
+    }
+    execution_model->SetExecutionStatus(
+        static_cast<ExecutionStatus>(reader_->Read<uint32_t>()));
+    execution_model->SetLastState(reader_->ReadVector());
+    execution_model->SetLastTrajectory(reader_->ReadMatrix());
+    return execution_model;
+  }
+
+  GoalDefinitionPtr ReadGoalDefinition() {
+    using namespace bark::world::goal_definition;
+    switch (reader_->Read<uint8_t>()) {
+      case GOAL_NONE:
+        return nullptr;
+      case GOAL_POLYGON:
+        return std::make_shared<GoalDefinitionPolygon>(reader_->ReadPolygon());
+      case GOAL_STATE_LIMITS: {
+        const Polygon xy_limits = reader_->ReadPolygon();
+        return std::make_shared<GoalDefinitionStateLimits>(
+            xy_limits, reader_->ReadPair());
+      }
+      case GOAL_STATE_LIMITS_FRENET: {
+        const Line center_line = reader_->ReadLine();
+        const auto max_lateral_distances = reader_->ReadPair();
+        const auto max_orientation_differences = reader_->ReadPair();
+        const auto velocity_range = reader_->ReadPair();
+        return std::make_shared<GoalDefinitionStateLimitsFrenet>(
+            center_line, max_lateral_distances, max_orientation_differences,
+            velocity_range);
+      }
+      case GOAL_SEQUENTIAL: {
+        std::vector<GoalDefinitionPtr> sequential_goals(
+            reader_->Read<uint32_t>());
+        for (auto& sequential_goal : sequential_goals) {
+          sequential_goal = ReadGoalDefinition();
+        }
+        return std::make_shared<GoalDefinitionSequential>(sequential_goals);
+      }
+      default:
+        throw std::runtime_error(
+            "Invalid goal definition type in serialized world!");
+    }
+  }
+
+  BinaryReader* reader_;
+  const ParamsTable& params_;
+  map::MapInterfacePtr map_;
+};
+
+void HashBytes(const void* data, std::size_t size, uint64_t* hash) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    *hash = (*hash ^ bytes[i]) * 1099511628211ull;
+  }
+}
+
+void HashLine(const Line& line, uint64_t* hash) {
+  for (const Point2d& point : line.obj_) {
+    const double xy[2] = {boost::geometry::get<0>(point),
+                          boost::geometry::get<1>(point)};
+    HashBytes(xy, sizeof(xy), hash);
+  }
+}
+
+}  // namespace
+
+uint64_t ComputeMapHash(const map::MapInterfacePtr& map) {
+  if (!map || !map->GetOpenDriveMap()) {
+    return 0;
+  }
+  // FNV-1a over the road geometry, lane ids are not hashed as they are
+  // assigned by a global counter when the map is created
+  uint64_t hash = 14695981039346656037ull;
+  for (const auto& road : map->GetOpenDriveMap()->GetRoads()) {
+    HashBytes(&road.first, sizeof(road.first), &hash);
+    if (road.second->GetPlanView()) {
+      HashLine(road.second->GetPlanView()->GetReferenceLine(), &hash);
+    }
+    for (const auto& lane_section : road.second->GetLaneSections()) {
+      for (const auto& lane : lane_section->GetLanes()) {
+        const int32_t lane_position = lane.second->GetLanePosition();
+        HashBytes(&lane_position, sizeof(lane_position), &hash);
+        HashLine(lane.second->GetLine(), &hash);
+      }
+    }
+  }
+  return hash;
+}
+
+std::string SerializeWorld(const World& world) {
+  std::string body;
+  WorldWriter world_writer(&body);
+  BinaryWriter* writer = world_writer.GetWriter();
+
+  const auto objects = world.GetObjects();
+  writer->Write<uint32_t>(objects.size());
+  for (const auto& object : objects) {
+    world_writer.WriteObject(*object.second);
+  }
+
+  const auto agents = world.GetAgents();
+  writer->Write<uint32_t>(agents.size());
+  for (const auto& agent : agents) {
+    world_writer.WriteAgent(*agent.second);
+  }
+
+  std::vector<std::pair<std::string, EvaluatorPtr>> evaluators;
+  EvaluatorRecord record;
+  for (const auto& evaluator : world.GetEvaluators()) {
+    if (GetEvaluatorRecord(*evaluator.second, &record)) {
+      evaluators.push_back(evaluator);
+    } else {
+      LOG(WARNING) << "Evaluator " << evaluator.first
+                   << " is not serialized.";
+    }
+  }
+  writer->Write<uint32_t>(evaluators.size());
+  for (const auto& evaluator : evaluators) {
+    world_writer.WriteEvaluator(evaluator.first, evaluator.second);
+  }
+
+  // the header and parameter table are known only after the models
+  std::string data;
+  BinaryWriter header(&data);
+  data.append(kMagic, sizeof(kMagic));
+  header.Write<uint32_t>(kWorldSerializationVersion);
+  header.Write<uint64_t>(ComputeMapHash(world.GetMap()));
+  header.Write<double>(world.GetWorldTime());
+  header.Write<uint8_t>(world.GetRemoveAgents());
+  const int32_t world_params = world_writer.AddParams(world.GetParams());
+  world_writer.GetParamsTable().Write(&header);
+  header.Write<int32_t>(world_params);
+  data.append(body);
+  return data;
+}
+
+WorldPtr DeserializeWorld(const std::string& data,
+                          const map::MapInterfacePtr& map) {
+  BinaryReader reader(data);
+  char magic[sizeof(kMagic)];
+  for (char& c : magic) {
+    c = reader.Read<char>();
+  }
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("Data is not a serialized world!");
+  }
+  const uint32_t version = reader.Read<uint32_t>();
+  if (version != kWorldSerializationVersion) {
+    throw std::runtime_error("Unsupported serialized world version " +
+                             std::to_string(version) + "!");
+  }
+  const uint64_t map_hash = reader.Read<uint64_t>();
+  if (map_hash != ComputeMapHash(map)) {
+    throw std::runtime_error(
+        "Map does not match the map of the serialized world!");
+  }
+  const double world_time = reader.Read<double>();
+  const bool remove_agents = reader.Read<uint8_t>() != 0;
+  ParamsTable params;
+  params.Read(&reader);
+  const ParamsPtr world_params = params.Get(reader.Read<int32_t>());
+  if (!world_params) {
+    throw std::runtime_error("World without parameters in serialized world!");
+  }
+
+  auto world = std::make_shared<World>(world_params);
+  world->SetMap(map);
+  world->SetWorldTime(world_time);
+  world->SetRemoveAgents(remove_agents);
+
+  WorldReader world_reader(&reader, params, map);
+  const uint32_t num_objects = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < num_objects; ++i) {
+    world->AddObject(world_reader.ReadObject());
+  }
+  const uint32_t num_agents = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < num_agents; ++i) {
+    world->AddAgent(world_reader.ReadAgent());
+  }
+  const uint32_t num_evaluators = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < num_evaluators; ++i) {
+    const std::string name = reader.ReadString();
+    world->AddEvaluator(name, world_reader.ReadEvaluator());
+  }
+  if (!reader.AtEnd()) {
+    throw std::runtime_error("Unexpected trailing data in serialized world!");
+  }
+  world->UpdateAgentRTree();
+  return world;
+}
+
+}  // namespace serialization
+}  // namespace world
+}  // namespace bark
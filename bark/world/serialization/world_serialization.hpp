@@ -0,0 +1,59 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef BARK_WORLD_SERIALIZATION_WORLD_SERIALIZATION_HPP_
+#define BARK_WORLD_SERIALIZATION_WORLD_SERIALIZATION_HPP_
+
+#include <cstdint>
+#include <string>
+
+#include "bark/world/map/map_interface.hpp"
+#include "bark/world/world.hpp"
+
+namespace bark {
+namespace world {
+namespace serialization {
+
+//! incremented whenever the binary layout changes
+const uint32_t kWorldSerializationVersion = 2;
+
+/**
+ * @brief Stable 64-bit hash of the road geometry of a map
+ *
+ * Covers road ids, lane positions as well as the reference and lane lines
+ * of the OpenDrive map. Returns 0 for an empty map interface.
+ */
+uint64_t ComputeMapHash(const map::MapInterfacePtr& map);
+
+/**
+ * @brief Serializes the world into a compact, versioned binary string
+ *
+ * Contains the world time, all parameters, objects, agents with their
+ * histories, goal definitions, behavior, dynamic and execution model state
+ * including the lane corridors of IDM models as well as the agent-based
+ * evaluators. The map is only referenced by its
+ * content hash. Throws a std::runtime_error for behavior models or goal
+ * definitions that cannot be serialized and for IDM lane corridors outside
+ * the road corridor of the agent; unsupported evaluators are skipped.
+ */
+std::string SerializeWorld(const World& world);
+
+/**
+ * @brief Restores a world serialized with SerializeWorld
+ *
+ * @param data binary string returned by SerializeWorld
+ * @param map map of the serialized world, is verified against the hash
+ */
+WorldPtr DeserializeWorld(const std::string& data,
+                          const map::MapInterfacePtr& map);
+
+}  // namespace serialization
+}  // namespace world
+}  // namespace bark
+
+#endif  // BARK_WORLD_SERIALIZATION_WORLD_SERIALIZATION_HPP_
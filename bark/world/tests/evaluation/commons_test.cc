@@ -22,8 +22,8 @@ TEST(capture_test, base_functionality) {
   auto captured_states = CaptureAgentStates(*world);
   //   eval_res["capture_states"]);
   EXPECT_EQ(captured_states.size(), 2);
-  EXPECT_EQ(captured_states["state_1"], world->GetAgents()[1]->GetCurrentState());
-  EXPECT_EQ(captured_states["state_2"], world->GetAgents()[2]->GetCurrentState());
+  EXPECT_EQ(captured_states["state_1"], world->GetAgent(1)->GetCurrentState());
+  EXPECT_EQ(captured_states["state_2"], world->GetAgent(2)->GetCurrentState());
 
 }
 
@@ -6,9 +6,13 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <chrono>
+#include <iostream>
+
 #include "gtest/gtest.h"
 
 #include "bark/world/evaluation/ltl/label_functions/agent_near_label_function.hpp"
+#include "bark/world/evaluation/ltl/label_functions/dense_traffic_label_function.hpp"
 #include "bark/world/evaluation/ltl/label_functions/lane_change_label_function.hpp"
 #include "bark/world/evaluation/ltl/label_functions/left_of_label_function.hpp"
 #include "bark/world/evaluation/ltl/label_functions/rel_speed_label_function.hpp"
@@ -30,6 +34,31 @@ using namespace bark::models::behavior;
 using namespace bark::models::behavior::primitives;
 
 using bark::commons::SetterParams;
+using bark::geometry::Distance;
+using bark::models::dynamic::State;
+using bark::models::dynamic::StateDefinition;
+using bark::world::WorldPtr;
+using bark::world::objects::Agent;
+using bark::world::objects::AgentPtr;
+
+// ego agent 1 at the origin of a grid of num_agents other agents
+WorldPtr MakeGridWorld(int num_agents, double spacing) {
+  auto world = make_test_world(1, 5.0, 20.0, 0.0);
+  const auto other_agent = world->GetAgent(2);
+  world->RemoveAgentById(2);
+  const int num_columns = static_cast<int>(std::ceil(std::sqrt(num_agents)));
+  for (int i = 0; i < num_agents; ++i) {
+    auto agent = std::dynamic_pointer_cast<Agent>(other_agent->Clone());
+    State state = agent->GetCurrentState();
+    state(StateDefinition::X_POSITION) += spacing * (i % num_columns);
+    state(StateDefinition::Y_POSITION) += spacing * (i / num_columns);
+    agent->SetCurrentState(state);
+    agent->SetAgentId(10 + i);
+    world->AddAgent(agent);
+  }
+  world->UpdateAgentRTree();
+  return world;
+}
 
 TEST(label_test, right_of) {
   auto evaluator = LabelFunctionPtr(new RightOfLabelFunction("r_v"));
@@ -258,6 +287,74 @@ TEST(label_test, agent_near) {
   EXPECT_FALSE(labels2[label2]);
 }
 
+TEST(label_test, agent_near_pruned) {
+  auto evaluator = LabelFunctionPtr(new AgentNearLabelFunction("near", 12.0));
+  auto world = MakeGridWorld(100, 4.0);
+  const auto observed_world = world->Observe({1})[0];
+  const auto labels = evaluator->Evaluate(observed_world);
+  const auto ego_agent = observed_world.GetEgoAgent();
+  const auto poly_ego =
+      ego_agent->GetPolygonFromState(ego_agent->GetCurrentState());
+
+  // every agent is labeled, the result equals the exact distance check
+  ASSERT_EQ(labels.size(), 100);
+  int num_near = 0;
+  for (const auto& agent : observed_world.GetValidOtherAgents()) {
+    const auto poly_other =
+        agent.second->GetPolygonFromState(agent.second->GetCurrentState());
+    const bool near = Distance(poly_ego, poly_other) < 12.0;
+    EXPECT_EQ(labels.at(evaluator->GetLabel(agent.first)), near);
+    num_near += near;
+  }
+  EXPECT_GT(num_near, 0);
+  EXPECT_LT(num_near, 100);
+  EXPECT_LT(observed_world.GetValidOtherAgentsWithinRadius(12.0).size(), 100);
+
+  // agents added after the last index update are found as well
+  auto agent = std::dynamic_pointer_cast<Agent>(world->GetAgent(10)->Clone());
+  agent->SetAgentId(1000);
+  world->AddAgent(agent);
+  EXPECT_EQ(world->Observe({1})[0].GetValidOtherAgentsWithinRadius(12.0).count(
+                1000),
+            1);
+}
+
+TEST(label_test, dense_traffic) {
+  auto world = MakeGridWorld(100, 4.0);
+  const auto observed_world = world->Observe({1})[0];
+  const auto ego_pos = observed_world.GetEgoAgent()->GetCurrentPosition();
+  int num_in_radius = 0;
+  for (const auto& agent : observed_world.GetValidOtherAgents()) {
+    num_in_radius +=
+        Distance(ego_pos, agent.second->GetCurrentPosition()) < 10.0;
+  }
+  auto dense = LabelFunctionPtr(
+      new DenseTrafficLabelFunction("dense", 10.0, num_in_radius));
+  EXPECT_TRUE(dense->Evaluate(observed_world)[dense->GetLabel()]);
+  auto not_dense = LabelFunctionPtr(
+      new DenseTrafficLabelFunction("dense", 10.0, num_in_radius + 1));
+  EXPECT_FALSE(not_dense->Evaluate(observed_world)[not_dense->GetLabel()]);
+}
+
+TEST(label_test, agent_near_benchmark) {
+  auto evaluator = LabelFunctionPtr(new AgentNearLabelFunction("near", 10.0));
+  const int num_iterations = 20;
+  for (int num_agents : {10, 100, 1000}) {
+    auto world = MakeGridWorld(num_agents, 6.0);
+    const auto observed_world = world->Observe({1})[0];
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_iterations; ++i) {
+      evaluator->Evaluate(observed_world);
+    }
+    const double time = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    std::cout << num_agents << " agents: "
+              << 1e3 * time / num_iterations << " ms per evaluation"
+              << std::endl;
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
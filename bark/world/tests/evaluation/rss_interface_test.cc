@@ -464,5 +464,120 @@ TEST(rss_interface, test_rss_planning_route_german_merge_after) {
   ASSERT_EQ(agent_rss_route.roadSegments.size(), 1) << agent_rss_route.roadSegments;
 }
 
+TEST(rss_interface, test_rss_route_cache) {
+  auto params = std::make_shared<SetterParams>(false);
+  Polygon shape = standard_shapes::CarRectangle();
+  Polygon polygon(
+      Pose(0, 0., 0),
+      std::vector<Point2d>{Point2d(2, -2), Point2d(-2, -2), Point2d(-2, 2),
+                           Point2d(2, 2), Point2d(2, -2)});
+  std::shared_ptr<Polygon> goal_polygon(
+      std::dynamic_pointer_cast<Polygon>(polygon.Translate(Point2d(-15.4, 108.6))));
+  const auto center = goal_polygon->center_;
+  Point2d agent_goal(center[0], center[1]);
+
+  RssInterface rss("bark/runtime/tests/data/DR_DEU_Merging_MT_v01_centered.xodr", params);
+  auto get_route = [&](double x, double y) {
+    State state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+    state << 0, x, y, 3.14, 10;
+    ::ad::map::route::FullRoute route;
+    EXPECT_TRUE(rss.GetRoute(1, Point2d(x, y), agent_goal,
+                             rss.GetMatchObject(1, state, shape), route));
+    return route;
+  };
+
+  // moving along the ongoing lane reuses the route
+  const auto route = get_route(94, 104.2);
+  const auto cached_route = get_route(93, 104.2);
+  EXPECT_EQ(rss.GetStageTimings().num_routes_planned, 1);
+  EXPECT_EQ(rss.GetStageTimings().num_routes_cached, 1);
+  EXPECT_EQ(cached_route, route);
+
+  // changing to the ending lane plans a new route
+  get_route(94, 107.0);
+  EXPECT_EQ(rss.GetStageTimings().num_routes_planned, 2);
+  EXPECT_GT(rss.GetStageTimings().route, 0.);
+
+  rss.ResetStageTimings();
+  EXPECT_EQ(rss.GetStageTimings().num_routes_planned, 0);
+}
+
+TEST(rss_interface, test_rss_relevant_agents) {
+  auto params = std::make_shared<SetterParams>(false);
+  RssInterface rss("bark/runtime/tests/data/city_highway_straight.xodr", params);
+  ::ad::rss::world::RssDynamics dynamics_others;
+  rss.FillRSSDynamics(dynamics_others, params->AddChild("EvaluatorRss::Others"));
+  auto stopping_distance = [&](double speed) {
+    return static_cast<double>(
+        rss.CalculateMaxStoppingDistance(Speed(speed), dynamics_others));
+  };
+
+  for (double speed : {0., 4.2, 13.9, 27.5}) {
+    const auto bounds = rss.GetStoppingDistanceBounds(speed);
+    EXPECT_LE(bounds.first, stopping_distance(speed));
+    EXPECT_GE(bounds.second, stopping_distance(speed));
+  }
+
+  // a column of agents with increasing speed behind the ego agent
+  BehaviorModelPtr beh_model(new BehaviorConstantAcceleration(params));
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  ExecutionModelPtr exec_model(new ExecutionModelInterpolate(params));
+  Polygon shape = standard_shapes::CarRectangle();
+  AgentMap agents;
+  WorldPtr world(new World(params));
+  for (int i = 0; i < 50; ++i) {
+    // every third agent is reversing, every fifth is not valid yet
+    const double speed = (i % 3 == 0 ? -0.7 : 0.7) * i;
+    State state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+    state << 0, -10. * i, 0, 0, speed;
+    objects::AgentPtr agent(
+        new Agent(state, beh_model, dyn_model, exec_model, shape, params));
+    agent->SetAgentId(i);
+    if (i % 5 == 4) agent->SetFirstValidTimestamp(1.);
+    agents[i] = agent;
+    world->AddAgent(agent);
+  }
+  world->UpdateAgentRTree();
+
+  const double ego_stopping_distance = 20.;
+  auto get_relevant_ids = [&](const AgentMap& candidates) {
+    std::vector<AgentPtr> relevant_agents;
+    rss.GetRelevantAgents(candidates, Point2d(0, 0), 0,
+                          ::ad::physics::Distance(ego_stopping_distance),
+                          relevant_agents);
+    std::vector<AgentId> relevant_ids;
+    for (const auto& agent : relevant_agents) {
+      relevant_ids.push_back(agent->GetAgentId());
+    }
+    return relevant_ids;
+  };
+  const std::vector<AgentId> relevant_ids = get_relevant_ids(agents);
+
+  // same result as computing the stopping distance of every agent
+  std::vector<AgentId> expected_ids;
+  for (const auto& agent : agents) {
+    const auto& state = agent.second->GetCurrentState();
+    if (agent.first != 0 &&
+        bark::geometry::Distance(Point2d(0, 0),
+                                 agent.second->GetCurrentPosition()) <
+            ego_stopping_distance +
+                stopping_distance(std::fabs(state(VEL_POSITION)))) {
+      expected_ids.push_back(agent.first);
+    }
+  }
+  EXPECT_EQ(relevant_ids, expected_ids);
+  EXPECT_FALSE(relevant_ids.empty());
+  EXPECT_LT(relevant_ids.size(), agents.size() - 1);
+
+  // the R-tree pre-filter of GenerateRSSWorld keeps the relevant agents
+  EXPECT_DOUBLE_EQ(world->GetMaxAgentSpeed(), 0.7 * 49);
+  const double max_relevant_distance =
+      ego_stopping_distance +
+      rss.GetStoppingDistanceBounds(world->GetMaxAgentSpeed()).second;
+  const AgentMap candidates =
+      world->GetAgentsWithinRadius(Point2d(0, 0), max_relevant_distance, false);
+  EXPECT_LT(candidates.size(), agents.size());
+  EXPECT_EQ(get_relevant_ids(candidates), expected_ids);
+}
 
 #endif
\ No newline at end of file
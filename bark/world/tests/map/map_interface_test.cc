@@ -50,4 +50,29 @@ TEST(point_in_lane, map_interface) {
   bool success = map_interface.FindNearestXodrLanes(point, 1, nearest_lanes);
 
   BARK_EXPECT_TRUE(success);
-}
\ No newline at end of file
+}
+
+TEST(geometry_memory, map_interface) {
+  using bark::geometry::Line;
+  using bark::geometry::MemoryBytes;
+  using bark::world::opendrive::OpenDriveMapPtr;
+  using bark::world::tests::MakeXodrMapCurved;
+
+  OpenDriveMapPtr open_drive_map = MakeXodrMapCurved(2000.0, 0.001);
+  bark::world::map::MapInterface map_interface;
+  map_interface.interface_from_opendrive(open_drive_map);
+
+  std::size_t num_points = 0, bytes_double = 0, bytes_local = 0;
+  for (const auto& road : open_drive_map->GetRoads()) {
+    for (const auto& lane_section : road.second->GetLaneSections()) {
+      for (const auto& lane : lane_section->GetLanes()) {
+        const Line line = lane.second->GetLine();
+        num_points += line.size();
+        bytes_double += MemoryBytes(line);
+        bytes_local += lane.second->GetLocalLine().MemoryBytes();
+      }
+    }
+  }
+  EXPECT_GT(num_points, 0u);
+  EXPECT_LT(bytes_local, bytes_double / 2);
+}
@@ -340,6 +340,29 @@ TEST(curved_plan_view, open_drive) {
   EXPECT_FALSE(boost::geometry::intersects(p->GetReferenceLine().obj_));
 }
 
+TEST(lane_local_line, open_drive) {
+  using namespace bark::world::opendrive;
+  using namespace bark::geometry;
+
+  // a 1 km lane at UTM-like coordinates
+  Line line;
+  for (int i = 0; i <= 1000; ++i) {
+    line.AddPoint(
+        Point2d(691000.0 + i, 5335000.0 + 20.0 * std::sin(i / 50.0)));
+  }
+  XodrLane lane;
+  lane.SetLine(line);
+  const Line restored = lane.GetLine();
+
+  ASSERT_EQ(restored.size(), line.size());
+  for (std::size_t i = 0; i < line.size(); ++i) {
+    EXPECT_NEAR(bg::get<0>(restored.obj_[i]), bg::get<0>(line.obj_[i]), 1e-4);
+    EXPECT_NEAR(bg::get<1>(restored.obj_[i]), bg::get<1>(line.obj_[i]), 1e-4);
+  }
+  EXPECT_NEAR(restored.Length(), line.Length(), 1e-3);
+  EXPECT_LT(lane.GetLocalLine().MemoryBytes(), MemoryBytes(line) / 2);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
@@ -6,6 +6,7 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include "bark/commons/transformation/frenet.hpp"
 #include "bark/world/map/lane.hpp"
 #include "bark/world/map/map_interface.hpp"
 #include "bark/world/map/road.hpp"
@@ -85,3 +86,38 @@ TEST(road_corridor_tests, xodr_map_ending_lane_in_parallel) {
 
   EXPECT_EQ(road_corridor->GetRoads().size(), 1);
 }
+
+TEST(road_corridor_tests, center_line_projector) {
+  using bark::commons::transformation::FrenetPosition;
+  using bark::commons::transformation::FrenetProjection;
+  using bark::geometry::Line;
+  using bark::geometry::Point2d;
+  using bark::world::map::LaneCorridor;
+
+  Line center_line;
+  center_line.AddPoint(Point2d(0.0, 0.0));
+  center_line.AddPoint(Point2d(10.0, 0.0));
+  center_line.AddPoint(Point2d(20.0, 5.0));
+  LaneCorridor lane_corridor;
+  lane_corridor.SetCenterLine(center_line);
+
+  // built once and reused, also by copies of the corridor
+  const auto projector = lane_corridor.GetCenterLineProjector();
+  EXPECT_EQ(lane_corridor.GetCenterLineProjector(), projector);
+  const LaneCorridor copy = lane_corridor;
+  EXPECT_EQ(copy.GetCenterLineProjector(), projector);
+
+  const Point2d point(12.0, 3.0);
+  const FrenetProjection projection = projector->Project({point});
+  const FrenetPosition expected(point, lane_corridor.GetCenterLine());
+  EXPECT_NEAR(projection.lon[0], expected.lon, 1e-9);
+  EXPECT_NEAR(projection.lat[0], expected.lat, 1e-9);
+
+  // rebuilt after the center line changed
+  lane_corridor.GetCenterLine().AddPoint(Point2d(30.0, 5.0));
+  const auto rebuilt = lane_corridor.GetCenterLineProjector();
+  EXPECT_NE(rebuilt, projector);
+  const Point2d point_end(28.0, 7.0);
+  const FrenetPosition expected_end(point_end, lane_corridor.GetCenterLine());
+  EXPECT_NEAR(rebuilt->Project({point_end}).lat[0], expected_end.lat, 1e-9);
+}
@@ -12,6 +12,11 @@
 #include "bark/geometry/standard_shapes.hpp"
 #include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
 #include "bark/models/behavior/motion_primitives/continuous_actions.hpp"
+#include "bark/models/behavior/motion_primitives/macro_actions.hpp"
+#include "bark/models/behavior/motion_primitives/primitives/primitive_const_acc_change_to_left.hpp"
+#include "bark/models/behavior/motion_primitives/primitives/primitive_const_acc_change_to_right.hpp"
+#include "bark/models/behavior/motion_primitives/primitives/primitive_const_acc_stay_lane.hpp"
+#include "bark/models/behavior/motion_primitives/primitives/primitive_gap_keeping.hpp"
 #include "bark/models/dynamic/single_track.hpp"
 #include "bark/models/execution/interpolation/interpolate.hpp"
 #include "bark/world/evaluation/evaluator_collision_agents.hpp"
@@ -344,3 +349,267 @@ TEST(observed_world, predict) {
   // + prediction time span
   EXPECT_NEAR(ego_pred_velocity, ego_velocity + 2 * 1.0, 0.05);
 }
+
+TEST(observed_world, neighbor_table) {
+  auto params = std::make_shared<SetterParams>();
+
+  // Setting Up Map
+  OpenDriveMapPtr open_drive_map = MakeXodrMapOneRoadTwoLanes();
+  MapInterfacePtr map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(open_drive_map);
+
+  // Goal Definition
+  Polygon polygon = GenerateGoalRectangle(6, 3);
+  std::shared_ptr<Polygon> goal_polygon(
+      std::dynamic_pointer_cast<Polygon>(polygon.Translate(Point2d(50, -2))));
+  auto goal_ptr = std::make_shared<GoalDefinitionPolygon>(*goal_polygon);
+
+  // Setting Up Agents (two in the left lane, one in the right lane)
+  ExecutionModelPtr exec_model(new ExecutionModelInterpolate(params));
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  BehaviorModelPtr beh_model(new BehaviorConstantAcceleration(params));
+  Polygon car_polygon = CarRectangle();
+
+  State init_state1(static_cast<int>(MIN_STATE_SIZE));
+  init_state1 << 0.0, 3.0, -1.75, 0.0, 5.0;
+  AgentPtr agent1(new Agent(init_state1, beh_model, dyn_model, exec_model,
+                            car_polygon, params, goal_ptr, map_interface,
+                            Model3D()));  // NOLINT
+
+  State init_state2(static_cast<int>(MIN_STATE_SIZE));
+  init_state2 << 0.0, 10.0, -1.75, 0.0, 7.0;
+  AgentPtr agent2(new Agent(init_state2, beh_model, dyn_model, exec_model,
+                            car_polygon, params, goal_ptr, map_interface,
+                            Model3D()));  // NOLINT
+
+  State init_state3(static_cast<int>(MIN_STATE_SIZE));
+  init_state3 << 0.0, 5.0, -5.25, 0.0, 5.0;
+  AgentPtr agent3(new Agent(init_state3, beh_model, dyn_model, exec_model,
+                            car_polygon, params, goal_ptr, map_interface,
+                            Model3D()));  // NOLINT
+
+  WorldPtr world(new World(params));
+  world->AddAgent(agent1);
+  world->AddAgent(agent2);
+  world->AddAgent(agent3);
+  world->UpdateAgentRTree();
+
+  WorldPtr current_world_state(world->Clone());
+  EXPECT_NE(current_world_state->GetNeighborTable(), world->GetNeighborTable());
+  ObservedWorld obs_world1(current_world_state, agent1->GetAgentId());
+  ObservedWorld obs_world2(current_world_state, agent2->GetAgentId());
+  ObservedWorld obs_world3(current_world_state, agent3->GetAgentId());
+  EXPECT_EQ(obs_world1.GetNeighborTable(), obs_world3.GetNeighborTable());
+  const auto neighbor_table = current_world_state->GetNeighborTable();
+
+  // the first query of a lane corridor computes its occupancy
+  auto fr_agents1 = obs_world1.GetAgentFrontRear();
+  EXPECT_EQ(neighbor_table->GetNumCorridorMisses(), 1u);
+  EXPECT_EQ(neighbor_table->GetNumCorridorHits(), 0u);
+  EXPECT_EQ(fr_agents1.front.first->GetAgentId(), agent2->GetAgentId());
+  EXPECT_FALSE(static_cast<bool>(fr_agents1.rear.first));
+
+  // other agents on the same corridor reuse it
+  auto fr_agents2 = obs_world2.GetAgentFrontRear();
+  EXPECT_EQ(neighbor_table->GetNumCorridorMisses(), 1u);
+  EXPECT_EQ(neighbor_table->GetNumCorridorHits(), 1u);
+  EXPECT_FALSE(static_cast<bool>(fr_agents2.front.first));
+  EXPECT_EQ(fr_agents2.rear.first->GetAgentId(), agent1->GetAgentId());
+  EXPECT_NEAR(fr_agents2.rear.second.lon, -7.0, 1e-6);
+
+  // as well as agents evaluating a lane change to it
+  const auto lane_corridor1 = obs_world1.GetLaneCorridor();
+  auto neighbor_info3 = obs_world3.GetNeighborInformation(
+      agent3->GetAgentId(), lane_corridor1, obs_world3.GetFracLateralOffset());
+  EXPECT_EQ(neighbor_table->GetNumCorridorMisses(), 1u);
+  EXPECT_EQ(neighbor_table->GetNumCorridorHits(), 2u);
+  EXPECT_EQ(neighbor_info3.front_rear.front.first->GetAgentId(),
+            agent2->GetAgentId());
+  EXPECT_EQ(neighbor_info3.front_rear.rear.first->GetAgentId(),
+            agent1->GetAgentId());
+  EXPECT_NEAR(neighbor_info3.rel_velocity_front, 2.0, 1e-6);
+  EXPECT_NEAR(neighbor_info3.rel_velocity_rear, 0.0, 1e-6);
+
+  // repeated queries of an agent are served from the table
+  const std::size_t num_hits = neighbor_table->GetNumHits();
+  const std::size_t table_size = neighbor_table->GetSize();
+  EXPECT_EQ(table_size, 3u);
+  obs_world1.GetAgentFrontRear();
+  EXPECT_EQ(neighbor_table->GetNumHits(), num_hits + 1);
+  EXPECT_EQ(neighbor_table->GetSize(), table_size);
+
+  // all observed worlds of a world snapshot share the table
+  auto observed_worlds = world->Observe(
+      {agent1->GetAgentId(), agent2->GetAgentId(), agent3->GetAgentId()});
+  const auto shared_table = observed_worlds.at(0).GetNeighborTable();
+  EXPECT_EQ(observed_worlds.at(1).GetNeighborTable(), shared_table);
+  EXPECT_EQ(observed_worlds.at(2).GetNeighborTable(), shared_table);
+  observed_worlds.at(0).GetAgentFrontRear();
+  observed_worlds.at(1).GetAgentFrontRear();
+  EXPECT_EQ(shared_table->GetNumCorridorMisses(), 1u);
+  EXPECT_EQ(shared_table->GetNumCorridorHits(), 1u);
+
+  // state updates invalidate the table
+  current_world_state->UpdateAgentRTree();
+  EXPECT_EQ(neighbor_table->GetSize(), 0u);
+}
+
+TEST(observed_world, expand_all) {
+  using bark::models::behavior::BehaviorMotionPrimitives;
+  using bark::models::behavior::BehaviorMPContinuousActions;
+  using bark::models::behavior::DiscreteAction;
+  using bark::models::dynamic::Input;
+  using bark::world::prediction::PredictionSettings;
+  using bark::world::tests::make_test_observed_world;
+  using StateDefinition::VEL_POSITION;
+
+  auto params = std::make_shared<SetterParams>();
+  params->SetReal("integration_time_delta", 0.01);
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  double ego_velocity = 5.0, rel_distance = 7.0, velocity_difference = 0.0;
+  auto observed_world = make_test_observed_world(1, rel_distance, ego_velocity,
+                                                 velocity_difference);
+  for (const auto& agent : observed_world.GetAgents()) {
+    agent.second->SetDynamicModel(dyn_model);
+  }
+
+  auto ego_prediction_model =
+      std::make_shared<BehaviorMPContinuousActions>(params);
+  for (double acc : {-2.0, 0.0, 2.0}) {
+    Input u(2);
+    u << acc, 0;
+    ego_prediction_model->AddMotionPrimitive(u);
+  }
+  BehaviorModelPtr others_prediction_model(
+      new BehaviorConstantAcceleration(params));
+  PredictionSettings prediction_settings(ego_prediction_model,
+                                         others_prediction_model);
+  observed_world.SetupPrediction(prediction_settings);
+
+  std::vector<DiscreteAction> actions{0, 1, 2};
+  auto next_worlds = observed_world.ExpandAll(1.0, actions);
+  auto next_worlds_parallel = observed_world.ExpandAll(1.0, actions, 2);
+  ASSERT_EQ(next_worlds.size(), actions.size());
+  ASSERT_EQ(next_worlds_parallel.size(), actions.size());
+
+  // expansions match separate predictions
+  for (std::size_t idx = 0; idx < actions.size(); ++idx) {
+    auto predicted_world = observed_world.Predict(1.0, actions.at(idx));
+    EXPECT_NEAR(next_worlds.at(idx)->GetWorldTime(),
+                predicted_world->GetWorldTime(), 1e-6);
+    for (const auto& agent : predicted_world->GetAgents()) {
+      const State expected_state = agent.second->GetCurrentState();
+      const State state =
+          next_worlds.at(idx)->GetAgent(agent.first)->GetCurrentState();
+      const State state_parallel = next_worlds_parallel.at(idx)
+                                       ->GetAgent(agent.first)
+                                       ->GetCurrentState();
+      EXPECT_TRUE(expected_state.isApprox(state, 1e-6));
+      EXPECT_TRUE(expected_state.isApprox(state_parallel, 1e-6));
+    }
+  }
+  EXPECT_NEAR(next_worlds.at(2)->CurrentEgoState()[VEL_POSITION],
+              ego_velocity + 2.0, 0.05);
+
+  // expansion over all valid actions of the behavior model
+  auto ego_behavior = std::dynamic_pointer_cast<BehaviorMotionPrimitives>(
+      observed_world.GetEgoBehaviorModel());
+  auto observed_world_ptr = std::make_shared<ObservedWorld>(observed_world);
+  auto expansion = ego_behavior->ExpandAll(observed_world_ptr, 1.0, 3);
+  ASSERT_EQ(expansion.size(), 3u);
+  for (std::size_t idx = 0; idx < expansion.size(); ++idx) {
+    EXPECT_EQ(expansion.at(idx).first, actions.at(idx));
+    EXPECT_NEAR(expansion.at(idx).second->CurrentEgoState()[VEL_POSITION],
+                next_worlds.at(idx)->CurrentEgoState()[VEL_POSITION], 1e-6);
+  }
+}
+
+TEST(observed_world, expand_all_macro_actions) {
+  using bark::models::behavior::BehaviorMotionPrimitives;
+  using bark::models::behavior::BehaviorMPMacroActions;
+  using bark::models::behavior::primitives::PrimitiveConstAccChangeToLeft;
+  using bark::models::behavior::primitives::PrimitiveConstAccChangeToRight;
+  using bark::models::behavior::primitives::PrimitiveConstAccStayLane;
+  using bark::models::behavior::primitives::PrimitiveGapKeeping;
+  using bark::world::prediction::PredictionSettings;
+  using bark::world::tests::make_test_observed_world;
+
+  auto params = std::make_shared<SetterParams>();
+  params->SetReal("integration_time_delta", 0.01);
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  double ego_velocity = 5.0, rel_distance = 7.0, velocity_difference = 2.0;
+  auto observed_world = make_test_observed_world(1, rel_distance, ego_velocity,
+                                                 velocity_difference);
+  for (const auto& agent : observed_world.GetAgents()) {
+    agent.second->SetDynamicModel(dyn_model);
+  }
+
+  auto ego_prediction_model = std::make_shared<BehaviorMPMacroActions>(params);
+  for (double acc : {-2.0, 0.0, 2.0}) {
+    ego_prediction_model->AddMotionPrimitive(
+        std::make_shared<PrimitiveConstAccStayLane>(params, acc));
+  }
+  ego_prediction_model->AddMotionPrimitive(
+      std::make_shared<PrimitiveConstAccChangeToLeft>(params));
+  ego_prediction_model->AddMotionPrimitive(
+      std::make_shared<PrimitiveConstAccChangeToRight>(params));
+  ego_prediction_model->AddMotionPrimitive(
+      std::make_shared<PrimitiveGapKeeping>(params));
+  EXPECT_TRUE(ego_prediction_model->HasIndependentClones());
+  BehaviorModelPtr others_prediction_model(
+      new BehaviorConstantAcceleration(params));
+  PredictionSettings prediction_settings(ego_prediction_model,
+                                         others_prediction_model);
+  observed_world.SetupPrediction(prediction_settings);
+
+  auto ego_behavior = std::dynamic_pointer_cast<BehaviorMPMacroActions>(
+      observed_world.GetEgoBehaviorModel());
+  auto observed_world_ptr = std::make_shared<ObservedWorld>(observed_world);
+  auto expansion = ego_behavior->ExpandAll(observed_world_ptr, 1.0, 1);
+  ASSERT_GT(expansion.size(), 1u);
+
+  // preconditions are evaluated although they are not checked in Plan,
+  // actions are primitive indices then
+  const auto valid_actions = ego_behavior->GetValidActions(observed_world_ptr);
+  ASSERT_EQ(expansion.size(), valid_actions.size());
+  EXPECT_LT(valid_actions.size(), ego_behavior->GetMotionPrimitives().size());
+  for (std::size_t idx = 0; idx < expansion.size(); ++idx) {
+    EXPECT_EQ(expansion.at(idx).first, valid_actions.at(idx));
+  }
+
+  // parallel expansions plan on copies of the primitives and match the
+  // serial expansion
+  for (int run = 0; run < 10; ++run) {
+    auto expansion_parallel =
+        ego_behavior->ExpandAll(observed_world_ptr, 1.0, 4);
+    ASSERT_EQ(expansion_parallel.size(), expansion.size());
+    for (std::size_t idx = 0; idx < expansion.size(); ++idx) {
+      EXPECT_EQ(expansion_parallel.at(idx).first, expansion.at(idx).first);
+      for (const auto& agent : expansion.at(idx).second->GetAgents()) {
+        const State state = agent.second->GetCurrentState();
+        const State state_parallel = expansion_parallel.at(idx)
+                                         .second->GetAgent(agent.first)
+                                         ->GetCurrentState();
+        EXPECT_TRUE(state.isApprox(state_parallel, 1e-9));
+      }
+    }
+  }
+
+  // clones share the primitives, only independent clones copy them
+  auto cloned_behavior =
+      std::dynamic_pointer_cast<BehaviorMPMacroActions>(ego_behavior->Clone());
+  auto independent_behavior = std::dynamic_pointer_cast<BehaviorMPMacroActions>(
+      ego_behavior->CloneIndependent());
+  const auto& primitives = ego_behavior->GetMotionPrimitives();
+  const auto& cloned_primitives = cloned_behavior->GetMotionPrimitives();
+  const auto& independent_primitives =
+      independent_behavior->GetMotionPrimitives();
+  ASSERT_EQ(cloned_primitives.size(), primitives.size());
+  ASSERT_EQ(independent_primitives.size(), primitives.size());
+  for (std::size_t idx = 0; idx < primitives.size(); ++idx) {
+    EXPECT_EQ(cloned_primitives.at(idx), primitives.at(idx));
+    EXPECT_NE(independent_primitives.at(idx), primitives.at(idx));
+    EXPECT_EQ(independent_primitives.at(idx)->GetName(),
+              primitives.at(idx)->GetName());
+  }
+}
@@ -15,7 +15,7 @@ from bark.runtime.commons import XodrParser
 from bark.core.models.behavior import BehaviorConstantAcceleration, BehaviorIDMLaneTracking, BehaviorMobilRuleBased
 from bark.core.models.execution import ExecutionModelInterpolate
 from bark.core.models.dynamic import SingleTrackModel
-from bark.core.world import World, MakeTestWorldHighway
+from bark.core.world import World, MakeTestWorldHighway, DeserializeWorld
 from bark.core.world.goal_definition import GoalDefinitionPolygon
 from bark.core.world.agent import Agent
 from bark.core.world.map import MapInterface, Roadgraph
@@ -75,6 +75,33 @@ class WorldTests(unittest.TestCase):
     def test_highway(self):
         world = MakeTestWorldHighway()
 
+    def test_state_array(self):
+        world = MakeTestWorldHighway()
+        world.Step(0.2)
+        states = world.GetStateArray()
+        self.assertEqual(states.shape, (len(world.agents), 5))
+        for row, agent_id in enumerate(sorted(world.agents.keys())):
+            agent = world.agents[agent_id]
+            np.testing.assert_array_almost_equal(states[row], agent.state)
+            self.assertEqual(agent.GetHistoryStateArray().shape[0],
+                             len(agent.history))
+
+    def test_serialization(self):
+        world = MakeTestWorldHighway()
+        map_interface = MapInterface()
+        map_interface.SetOpenDriveMap(MakeXodrMapOneRoadTwoLanes())
+        world.map = map_interface
+        world.Step(0.2)
+
+        data = world.Serialize()
+        self.assertIsInstance(data, bytes)
+        restored = DeserializeWorld(data, map_interface)
+        self.assertAlmostEqual(restored.time, world.time)
+        for agent_id, agent in world.agents.items():
+            np.testing.assert_array_almost_equal(
+                restored.agents[agent_id].state, agent.state)
+        self.assertEqual(restored.Serialize(), data)
+
     def test_evaluator_drivable_area(self):
         # World Definition
         params = ParameterServer()
@@ -0,0 +1,54 @@
+# Copyright (c) 2020 fortiss GmbH
+#
+# Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+# Tobias Kessler
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+import unittest
+import time
+import numpy as np
+from concurrent.futures import ThreadPoolExecutor
+from bark.core.world import MakeTestWorldHighway
+
+
+def step_world(world, num_steps):
+    for _ in range(num_steps):
+        world.Step(0.2)
+    return world.GetStateArray()
+
+
+class WorldThreadingTests(unittest.TestCase):
+    """Steps independent worlds from multiple Python threads; World.Step
+          releases the GIL, so the threads run in parallel.
+    """
+
+    def test_threaded_step(self):
+        num_worlds = 8
+        num_steps = 100
+        worlds = [MakeTestWorldHighway() for _ in range(num_worlds)]
+        expected = step_world(MakeTestWorldHighway(), num_steps)
+
+        start = time.time()
+        sequential_states = [step_world(w.Copy(), num_steps) for w in worlds]
+        sequential_time = time.time() - start
+
+        for num_threads in [2, 4, 8]:
+            with ThreadPoolExecutor(max_workers=num_threads) as executor:
+                start = time.time()
+                threaded_states = list(executor.map(
+                    lambda w: step_world(w.Copy(), num_steps), worlds))
+                threaded_time = time.time() - start
+            print("{} threads: {:.3f}s, sequential: {:.3f}s, speedup: {:.2f}".format(
+                num_threads, threaded_time, sequential_time,
+                sequential_time / threaded_time))
+            for states in threaded_states:
+                np.testing.assert_array_almost_equal(states, expected)
+
+        for states in sequential_states:
+            np.testing.assert_array_almost_equal(states, expected)
+
+
+if __name__ == '__main__':
+    unittest.main()
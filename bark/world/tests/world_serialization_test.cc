@@ -0,0 +1,166 @@
+// Copyright (c) 2020 fortiss GmbH
+//
+// Authors: Julian Bernhard, Klemens Esterle, Patrick Hart and
+// Tobias Kessler
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <chrono>
+#include <iostream>
+
+#include "bark/world/serialization/world_serialization.hpp"
+#include "bark/commons/params/setter_params.hpp"
+#include "bark/models/behavior/idm/idm_classic.hpp"
+#include "bark/world/evaluation/evaluator_collision_agents.hpp"
+#include "bark/world/evaluation/evaluator_goal_reached.hpp"
+#include "bark/world/evaluation/evaluator_step_count.hpp"
+#include "bark/world/map/map_interface.hpp"
+#include "bark/world/tests/make_test_world.hpp"
+#include "bark/world/tests/make_test_xodr_map.hpp"
+#include "gtest/gtest.h"
+
+using bark::commons::SetterParams;
+using bark::models::behavior::BehaviorIDMClassic;
+using bark::world::WorldPtr;
+using bark::world::evaluation::EvaluatorCollisionAgents;
+using bark::world::evaluation::EvaluatorGoalReached;
+using bark::world::evaluation::EvaluatorStepCount;
+using bark::world::map::MapInterface;
+using bark::world::map::MapInterfacePtr;
+using bark::world::serialization::ComputeMapHash;
+using bark::world::serialization::DeserializeWorld;
+using bark::world::serialization::SerializeWorld;
+using bark::world::tests::MakeTestWorldHighway;
+using bark::world::tests::MakeXodrMapOneRoadTwoLanes;
+using bark::world::tests::MakeXodrMapTwoRoadsOneLane;
+
+MapInterfacePtr MakeMapInterface() {
+  auto map_interface = std::make_shared<MapInterface>();
+  map_interface->interface_from_opendrive(MakeXodrMapOneRoadTwoLanes());
+  return map_interface;
+}
+
+WorldPtr MakeSteppedWorld() {
+  WorldPtr world = MakeTestWorldHighway();
+  world->SetMap(MakeMapInterface());
+  world->AddEvaluator("collision",
+                      std::make_shared<EvaluatorCollisionAgents>());
+  world->AddEvaluator("goal_reached", std::make_shared<EvaluatorGoalReached>(1));
+  world->AddEvaluator("step_count", std::make_shared<EvaluatorStepCount>());
+  for (int i = 0; i < 3; ++i) {
+    world->Step(0.2);
+    world->Evaluate();
+  }
+  return world;
+}
+
+TEST(world_serialization, round_trip) {
+  WorldPtr world = MakeSteppedWorld();
+  const std::string data = SerializeWorld(*world);
+
+  // the map is only referenced, a map with the same content is accepted
+  WorldPtr restored = DeserializeWorld(data, MakeMapInterface());
+  EXPECT_EQ(SerializeWorld(*restored), data);
+  EXPECT_DOUBLE_EQ(restored->GetWorldTime(), world->GetWorldTime());
+  ASSERT_EQ(restored->GetAgents().size(), world->GetAgents().size());
+  for (const auto& agent : world->GetAgents()) {
+    const auto restored_agent = restored->GetAgent(agent.first);
+    ASSERT_TRUE(bool(restored_agent));
+    EXPECT_EQ(restored_agent->GetStateInputHistory().size(),
+              agent.second->GetStateInputHistory().size());
+    EXPECT_TRUE(restored_agent->GetCurrentState().isApprox(
+        agent.second->GetCurrentState()));
+    EXPECT_TRUE(restored_agent->GetBehaviorTrajectory().isApprox(
+        agent.second->GetBehaviorTrajectory()));
+    EXPECT_TRUE(bool(restored_agent->GetRoadCorridor()));
+  }
+  ASSERT_EQ(restored->GetEvaluators().size(), 3);
+  EXPECT_EQ(boost::get<int>(restored->Evaluate()["step_count"]), 4);
+
+  // both worlds continue identically
+  world->Step(0.2);
+  restored->Step(0.2);
+  for (const auto& agent : world->GetAgents()) {
+    EXPECT_TRUE(restored->GetAgent(agent.first)->GetCurrentState().isApprox(
+        agent.second->GetCurrentState()));
+  }
+}
+
+TEST(world_serialization, idm_lane_corridors) {
+  WorldPtr world = MakeTestWorldHighway();
+  world->SetMap(MakeMapInterface());
+  auto params = std::make_shared<SetterParams>();
+  for (const auto& agent : world->GetAgents()) {
+    auto behavior_model = std::make_shared<BehaviorIDMClassic>(params);
+    // keeps the agents on the other lane than they start on
+    behavior_model->SetConstantLaneCorridor(
+        agent.second->GetRoadCorridor()->GetUniqueLaneCorridors().back());
+    agent.second->SetBehaviorModel(behavior_model);
+  }
+  world->Step(0.2);
+  const std::string data = SerializeWorld(*world);
+
+  WorldPtr restored = DeserializeWorld(data, MakeMapInterface());
+  EXPECT_EQ(SerializeWorld(*restored), data);
+  for (const auto& agent : restored->GetAgents()) {
+    const auto behavior_model = std::dynamic_pointer_cast<BehaviorIDMClassic>(
+        agent.second->GetBehaviorModel());
+    ASSERT_TRUE(bool(behavior_model));
+    EXPECT_EQ(behavior_model->GetConstantLaneCorridor(),
+              agent.second->GetRoadCorridor()->GetUniqueLaneCorridors().back());
+    EXPECT_TRUE(bool(behavior_model->GetLaneCorridor()));
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    world->Step(0.2);
+    restored->Step(0.2);
+  }
+  for (const auto& agent : world->GetAgents()) {
+    EXPECT_TRUE(restored->GetAgent(agent.first)->GetCurrentState().isApprox(
+        agent.second->GetCurrentState()));
+  }
+}
+
+TEST(world_serialization, invalid_data) {
+  WorldPtr world = MakeSteppedWorld();
+  const std::string data = SerializeWorld(*world);
+
+  auto other_map = std::make_shared<MapInterface>();
+  other_map->interface_from_opendrive(MakeXodrMapTwoRoadsOneLane());
+  EXPECT_NE(ComputeMapHash(other_map), ComputeMapHash(world->GetMap()));
+  EXPECT_THROW(DeserializeWorld(data, other_map), std::runtime_error);
+
+  EXPECT_THROW(DeserializeWorld(data.substr(0, data.size() / 2),
+                                MakeMapInterface()),
+               std::runtime_error);
+  EXPECT_THROW(DeserializeWorld("no world", MakeMapInterface()),
+               std::runtime_error);
+}
+
+TEST(world_serialization, benchmark) {
+  WorldPtr world = MakeSteppedWorld();
+  const MapInterfacePtr map_interface = world->GetMap();
+  const int num_iterations = 200;
+
+  std::string data;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_iterations; ++i) {
+    data = SerializeWorld(*world);
+  }
+  const double serialize_time = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_iterations; ++i) {
+    world = DeserializeWorld(data, map_interface);
+  }
+  const double deserialize_time = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  std::cout << "World with " << world->GetAgents().size() << " agents, "
+            << data.size() << " bytes: serialize "
+            << num_iterations / serialize_time << " worlds/s, deserialize "
+            << num_iterations / deserialize_time << " worlds/s" << std::endl;
+  EXPECT_EQ(world->GetAgents().size(), 4);
+}
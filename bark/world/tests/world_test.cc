@@ -6,10 +6,15 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
 #include "bark/world/world.hpp"
 #include "bark/commons/params/setter_params.hpp"
 #include "bark/geometry/polygon.hpp"
 #include "bark/models/behavior/constant_acceleration/constant_acceleration.hpp"
+#include "bark/models/behavior/idm/idm_classic.hpp"
 #include "bark/models/dynamic/single_track.hpp"
 #include "bark/models/execution/interpolation/interpolate.hpp"
 #include "bark/world/evaluation/evaluator_collision_agents.hpp"
@@ -44,6 +49,18 @@ using namespace bark::world::goal_definition;
 using bark::world::tests::make_test_world;
 using bark::geometry::standard_shapes::GenerateGoalRectangle;
 
+// counts the heap allocations of this test binary
+std::atomic<std::size_t> num_allocations(0);
+void* operator new(std::size_t size) {
+  num_allocations++;
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
 TEST(world, world_init) {
   auto params = std::make_shared<SetterParams>();
   ExecutionModelPtr exec_model(new ExecutionModelInterpolate(params));
@@ -327,6 +344,43 @@ TEST(world, nearest_agents) {
   */
 }
 
+TEST(world, agents_within_radius) {
+  auto params = std::make_shared<SetterParams>();
+  ExecutionModelPtr exec_model(new ExecutionModelInterpolate(params));
+  DynamicModelPtr dyn_model(new SingleTrackModel(params));
+  BehaviorModelPtr beh_model(new BehaviorConstantAcceleration(params));
+  Polygon polygon = standard_shapes::CarRectangle();
+
+  WorldPtr world(new World(params));
+  std::vector<AgentPtr> agents;
+  for (int i = 0; i < 4; ++i) {
+    State init_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+    init_state << 0.0, 10.0 * i, 0.0, 0.0, -3.0 * i;
+    AgentPtr agent(new Agent(init_state, beh_model, dyn_model, exec_model,
+                             polygon, params));
+    world->AddAgent(agent);
+    agents.push_back(agent);
+  }
+  // not valid before the world time reaches one second
+  agents[1]->SetFirstValidTimestamp(1.0);
+  world->UpdateAgentRTree();
+
+  EXPECT_EQ(world->GetAgentsWithinRadius(Point2d(0.0, 0.0), 15.0).size(), 1);
+  const AgentMap all_agents =
+      world->GetAgentsWithinRadius(Point2d(0.0, 0.0), 15.0, false);
+  EXPECT_EQ(all_agents.size(), 2);
+  EXPECT_EQ(all_agents.count(agents[1]->GetAgentId()), 1);
+  EXPECT_DOUBLE_EQ(world->GetMaxAgentSpeed(), 9.0);
+
+  // not yet in the tree
+  State init_state(static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  init_state << 0.0, 5.0, 0.0, 0.0, 12.0;
+  world->AddAgent(AgentPtr(new Agent(init_state, beh_model, dyn_model,
+                                     exec_model, polygon, params)));
+  EXPECT_DOUBLE_EQ(world->GetMaxAgentSpeed(), 12.0);
+  EXPECT_EQ(world->GetAgentsWithinRadius(Point2d(0.0, 0.0), 15.0).size(), 2);
+}
+
 TEST(world, distance_to_goal) {
   auto params = std::make_shared<SetterParams>();
   ExecutionModelPtr exec_model(new ExecutionModelInterpolate(params));
@@ -440,3 +494,107 @@ TEST(world, agents_intersection_polygon) {
   EXPECT_EQ(agents_intersect3[agent3->GetAgentId()]->GetCurrentState(),
             init_state3);
 }
+
+TEST(world, state_array) {
+  using bark::world::tests::MakeTestWorldHighway;
+  WorldPtr world = MakeTestWorldHighway();
+  world->Step(0.2);
+  world->Step(0.2);
+
+  const Eigen::MatrixXd states = world->GetStateArray();
+  ASSERT_EQ(states.rows(), world->GetAgents().size());
+  ASSERT_EQ(states.cols(), static_cast<int>(StateDefinition::MIN_STATE_SIZE));
+  int row = 0;
+  for (const auto& agent : world->GetAgents()) {
+    EXPECT_TRUE(states.row(row++).transpose().isApprox(
+        agent.second->GetCurrentState()));
+  }
+
+  const AgentPtr agent = world->GetAgents().begin()->second;
+  const Trajectory history_states = agent->GetHistoryStateArray();
+  ASSERT_EQ(history_states.rows(), agent->GetStateInputHistory().size());
+  EXPECT_TRUE(history_states.row(history_states.rows() - 1)
+                  .transpose()
+                  .isApprox(agent->GetCurrentState()));
+}
+
+TEST(world, frenet_cache) {
+  using bark::commons::transformation::FrenetCache;
+  using bark::commons::transformation::FrenetState;
+  using bark::world::tests::MakeTestWorldHighway;
+  WorldPtr world = MakeTestWorldHighway();
+  auto params = std::make_shared<SetterParams>();
+  for (const auto& agent : world->GetAgents()) {
+    agent.second->SetBehaviorModel(
+        std::make_shared<BehaviorIDMClassic>(params));
+  }
+
+  FrenetCache::ResetStatistics();
+  for (int i = 0; i < 10; ++i) {
+    world->Step(0.2);
+  }
+  const auto statistics = FrenetCache::GetStatistics();
+  std::cout << "Frenet projections: " << statistics.projections
+            << ", reused: " << statistics.reused << std::endl;
+  EXPECT_GT(statistics.reused, 0u);
+
+  // cached states equal a new projection and are dropped on state changes
+  const AgentPtr agent = world->GetAgents().begin()->second;
+  const auto lane_corridor =
+      agent->GetRoadCorridor()->GetCurrentLaneCorridor(
+          agent->GetCurrentPosition());
+  ASSERT_TRUE(lane_corridor);
+  const Line& center_line = lane_corridor->GetCenterLine();
+  const FrenetState expected(agent->GetCurrentState(), center_line);
+  const FrenetState cached = agent->CurrentFrenetState(center_line);
+  EXPECT_EQ(cached.lon, expected.lon);
+  EXPECT_EQ(cached.lat, expected.lat);
+  EXPECT_EQ(cached.angle, expected.angle);
+
+  State moved = agent->GetCurrentState();
+  moved(StateDefinition::X_POSITION) += 1.0;
+  agent->SetCurrentState(moved);
+  const FrenetState expected_moved(moved, center_line);
+  EXPECT_EQ(agent->CurrentFrenetState(center_line).lon, expected_moved.lon);
+  EXPECT_NE(agent->CurrentFrenetState(center_line).lon, expected.lon);
+}
+
+TEST(world, polygon_allocations_benchmark) {
+  using bark::world::tests::MakeTestWorldHighway;
+  WorldPtr world = MakeTestWorldHighway();
+  auto params = std::make_shared<SetterParams>();
+  for (const auto& agent : world->GetAgents()) {
+    agent.second->SetBehaviorModel(
+        std::make_shared<BehaviorIDMClassic>(params));
+  }
+  world->AddEvaluator("collision_agents",
+                      std::make_shared<EvaluatorCollisionAgents>());
+  world->AddEvaluator("drivable_area",
+                      std::make_shared<EvaluatorDrivableArea>());
+  world->Step(0.2);
+
+  const int num_steps = 10;
+  std::size_t start = num_allocations;
+  for (int i = 0; i < num_steps; ++i) {
+    world->Step(0.2);
+    world->Evaluate();
+  }
+  std::cout << "Allocations per step of " << world->GetAgents().size()
+            << " agents: " << (num_allocations - start) / num_steps
+            << std::endl;
+
+  const AgentPtr agent = world->GetAgents().begin()->second;
+  const State state = agent->GetCurrentState();
+  start = num_allocations;
+  const Polygon polygon = agent->GetPolygonFromState(state);
+  std::cout << "Allocations of GetPolygonFromState: "
+            << num_allocations - start << std::endl;
+
+  // a reused buffer does not allocate
+  Polygon scratch;
+  agent->GetPolygonFromState(state, &scratch);
+  start = num_allocations;
+  agent->GetPolygonFromState(state, &scratch);
+  EXPECT_EQ(num_allocations - start, 0u);
+  EXPECT_TRUE(Equals(scratch, polygon));
+}
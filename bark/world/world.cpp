@@ -6,10 +6,18 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <algorithm>
+#include <cmath>
 #include <csignal>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "bark/commons/transformation/frenet_projection.hpp"
 #include "bark/commons/util/segfault_handler.hpp"
+#include "bark/models/behavior/batch_policy.hpp"
 #include "bark/world/observed_world.hpp"
 #include "bark/world/world.hpp"
 #include "bark/models/observer/observer_model.hpp"
@@ -18,6 +26,8 @@
 namespace bark {
 namespace world {
 
+using models::behavior::BatchPolicyBehavior;
+using models::behavior::BatchPolicyPtr;
 using models::behavior::BehaviorStatus;
 using models::execution::ExecutionStatus;
 using bark::models::observer::ObserverModelNone;
@@ -26,8 +36,9 @@ World::World(const commons::ParamsPtr& params)
     : commons::BaseType(params),
       map_(),
       agents_(),
-      world_time_(0.0),
       observer_(new ObserverModelNone(params)),
+      world_time_(0.0),
+      max_agent_speed_(0.0),
       remove_agents_(params->GetBool(
           "World::remove_agents_out_of_map",
           "Whether agents should be removed outside the bounding box.", false)),
@@ -37,7 +48,8 @@ World::World(const commons::ParamsPtr& params)
           "FrontRearAgent calculation "
           "Calculation, should be larger than 0. value of 2 means that all "
           "agents intersecting with lane will be considered",
-          2.0)) {
+          2.0)),
+      neighbor_table_(std::make_shared<NeighborTable>()) {
   //! segfault handler
   std::signal(SIGSEGV, bark::commons::SegfaultHandler);
 }
@@ -50,9 +62,11 @@ World::World(const std::shared_ptr<World>& world)
       evaluators_(world->GetEvaluators()),
       observer_(world->GetObserverModel()),
       world_time_(world->GetWorldTime()),
+      rtree_agents_(world->rtree_agents_),
+      max_agent_speed_(world->max_agent_speed_),
       remove_agents_(world->GetRemoveAgents()),
       frac_lateral_offset_(world->GetFracLateralOffset()),
-      rtree_agents_(world->rtree_agents_) {
+      neighbor_table_(world->neighbor_table_) {
   //! segfault handler
   std::signal(SIGSEGV, bark::commons::SegfaultHandler);
 }
@@ -66,15 +80,60 @@ void World::PlanAgents(const double& delta_time) {
   UpdateAgentRTree();
   WorldPtr current_world(this->Clone());
   const double inc_world_time = world_time_ + delta_time;
+
+  // agents sharing a batch policy, in order of their first agent id
+  struct PolicyBatch {
+    BatchPolicyPtr policy;
+    std::vector<AgentPtr> agents;
+    std::vector<std::shared_ptr<BatchPolicyBehavior>> behaviors;
+    std::vector<ObservedWorld> observed_worlds;
+  };
+  std::vector<PolicyBatch> batches;
+
   for (auto agent : agents_) {
     if (agent.second->IsValidAtTime(world_time_)) {
       ObservedWorld observed_world = observer_->Observe(
         current_world, agent.first);
+      const auto batch_behavior = std::dynamic_pointer_cast<
+          BatchPolicyBehavior>(agent.second->GetBehaviorModel());
+      if (batch_behavior && batch_behavior->GetBatchPolicy()) {
+        const BatchPolicyPtr policy = batch_behavior->GetBatchPolicy();
+        auto batch = std::find_if(
+            batches.begin(), batches.end(),
+            [&policy](const PolicyBatch& b) { return b.policy == policy; });
+        if (batch == batches.end())
+          batch = batches.insert(batches.end(),
+                                 PolicyBatch{policy, {}, {}, {}});
+        batch->agents.push_back(agent.second);
+        batch->behaviors.push_back(batch_behavior);
+        batch->observed_worlds.push_back(observed_world);
+        continue;
+      }
       agent.second->PlanBehavior(delta_time, observed_world);
       if (agent.second->GetBehaviorStatus() == BehaviorStatus::VALID)
         agent.second->PlanExecution(inc_world_time);
     }
   }
+
+  for (auto& batch : batches) {
+    Eigen::MatrixXd observations;
+    for (std::size_t i = 0; i < batch.agents.size(); ++i) {
+      const Eigen::VectorXd observation =
+          batch.behaviors[i]->Observe(batch.observed_worlds[i]);
+      if (i == 0)
+        observations.resize(batch.agents.size(), observation.size());
+      BARK_EXPECT_TRUE(observation.size() == observations.cols());
+      observations.row(i) = observation.transpose();
+    }
+    const Eigen::MatrixXd actions = batch.policy->Act(observations);
+    BARK_EXPECT_TRUE(actions.rows() == observations.rows());
+    for (std::size_t i = 0; i < batch.agents.size(); ++i) {
+      batch.behaviors[i]->SetBatchAction(actions.row(i).transpose());
+      batch.agents[i]->PlanBehavior(delta_time, batch.observed_worlds[i]);
+      if (batch.agents[i]->GetBehaviorStatus() == BehaviorStatus::VALID)
+        batch.agents[i]->PlanExecution(inc_world_time);
+    }
+  }
 }
 
 void World::Execute(const double& delta_time) {
@@ -107,6 +166,17 @@ WorldPtr World::GetWorldAtTime(const double& world_time) const {
   return current_world_state;
 }
 
+Eigen::MatrixXd World::GetStateArray() const {
+  using models::dynamic::StateDefinition::MIN_STATE_SIZE;
+  Eigen::MatrixXd states(agents_.size(), static_cast<int>(MIN_STATE_SIZE));
+  int row = 0;
+  for (const auto& agent : agents_) {
+    states.row(row++) =
+        agent.second->GetCurrentState().head(MIN_STATE_SIZE).transpose();
+  }
+  return states;
+}
+
 AgentMap World::GetValidAgents() const {
   AgentMap agents_valid(agents_);
   AgentMap::iterator it;
@@ -124,6 +194,7 @@ AgentMap World::GetValidAgents() const {
 
 void World::AddAgent(const objects::AgentPtr& agent) {
   agents_[agent->agent_id_] = agent;
+  neighbor_table_->Clear();
 }
 
 void World::AddObject(const objects::ObjectPtr& object) {
@@ -162,11 +233,18 @@ std::vector<ObservedWorld> World::Observe(
 
 void World::UpdateAgentRTree() {
   rtree_agents_.clear();
+  neighbor_table_->Clear();
+  max_agent_speed_ = 0.0;
+  bark::geometry::Polygon polygon;
   for (auto& agent : agents_) {
-    auto obj =
-        agent.second->GetPolygonFromState(agent.second->GetCurrentState()).obj_;
+    max_agent_speed_ =
+        std::max(max_agent_speed_,
+                 std::fabs(agent.second->GetCurrentState()(
+                     models::dynamic::StateDefinition::VEL_POSITION)));
+    agent.second->GetPolygonFromState(agent.second->GetCurrentState(),
+                                      &polygon);
     rtree_agent_model box;
-    boost::geometry::envelope(obj, box);
+    boost::geometry::envelope(polygon.obj_, box);
     boost::geometry::correct(box);
     rtree_agents_.insert(std::make_pair(box, agent.first));
   }
@@ -230,10 +308,11 @@ AgentMap World::GetAgentsIntersectingPolygon(
                       std::back_inserter(query_results));
 
   AgentMap intersecting_agents;
+  bark::geometry::Polygon agent_polygon;
   for (auto& result_pair : query_results) {
     auto agent = GetAgent(result_pair.second);
-    if (bark::geometry::Collide(
-            agent->GetPolygonFromState(agent->GetCurrentState()), polygon) &&
+    agent->GetPolygonFromState(agent->GetCurrentState(), &agent_polygon);
+    if (bark::geometry::Collide(agent_polygon, polygon) &&
         agent->GetBehaviorStatus() == BehaviorStatus::VALID &&
         agent->IsValidAtTime(world_time_)) {
       intersecting_agents[result_pair.second] = agent;
@@ -242,75 +321,220 @@ AgentMap World::GetAgentsIntersectingPolygon(
   return intersecting_agents;
 }
 
-FrontRearAgents World::GetAgentFrontRearForId(
-    const AgentId& agent_id, const LaneCorridorPtr& lane_corridor,
-    double frac_lateral_offset) const {
-  using bark::geometry::Line;
-  using bark::geometry::Polygon;
+AgentMap World::GetAgentsWithinRadius(const bark::geometry::Polygon& polygon,
+                                      double radius) const {
+  const auto bounding_box = polygon.BoundingBox();
+  return QueryAgentsNearBox(
+      rtree_agent_model(bounding_box.first, bounding_box.second), radius,
+      true);
+}
 
-  FrontRearAgents fr_agents;
-  Point2d ego_position = World::GetAgent(agent_id)->GetCurrentPosition();
+AgentMap World::GetAgentsWithinRadius(const bark::geometry::Point2d& position,
+                                      double radius,
+                                      bool valid_agents_only) const {
+  return QueryAgentsNearBox(rtree_agent_model(position, position), radius,
+                            valid_agents_only);
+}
 
-  const Polygon& corridor_polygon = lane_corridor->GetMergedPolygon();
-  const Line& center_line = lane_corridor->GetCenterLine();
-  AgentMap intersecting_agents = GetAgentsIntersectingPolygon(corridor_polygon);
-  if (intersecting_agents.size() == 0) {
-    fr_agents.front = std::make_pair(AgentPtr(nullptr), FrenetPosition(0, 0));
-    fr_agents.rear = fr_agents.front;
-    return fr_agents;
+double World::GetMaxAgentSpeed() const {
+  if (rtree_agents_.size() == agents_.size()) {
+    return max_agent_speed_;
+  }
+  double max_agent_speed = 0.0;
+  for (const auto& agent : agents_) {
+    max_agent_speed =
+        std::max(max_agent_speed,
+                 std::fabs(agent.second->GetCurrentState()(
+                     models::dynamic::StateDefinition::VEL_POSITION)));
   }
+  return max_agent_speed;
+}
 
-  FrenetPosition frenet_ego(ego_position, center_line);
-  const double numeric_max = std::numeric_limits<double>::max();
+AgentMap World::QueryAgentsNearBox(const rtree_agent_model& box, double radius,
+                                   bool valid_agents_only) const {
+  namespace bg = boost::geometry;
+  AgentMap near_agents;
+  auto add_if_near = [&](const rtree_agent_model& agent_box,
+                         const AgentId& agent_id) {
+    if (bg::distance(box, agent_box) > radius) return;
+    const AgentPtr agent = GetAgent(agent_id);
+    if (agent && (!valid_agents_only ||
+                  (agent->GetBehaviorStatus() == BehaviorStatus::VALID &&
+                   agent->IsValidAtTime(world_time_)))) {
+      near_agents[agent_id] = agent;
+    }
+  };
+
+  // the tree is rebuilt every step, agents added since are not indexed yet
+  if (rtree_agents_.size() != agents_.size()) {
+    bark::geometry::Polygon agent_polygon;
+    for (const auto& agent : agents_) {
+      agent.second->GetPolygonFromState(agent.second->GetCurrentState(),
+                                        &agent_polygon);
+      rtree_agent_model agent_box;
+      bg::envelope(agent_polygon.obj_, agent_box);
+      add_if_near(agent_box, agent.first);
+    }
+    return near_agents;
+  }
+
+  rtree_agent_model query_box(
+      Point2d(bg::get<0>(box.min_corner()) - radius,
+              bg::get<1>(box.min_corner()) - radius),
+      Point2d(bg::get<0>(box.max_corner()) + radius,
+              bg::get<1>(box.max_corner()) + radius));
+  std::vector<rtree_agent_value> query_results;
+  rtree_agents_.query(bg::index::intersects(query_box),
+                      std::back_inserter(query_results));
+  for (const auto& result_pair : query_results) {
+    add_if_near(result_pair.first, result_pair.second);
+  }
+  return near_agents;
+}
 
-  double nearest_lon_front = numeric_max, nearest_lat_front = numeric_max,
-         nearest_lon_rear = numeric_max, nearest_lat_rear = numeric_max;
+CorridorOccupancyPtr World::GetCorridorOccupancy(
+    const LaneCorridorPtr& lane_corridor, double frac_lateral_offset) const {
+  using bark::commons::transformation::FrenetProjection;
+  using bark::geometry::Point2d;
 
-  AgentPtr nearest_agent_front(nullptr);
-  AgentPtr nearest_agent_rear(nullptr);
+  const NeighborTable::CorridorKey key(lane_corridor, frac_lateral_offset);
+  CorridorOccupancyPtr cached_occupancy = neighbor_table_->FindOccupancy(key);
+  if (cached_occupancy) {
+    return cached_occupancy;
+  }
 
-  for (auto it = intersecting_agents.begin(); it != intersecting_agents.end();
-       ++it) {
-    if (it->second->GetAgentId() == agent_id ||
-        it->second->GetBehaviorStatus() != BehaviorStatus::VALID ||
-        it->second->IsValidAtTime(world_time_) == false) {
+  auto occupancy = std::make_shared<CorridorOccupancy>();
+  AgentMap intersecting_agents =
+      GetAgentsIntersectingPolygon(lane_corridor->GetMergedPolygon());
+  occupancy->has_intersecting_agents = !intersecting_agents.empty();
+
+  std::vector<AgentPtr> candidates;
+  std::vector<Point2d> candidate_positions;
+  candidates.reserve(intersecting_agents.size());
+  candidate_positions.reserve(intersecting_agents.size());
+  for (const auto& agent : intersecting_agents) {
+    if (agent.second->GetBehaviorStatus() != BehaviorStatus::VALID ||
+        agent.second->IsValidAtTime(world_time_) == false) {
       continue;
     }
+    candidates.push_back(agent.second);
+    candidate_positions.push_back(agent.second->GetCurrentPosition());
+  }
 
-    FrenetPosition frenet_other(it->second->GetCurrentPosition(), center_line);
-    double width =
-        lane_corridor->GetLaneWidth(it->second->GetCurrentPosition());
-    if (std::abs(frenet_other.lat) > frac_lateral_offset * width) {
+  // project all candidates onto the center line in one batch
+  const FrenetProjection frenet_candidates =
+      lane_corridor->GetCenterLineProjector()->Project(candidate_positions);
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    double width = lane_corridor->GetLaneWidth(candidate_positions[i]);
+    if (std::abs(frenet_candidates.lat[i]) > frac_lateral_offset * width) {
       // agent seems to be not really in same lane
       continue;
     }
-    double long_dist = frenet_other.lon - frenet_ego.lon;
-    double lat_dist = frenet_other.lat - frenet_ego.lat;
-
-    if (long_dist > 0.0 && long_dist < nearest_lon_front) {
-      nearest_lon_front = long_dist;
-      nearest_lat_front = lat_dist;
-      nearest_agent_front = it->second;
-    } else if (long_dist < 0.0 &&
-               std::abs(long_dist) < std::abs(nearest_lon_rear)) {
-      nearest_lon_rear = long_dist;
-      nearest_lat_rear = lat_dist;
-      nearest_agent_rear = it->second;
-    }
+    occupancy->agents.push_back(std::make_pair(
+        candidates[i],
+        FrenetPosition(frenet_candidates.lon[i], frenet_candidates.lat[i])));
   }
+  // ties keep the ascending agent id order of the agent map
+  std::stable_sort(occupancy->agents.begin(), occupancy->agents.end(),
+                   [](const AgentFrenetPair& lhs, const AgentFrenetPair& rhs) {
+                     return lhs.second.lon < rhs.second.lon;
+                   });
+
+  neighbor_table_->InsertOccupancy(key, occupancy);
+  return occupancy;
+}
 
-  FrenetPosition frenet_front =
-      FrenetPosition(nearest_lon_front, nearest_lat_front);
-  fr_agents.front = std::make_pair(nearest_agent_front, frenet_front);
-  FrenetPosition frenet_rear =
-      FrenetPosition(nearest_lon_rear, nearest_lat_rear);
-  fr_agents.rear = std::make_pair(nearest_agent_rear, frenet_rear);
+FrontRearAgents World::GetAgentFrontRearForId(
+    const AgentId& agent_id, const LaneCorridorPtr& lane_corridor,
+    double frac_lateral_offset) const {
+  FrontRearAgents fr_agents;
+  const CorridorOccupancyPtr occupancy =
+      GetCorridorOccupancy(lane_corridor, frac_lateral_offset);
+  if (!occupancy->has_intersecting_agents) {
+    fr_agents.front = std::make_pair(AgentPtr(nullptr), FrenetPosition(0, 0));
+    fr_agents.rear = fr_agents.front;
+    return fr_agents;
+  }
+
+  AgentPtr ego_agent = World::GetAgent(agent_id);
+  FrenetPosition frenet_ego =
+      ego_agent->CurrentFrenetState(lane_corridor->GetCenterLine());
+  const double numeric_max = std::numeric_limits<double>::max();
+  fr_agents.front = std::make_pair(AgentPtr(nullptr),
+                                   FrenetPosition(numeric_max, numeric_max));
+  fr_agents.rear = fr_agents.front;
+
+  const auto& agents = occupancy->agents;
+  const auto is_ego = [&agent_id](const AgentFrenetPair& agent) {
+    return agent.first->GetAgentId() == agent_id;
+  };
+
+  // nearest agent ahead: first agent with a larger longitudinal coordinate
+  auto front = std::upper_bound(
+      agents.begin(), agents.end(), frenet_ego.lon,
+      [](double lon, const AgentFrenetPair& agent) {
+        return lon < agent.second.lon;
+      });
+  while (front != agents.end() && is_ego(*front)) ++front;
+  if (front != agents.end()) {
+    fr_agents.front = std::make_pair(
+        front->first, FrenetPosition(front->second.lon - frenet_ego.lon,
+                                     front->second.lat - frenet_ego.lat));
+  }
+
+  // nearest agent behind: last agent with a smaller longitudinal coordinate,
+  // among agents at the same coordinate the one with the lowest id
+  auto rear = std::lower_bound(
+      agents.begin(), agents.end(), frenet_ego.lon,
+      [](const AgentFrenetPair& agent, double lon) {
+        return agent.second.lon < lon;
+      });
+  while (rear != agents.begin() && is_ego(*std::prev(rear))) --rear;
+  if (rear != agents.begin()) {
+    --rear;
+    while (rear != agents.begin() &&
+           std::prev(rear)->second.lon == rear->second.lon &&
+           !is_ego(*std::prev(rear))) {
+      --rear;
+    }
+    fr_agents.rear = std::make_pair(
+        rear->first, FrenetPosition(rear->second.lon - frenet_ego.lon,
+                                    rear->second.lat - frenet_ego.lat));
+  }
 
   return fr_agents;
 }
 
+NeighborInformation World::GetNeighborInformation(
+    const AgentId& agent_id, const LaneCorridorPtr& lane_corridor,
+    double frac_lateral_offset) const {
+  NeighborTable::Key key(agent_id, lane_corridor, frac_lateral_offset);
+  NeighborInformation neighbor_info;
+  if (neighbor_table_->Find(key, &neighbor_info)) {
+    return neighbor_info;
+  }
+
+  using models::dynamic::StateDefinition::VEL_POSITION;
+  neighbor_info.front_rear =
+      GetAgentFrontRearForId(agent_id, lane_corridor, frac_lateral_offset);
+  const double velocity = GetAgent(agent_id)->GetCurrentState()(VEL_POSITION);
+  const auto& front = neighbor_info.front_rear.front.first;
+  const auto& rear = neighbor_info.front_rear.rear.first;
+  if (front) {
+    neighbor_info.rel_velocity_front =
+        front->GetCurrentState()(VEL_POSITION) - velocity;
+  }
+  if (rear) {
+    neighbor_info.rel_velocity_rear =
+        rear->GetCurrentState()(VEL_POSITION) - velocity;
+  }
+  neighbor_table_->Insert(key, neighbor_info);
+  return neighbor_info;
+}
+
 void World::RemoveAgentById(AgentId agent_id) {
   size_t erased_elems = agents_.erase(agent_id);
+  neighbor_table_->Clear();
   LOG_IF(ERROR, erased_elems == 0)
       << "Could not remove non-existent agent with Id " << agent_id << " !";
 }
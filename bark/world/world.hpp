@@ -10,7 +10,10 @@
 #define BARK_WORLD_WORLD_HPP_
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -60,6 +63,123 @@ struct FrontRearAgents {
   AgentFrenetPair rear;
 };
 
+// front and rear agents of an agent in one LaneCorridor including the
+// velocities relative to the agent (other minus own velocity)
+struct NeighborInformation {
+  FrontRearAgents front_rear;
+  double rel_velocity_front = 0.0;
+  double rel_velocity_rear = 0.0;
+};
+
+// agents on a LaneCorridor within the allowed lateral offset, sorted by
+// their longitudinal coordinate along the center line
+struct CorridorOccupancy {
+  std::vector<AgentFrenetPair> agents;
+  // whether any agent intersects the corridor, also outside the offset
+  bool has_intersecting_agents = false;
+};
+
+typedef std::shared_ptr<const CorridorOccupancy> CorridorOccupancyPtr;
+
+/**
+ * @brief Per-step table of the agents on each LaneCorridor and of the
+ *        front and rear agents for each (agent, LaneCorridor, lateral
+ *        offset) combination
+ *
+ * The table is shared by all ObservedWorlds created from the same world
+ * snapshot. The occupancy of a LaneCorridor does not depend on the querying
+ * agent, so the corridor query and the Frenet projection of the agents on
+ * it are done once and reused by all agents driving on or changing to that
+ * corridor. It is cleared whenever agents are added, removed or their
+ * states are updated.
+ */
+class NeighborTable {
+ public:
+  typedef std::tuple<AgentId, LaneCorridorPtr, double> Key;
+  typedef std::pair<LaneCorridorPtr, double> CorridorKey;
+
+  NeighborTable()
+      : num_hits_(0),
+        num_misses_(0),
+        num_corridor_hits_(0),
+        num_corridor_misses_(0) {}
+
+  bool Find(const Key& key, NeighborInformation* neighbor_info) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = table_.find(key);
+    if (it == table_.end()) {
+      ++num_misses_;
+      return false;
+    }
+    ++num_hits_;
+    *neighbor_info = it->second;
+    return true;
+  }
+
+  void Insert(const Key& key, const NeighborInformation& neighbor_info) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_[key] = neighbor_info;
+  }
+
+  CorridorOccupancyPtr FindOccupancy(const CorridorKey& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = occupancies_.find(key);
+    if (it == occupancies_.end()) {
+      ++num_corridor_misses_;
+      return nullptr;
+    }
+    ++num_corridor_hits_;
+    return it->second;
+  }
+
+  void InsertOccupancy(const CorridorKey& key,
+                       const CorridorOccupancyPtr& occupancy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    occupancies_[key] = occupancy;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_.clear();
+    occupancies_.clear();
+  }
+
+  std::size_t GetSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return table_.size();
+  }
+  std::size_t GetNumHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_hits_;
+  }
+  std::size_t GetNumMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_misses_;
+  }
+  //! corridor occupancies reused from another query
+  std::size_t GetNumCorridorHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_corridor_hits_;
+  }
+  //! corridor occupancies computed
+  std::size_t GetNumCorridorMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_corridor_misses_;
+  }
+
+ private:
+  // the table may be shared by worlds that are expanded in parallel
+  mutable std::mutex mutex_;
+  std::map<Key, NeighborInformation> table_;
+  std::map<CorridorKey, CorridorOccupancyPtr> occupancies_;
+  mutable std::size_t num_hits_;
+  mutable std::size_t num_misses_;
+  mutable std::size_t num_corridor_hits_;
+  mutable std::size_t num_corridor_misses_;
+};
+
+typedef std::shared_ptr<NeighborTable> NeighborTablePtr;
+
 class World : public commons::BaseType {
  public:
   explicit World(const commons::ParamsPtr& params);
@@ -74,6 +194,9 @@ class World : public commons::BaseType {
 
   /**
    * @brief Calls the behavior and execution model of the agents
+   *
+   * Agents with a BatchPolicyBehavior are grouped by their policy; each
+   * policy is queried once with the stacked observations of its agents.
    * @param  delta_time: minimum planning time
    */
   void PlanAgents(const double& delta_time);
@@ -100,7 +223,7 @@ class World : public commons::BaseType {
   std::vector<ObservedWorld> Observe(const std::vector<AgentId>& agent_ids);
 
   /**
-   * @brief  Updates the agent r-tree
+   * @brief  Updates the agent r-tree and the maximum agent speed
    */
   void UpdateAgentRTree();
 
@@ -113,7 +236,13 @@ class World : public commons::BaseType {
   double GetWorldTime() const { return world_time_; }
   void SetWorldTime(const double& world_time) { world_time_ = world_time; }
   world::map::MapInterfacePtr GetMap() const { return map_; }
-  virtual AgentMap GetAgents() const { return agents_; }
+  virtual const AgentMap& GetAgents() const { return agents_; }
+  /**
+   * @brief  Returns the current states of all agents in ascending order of
+   *         their ids, one row per agent with the columns time, x, y, theta
+   *         and velocity
+   */
+  Eigen::MatrixXd GetStateArray() const;
   AgentMap GetValidAgents() const;
   AgentPtr GetAgent(AgentId id) const {
     auto agent_it = agents_.find(id);
@@ -131,7 +260,7 @@ class World : public commons::BaseType {
     return observer_;
   }
   
-  bool GetRemoveAgents() { return remove_agents_; }
+  bool GetRemoveAgents() const { return remove_agents_; }
 
   double GetFracLateralOffset() const { return frac_lateral_offset_; }
 
@@ -145,6 +274,30 @@ class World : public commons::BaseType {
   AgentMap GetAgentsIntersectingPolygon(
       const bark::geometry::Polygon& polygon) const;
 
+  /**
+   * @brief Valid agents with a bounding box closer than radius to the
+   * bounding box of the polygon
+   *
+   * Queries the agent R-tree, the result is a superset of the agents whose
+   * shape is within radius and meant as pre-filter for exact checks.
+   */
+  AgentMap GetAgentsWithinRadius(const bark::geometry::Polygon& polygon,
+                                 double radius) const;
+
+  //! agents with a bounding box closer than radius to the position, only
+  //! valid ones unless valid_agents_only is false
+  AgentMap GetAgentsWithinRadius(const bark::geometry::Point2d& position,
+                                 double radius,
+                                 bool valid_agents_only = true) const;
+
+  /**
+   * @brief Largest speed magnitude of all agents, valid or not
+   *
+   * Recorded when the agent R-tree is built, agents added since are
+   * scanned.
+   */
+  double GetMaxAgentSpeed() const;
+
   /**
    * @brief Get the front and rear agent for a given agent
    *
@@ -159,6 +312,29 @@ class World : public commons::BaseType {
                                          const LaneCorridorPtr& lane_corridor,
                                          double frac_lateral_offset) const;
 
+  /**
+   * @brief Get the front and rear agent including relative velocities for a
+   *        given agent; results are cached in the per-step NeighborTable
+   *
+   * @param agent_id agent id for which to calculate front&rear agent
+   * @param lane_corridor lane corridor in which to calculate front&rear agent
+   * @param frac_lateral_offset see GetAgentFrontRearForId
+   * @return NeighborInformation
+   */
+  NeighborInformation GetNeighborInformation(
+      const AgentId& agent_id, const LaneCorridorPtr& lane_corridor,
+      double frac_lateral_offset) const;
+
+  /**
+   * @brief Agents on the LaneCorridor within the lateral offset with their
+   *        Frenet positions, computed once per world snapshot and shared
+   *        via the NeighborTable
+   */
+  CorridorOccupancyPtr GetCorridorOccupancy(
+      const LaneCorridorPtr& lane_corridor, double frac_lateral_offset) const;
+
+  NeighborTablePtr GetNeighborTable() const { return neighbor_table_; }
+
   //! Setter
   void SetMap(const world::map::MapInterfacePtr& map) { map_ = map; }
   void SetObserverModel(const ObserverModelPtr& observer) {
@@ -180,7 +356,10 @@ class World : public commons::BaseType {
 
   //! Functions
   void ClearEvaluators() { evaluators_.clear(); }
-  void ClearAgents() { agents_.clear(); }
+  void ClearAgents() {
+    agents_.clear();
+    neighbor_table_->Clear();
+  }
   void ClearObjects() { objects_.clear(); }
   void ClearAll() {
     ClearAgents();
@@ -191,6 +370,9 @@ class World : public commons::BaseType {
   virtual std::shared_ptr<World> Clone() const;
 
  private:
+  AgentMap QueryAgentsNearBox(const rtree_agent_model& box, double radius,
+                              bool valid_agents_only) const;
+
   MapInterfacePtr map_;
   AgentMap agents_;
   ObjectMap objects_;
@@ -198,14 +380,18 @@ class World : public commons::BaseType {
   ObserverModelPtr observer_;
   double world_time_;
   AgentRTree rtree_agents_;
+  double max_agent_speed_;
   bool remove_agents_;
   double frac_lateral_offset_;
+  NeighborTablePtr neighbor_table_;
 };
 
 typedef std::shared_ptr<world::World> WorldPtr;
 
 inline WorldPtr World::Clone() const {
   WorldPtr new_world = std::make_shared<World>(*this);
+  // the clone must not share the table as its agents are new instances
+  new_world->neighbor_table_ = std::make_shared<NeighborTable>();
   new_world->ClearAll();
   for (auto agent = agents_.begin(); agent != agents_.end(); ++agent) {
     new_world->AddAgent(